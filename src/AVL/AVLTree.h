@@ -2,59 +2,99 @@
 #define AVLTree_H
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <vector>
 
+#include "ForkJoinPool.h"
+#include "NodePolicy.h"
+#include "NodePool.h"
+#include "Snapshot.h"
+#include "TreeStats.h"
+
 namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
 
-template <typename Key, typename T>
+// Keys are ordered by Compare, nodes are allocated through Allocator
+// rebound to the node pool slots. Policy decides what a node stores, see
+// NodePolicy.h.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>,
+          typename Policy = MapNodePolicy<Key, T>>
 class AVLTree {
  public:
   using key_type = Key;
-  using value_type = T;
-  using reference = value_type&;
+  using value_type = typename Policy::value_type;
+  using reference = typename Policy::reference;
   using const_reference = const value_type&;
+  using pointer = typename Policy::pointer;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
  protected:
-  struct Node {
-    key_type key_;
-    value_type value_;
-    Node* left_;
-    Node* right_;
-    Node* parent_;
+  // Links shared by the real nodes and the header. The header's parent_ is
+  // the root, left_/right_ cache the leftmost and rightmost nodes, and it is
+  // told apart by its zero height.
+  //
+  // An AVL tree of 2^32 nodes is at most 46 levels high, so height fits in a
+  // byte. On LP64 links and counters take 29 bytes and the stored value
+  // follows at its own alignment: a node is 40 bytes for set<uint64_t>, 64
+  // for set<std::string> and 40 for map<int, int>.
+  struct NodeBase {
+    NodeBase* left_;
+    NodeBase* right_;
+    NodeBase* parent_;
 
     int count;
-    int height;
+    signed char height;
 
-    Node(key_type key, value_type value);
+    NodeBase();
     void update_values();
     int balance_factor();
+    bool is_header() const;
+  };
 
-    Node* left_rotate();
-    Node* right_rotate();
+  struct Node : NodeBase {
+    value_type data_;
+
+    template <typename... Args>
+    explicit Node(Args&&... args);
+    const Key& key() const;
   };
 
-  Node* root_;
+  NodeBase header_;
   size_type size_ = 0;
+  NodePool<Node, Allocator> pool_;
+  Compare comp_;
+  mutable TreeStatsCounters stats_;
 
  public:
   class ConstIterator {
+    friend class AVLTree;
+
    private:
-    AVLTree* AVLTree_;
-    Node* node_;
+    NodeBase* node_;
 
    public:
     // Constructors
     ConstIterator() noexcept;
-    ConstIterator(Node* node, AVLTree* tree);
-    ConstIterator(Node* node);
+    ConstIterator(NodeBase* node) noexcept;
 
     // Operators
     bool operator==(const ConstIterator& other) const;
     bool operator!=(const ConstIterator& other) const;
-    value_type operator*() const;
+    const_reference operator*() const;
     const value_type* operator->() const;
     ConstIterator& operator++();
     ConstIterator operator++(int);
@@ -62,17 +102,22 @@ class AVLTree {
     ConstIterator operator--(int);
 
     // help functions
-    reference get_element() const;
+    value_type& get_element() const;
+    // nullptr for end()
     Node* get_node() const;
   };
 
   class Iterator : public ConstIterator {
    public:
     Iterator() noexcept : ConstIterator() {}
-    Iterator(Node* node, AVLTree* tree) noexcept : ConstIterator(node, tree) {}
-    Iterator(Node* node) : ConstIterator(node) {}
+    Iterator(NodeBase* node) noexcept : ConstIterator(node) {}
     ~Iterator() = default;
-    value_type* operator->();
+    reference operator*() const;
+    pointer operator->() const;
+    Iterator& operator++();
+    Iterator operator++(int);
+    Iterator& operator--();
+    Iterator operator--(int);
   };
 
  public:
@@ -86,6 +131,7 @@ class AVLTree {
 
   // AVLTree Constructors
   AVLTree();
+  explicit AVLTree(const Compare& comp, const Allocator& alloc = Allocator());
   AVLTree(std::initializer_list<value_type> const& items);
   // AVLTree(const Key& key, const T& value);
   // AVLTree(const_reference elem) noexcept;
@@ -96,20 +142,135 @@ class AVLTree {
   ~AVLTree();
 
  protected:
-  Node* insert_node(Node* node, const Key& key, const T& value,
-                    Node*& inserted_node, bool& inserted);
-  Node* find_max_node(Node* node);
-  Node* find_min_node(Node* node);
-  Node* find_next_node(Node* node);
-  Node* find_prev_node(Node* node);
-  Node* find_last_node() const;
-  void merge_nodes(Node* node);
-  Node* find_node(Node* node, const Key& query_key);
+  Node* root() const;
+  void reset_header();
+  static NodeBase* find_max_node(NodeBase* node);
+  static NodeBase* find_min_node(NodeBase* node);
+  static NodeBase* find_next_node(NodeBase* node);
+  static NodeBase* find_prev_node(NodeBase* node);
+  // comp_ for the tree's own algorithms, counted in stats()
+  template <typename A, typename B>
+  bool key_less(const A& a, const B& b) const;
+  template <typename K>
+  Node* find_node(Node* node, const K& key) const;
+  // Searches for the keys of [first, last) kBatchWidth at a time, advancing
+  // them in lockstep and prefetching the next node of each, so that their
+  // cache misses overlap. Calls visit with the node of every key, nullptr
+  // if it is missing, in the order of the keys.
+  static constexpr size_type kBatchWidth = 16;
+  static void prefetch_node(const NodeBase* node);
+  template <typename ForwardIt, typename Visit>
+  void find_nodes(ForwardIt first, ForwardIt last, Visit visit) const;
   void clear_tree(Node* root);
+  void destroy_node(Node* node);
   Node* copy_node(Node* other_node);
+  Node* copy_node(Node* other_node, NodePool<Node, Allocator>& pool);
   void display(Node* cur, int depth = 0, int state = 0);
-  Node* erase_node(Node* node, const Key& key);
-  Node* replace_with_successor(Node* node);
+  void erase_node(Node* node);
+  void replace_child(NodeBase* old_child, NodeBase* new_child);
+  NodeBase* left_rotate(NodeBase* node);
+  NodeBase* right_rotate(NodeBase* node);
+  NodeBase* balance_node(NodeBase* node);
+  void rebalance_path(NodeBase* node, int count_delta);
+  template <typename... Args>
+  Node* link_node(NodeBase* parent, NodeBase** link, Args&&... args);
+  // Find-or-insert in one descent: key is only looked up, args construct
+  // the stored value if it is missing
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(const K& key, Args&&... args);
+  template <typename K, typename... Args>
+  iterator insert_equal(const K& key, Args&&... args);
+  static NodeBase* hint_position(const_iterator hint);
+  template <typename... Args>
+  Node* link_before(NodeBase* pos, Args&&... args);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> insert_hint_unique(NodeBase* pos, const K& key,
+                                               Args&&... args);
+  template <typename K, typename... Args>
+  iterator insert_hint_equal(NodeBase* pos, const K& key, Args&&... args);
+  template <typename K>
+  NodeBase* lower_bound_node(const K& key);
+  template <typename K>
+  NodeBase* upper_bound_node(const K& key);
+  template <typename K>
+  size_type lower_rank(const K& key);
+  template <typename K>
+  size_type upper_rank(const K& key);
+  void attach_root(NodeBase* root, size_type size);
+  NodeBase* build_balanced(NodeBase** nodes, size_type n, NodeBase* parent);
+  template <typename ForwardIt, typename DataOf>
+  NodeBase* build_sorted(ForwardIt& it, ForwardIt last, size_type n,
+                         DataOf data_of);
+  // Two passes over forward ranges, one insert per element otherwise
+  template <typename InputIt>
+  void assign_range(InputIt first, InputIt last);
+  template <typename ForwardIt>
+  void assign_range(ForwardIt first, ForwardIt last,
+                    std::forward_iterator_tag);
+  template <typename InputIt>
+  void assign_range(InputIt first, InputIt last, std::input_iterator_tag);
+  template <typename MakeNode>
+  NodeBase* build_in_order(size_type n, MakeNode& make_node);
+  template <typename Reader>
+  void load_snapshot(Reader& reader);
+  void merge_linear(AVLTree& other, bool unique);
+  void return_nodes(AVLTree& other, std::vector<NodeBase*>& nodes);
+  void move_elements(AVLTree& other, bool unique);
+
+  // Join-based primitives. They work on detached subtrees, i.e. subtrees
+  // whose root has no parent, and never allocate or free nodes.
+  static int height_of(NodeBase* node);
+  static size_type count_of(NodeBase* node);
+  static void expose(NodeBase* node, NodeBase*& left, NodeBase*& right);
+  NodeBase* link(NodeBase* left, NodeBase* node, NodeBase* right);
+  NodeBase* detach_root();
+  NodeBase* join(NodeBase* left, NodeBase* pivot, NodeBase* right);
+  NodeBase* join_right(NodeBase* left, NodeBase* pivot, NodeBase* right);
+  NodeBase* join_left(NodeBase* left, NodeBase* pivot, NodeBase* right);
+  NodeBase* split(NodeBase* root, const Key& key, NodeBase*& left,
+                  NodeBase*& right);
+  NodeBase* union_nodes(NodeBase* a, NodeBase* b,
+                        std::vector<NodeBase*>& duplicates);
+  NodeBase* split_last(NodeBase* root, NodeBase*& last);
+  NodeBase* join2(NodeBase* left, NodeBase* right);
+  void split_at(NodeBase* root, size_type k, NodeBase*& left,
+                NodeBase*& right);
+  static size_type index_of(NodeBase* node);
+
+  // Set algebra of a detached subtree of this tree against a subtree of
+  // another tree, which is only read. Subproblems larger than grain_size
+  // run in parallel on workers. The result goes to out, which holds a valid
+  // subtree with every node still owned by this tree even if a copy throws.
+  // Compare must not throw.
+  // Detached subtrees waiting to be freed, chained through parent_
+  struct RemovedList {
+    NodeBase* head_ = nullptr;
+    NodeBase* tail_ = nullptr;
+
+    void push(NodeBase* root) noexcept {
+      root->parent_ = nullptr;
+      (tail_ != nullptr ? tail_->parent_ : head_) = root;
+      tail_ = root;
+    }
+    void append(RemovedList& other) noexcept {
+      if (other.head_ != nullptr) {
+        (tail_ != nullptr ? tail_->parent_ : head_) = other.head_;
+        tail_ = other.tail_;
+      }
+    }
+  };
+  void union_copy(NodeBase* a, NodeBase* b, NodePool<Node, Allocator>& pool,
+                  size_type grain_size, ForkJoinPool& workers,
+                  NodeBase*& out);
+  void intersect_nodes(NodeBase* a, NodeBase* b, RemovedList& removed,
+                       size_type grain_size, ForkJoinPool& workers,
+                       NodeBase*& out);
+  void difference_nodes(NodeBase* a, NodeBase* b, RemovedList& removed,
+                        size_type grain_size, ForkJoinPool& workers,
+                        NodeBase*& out);
+  void release_removed(RemovedList& removed);
+  void release_subtree(NodeBase* root);
+  void release_subtree(NodeBase* root, NodePool<Node, Allocator>& pool);
 
  public:
   // Capacity
@@ -120,16 +281,67 @@ class AVLTree {
   // Modifiers
   void clear();
   std::pair<iterator, bool> insert(const Key& key, const T& obj);
-  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  iterator insert(const_iterator hint, const Key& key, const T& obj);
   void erase(Iterator pos);
+  iterator erase(Iterator first, Iterator last);
+  size_type erase(const Key& key);
   void swap(AVLTree& other) noexcept;
   void merge(AVLTree& other);
 
-  // Lookup
+  // Set algebra, in place. other is left untouched and on equal keys the
+  // element of this tree wins.
+  static constexpr size_type kParallelGrain = 4096;
+  void set_union(const AVLTree& other, size_type grain_size = kParallelGrain,
+                 ForkJoinPool& workers = ForkJoinPool::global());
+  void set_intersection(const AVLTree& other,
+                        size_type grain_size = kParallelGrain,
+                        ForkJoinPool& workers = ForkJoinPool::global());
+  void set_difference(const AVLTree& other,
+                      size_type grain_size = kParallelGrain,
+                      ForkJoinPool& workers = ForkJoinPool::global());
+
+  // Lookup. The templated overloads take any key comparable with Key and
+  // are only available with a transparent Compare such as std::less<>.
   void display();
   bool contains(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key);
+  // Writes contains() of every key in [first, last) to out, see find_nodes
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_batch(ForwardIt first, ForwardIt last, OutputIt out);
+
+  // Bounds, O(log n). end() when there is no such key.
+  iterator lower_bound(const Key& key);
+  iterator upper_bound(const Key& key);
+  std::pair<iterator, iterator> equal_range(const Key& key);
+
+  // Observers
+  key_compare key_comp() const;
+  allocator_type get_allocator() const;
+
+  // Order statistics over the subtree counts, O(log n)
+  iterator select(size_type k);
+  size_type rank(const Key& key);
+  size_type count_range(const Key& lo, const Key& hi);
+
+  // Binary snapshots for trivially copyable values, see Snapshot.h. load()
+  // replaces the contents and rebuilds the tree bottom-up in O(n) without
+  // comparing keys, so the file must come from save() of a tree with the
+  // same Compare. The path overload of load() maps the file. Both throw
+  // std::runtime_error on I/O errors and malformed snapshots.
+  void save(const std::string& path) const;
+  void save(std::ostream& out) const;
+  void load(const std::string& path);
+  void load(std::istream& in);
+
+  // Instrumentation, see TreeStats.h. Counts only if S21_CONTAINERS_STATS
+  // is defined and is all zeros otherwise.
+  TreeStats stats() const;
+  void reset_stats();
 };
 
+S21_STATS_NAMESPACE_END
 }  // namespace s21
 
 #include "AVLTree.tpp"
@@ -4,25 +4,23 @@
 #include "AVLTree.h"
 
 namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
 
 /////////////////////////////////////
 ///////////    NODE    //////////////
 /////////////////////////////////////
 
-template <typename Key, typename T>
-AVLTree<Key, T>::Node::Node(typename AVLTree<Key, T>::key_type key,
-                            typename AVLTree<Key, T>::value_type value)
-    : key_(key), value_(value) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase::NodeBase()
+    : left_(nullptr), right_(nullptr), parent_(nullptr) {
   count = 1;
   height = 1;
-
-  left_ = nullptr;
-  right_ = nullptr;
-  parent_ = nullptr;
 }
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::Node::update_values() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase::update_values() {
   count = (left_ != nullptr ? left_->count : 0) +
           (right_ != nullptr ? right_->count : 0) + 1;
 
@@ -31,62 +29,29 @@ void AVLTree<Key, T>::Node::update_values() {
            1;
 }
 
-template <typename Key, typename T>
-int AVLTree<Key, T>::Node::balance_factor() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+int AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase::balance_factor() {
   return (left_ != nullptr ? left_->height : 0) -
          (right_ != nullptr ? right_->height : 0);
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::Node::left_rotate() {
-  Node* R = right_;
-  right_ = R->left_;
-  if (R->left_ != nullptr) {
-    R->left_->parent_ = this;
-  }
-  R->left_ = this;
-
-  R->parent_ = this->parent_;
-  if (this->parent_ != nullptr) {
-    if (this->parent_->left_ == this) {
-      this->parent_->left_ = R;
-    } else {
-      this->parent_->right_ = R;
-    }
-  }
-  this->parent_ = R;
-
-  this->update_values();
-  R->update_values();
-
-  return R;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+bool AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase::is_header() const {
+  return height == 0;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::Node::right_rotate() {
-  Node* L = left_;
-  left_ = L->right_;
-  if (L->right_ != nullptr) {
-    L->right_->parent_ = this;
-  }
-  L->right_ = this;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename... Args>
+AVLTree<Key, T, Compare, Allocator, Policy>::Node::Node(Args&&... args)
+    : NodeBase(), data_(std::forward<Args>(args)...) {}
 
-  // Обновляем родителя узла L
-  L->parent_ = this->parent_;
-  if (this->parent_ != nullptr) {
-    if (this->parent_->left_ == this) {
-      this->parent_->left_ = L;
-    } else {
-      this->parent_->right_ = L;
-    }
-  }
-
-  this->parent_ = L;
-
-  this->update_values();
-  L->update_values();
-
-  return L;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+const Key& AVLTree<Key, T, Compare, Allocator, Policy>::Node::key() const {
+  return Policy::key(data_);
 }
 
 /////////////////////////////////////
@@ -94,14 +59,25 @@ typename AVLTree<Key, T>::Node* AVLTree<Key, T>::Node::right_rotate() {
 /////////////////////////////////////
 
 // Constructors
-template <typename Key, typename T>
-AVLTree<Key, T>::AVLTree() : root_(nullptr), size_(0){};
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::AVLTree() : AVLTree(Compare()) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::AVLTree(const Compare& comp,
+                                                     const Allocator& alloc)
+    : size_(0), pool_(alloc), comp_(comp) {
+  reset_header();
+}
 
-template <typename Key, typename T>
-AVLTree<Key, T>::AVLTree(std::initializer_list<value_type> const& items)
-    : root_(nullptr) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::AVLTree(
+    std::initializer_list<value_type> const& items)
+    : AVLTree() {
   for (const auto& item : items) {
-    insert(item);
+    emplace_unique(Policy::key(item), item);
   }
 }
 
@@ -114,24 +90,30 @@ AVLTree<Key, T>::AVLTree(std::initializer_list<value_type> const& items)
 //   root_ = new Node(elem, elem);
 // }
 
-template <typename Key, typename T>
-AVLTree<Key, T>::AVLTree(const AVLTree& other) noexcept
-    : root_(nullptr), size_(0) {
-  if (other.root_ != nullptr) {
-    root_ = copy_node(other.root_);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::AVLTree(
+    const AVLTree& other) noexcept
+    : AVLTree(other.comp_, other.pool_.get_allocator()) {
+  if (other.root() != nullptr) {
+    header_.parent_ = copy_node(other.root());
+    header_.parent_->parent_ = &header_;
+    header_.left_ = find_min_node(header_.parent_);
+    header_.right_ = find_max_node(header_.parent_);
     size_ = other.size_;
   }
 }
 
-template <typename Key, typename T>
-AVLTree<Key, T>::AVLTree(AVLTree&& other) noexcept
-    : root_(other.root_), size_(other.size_) {
-  other.root_ = nullptr;
-  other.size_ = 0;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::AVLTree(AVLTree&& other) noexcept
+    : AVLTree(other.comp_, other.pool_.get_allocator()) {
+  swap(other);
 }
 
-template <typename Key, typename T>
-AVLTree<Key, T>::~AVLTree() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::~AVLTree() {
   clear();
 }
 
@@ -146,14 +128,14 @@ AVLTree<Key, T>::~AVLTree() {
 //   }
 // }
 
-template <typename Key, typename T>
-AVLTree<Key, T>& AVLTree<Key, T>::operator=(AVLTree&& other) noexcept {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>&
+AVLTree<Key, T, Compare, Allocator, Policy>::operator=(
+    AVLTree&& other) noexcept {
   if (this != &other) {
-    root_ = other.root_;
-    size_ = other.size_;
-
-    other.root_ = nullptr;
-    other.size_ = 0;
+    clear();
+    swap(other);
   }
   return *this;
 }
@@ -162,18 +144,21 @@ AVLTree<Key, T>& AVLTree<Key, T>::operator=(AVLTree&& other) noexcept {
 ////////    CAPACITY    /////////////////
 /////////////////////////////////////////
 
-template <typename Key, typename T>
-bool AVLTree<Key, T>::empty() const {
-  return size_ == 0 && root_ == nullptr;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+bool AVLTree<Key, T, Compare, Allocator, Policy>::empty() const {
+  return size_ == 0 && root() == nullptr;
 }
 
-template <typename Key, typename T>
-size_t AVLTree<Key, T>::size() const {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+size_t AVLTree<Key, T, Compare, Allocator, Policy>::size() const {
   return size_;
 }
 
-template <typename Key, typename T>
-size_t AVLTree<Key, T>::max_size() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+size_t AVLTree<Key, T, Compare, Allocator, Policy>::max_size() {
   return std::numeric_limits<size_t>::max();
 }
 
@@ -181,279 +166,904 @@ size_t AVLTree<Key, T>::max_size() {
 ////////    MODIFIERS    /////////////////
 //////////////////////////////////////////
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::clear() {
-  this->clear_tree(this->root_);
-  this->root_ = nullptr;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::clear() {
+  if (!std::is_trivially_destructible<Node>::value) {
+    this->clear_tree(root());
+  }
+  pool_.release();
+  reset_header();
+  stats_.count_deallocations(size_);
   size_ = 0;
 }
 
-template <typename Key, typename T>
-std::pair<typename AVLTree<Key, T>::iterator, bool> AVLTree<Key, T>::insert(
-    const Key& key, const T& value) {
-  Node* inserted_node = nullptr;
-  bool inserted = false;
-
-  root_ = insert_node(root_, key, value, inserted_node, inserted);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+std::pair<typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator, bool>
+AVLTree<Key, T, Compare, Allocator, Policy>::insert(const Key& key,
+                                                    const T& value) {
+  return emplace_unique(key, key, value);
+}
 
-  if (inserted) {
-    return {iterator(inserted_node), true};
-  } else {
-    Node* existing_node = find_node(root_, key);
-    return {iterator(existing_node), false};
+// The node is only created once key turned out to be missing.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K, typename... Args>
+std::pair<typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator, bool>
+AVLTree<Key, T, Compare, Allocator, Policy>::emplace_unique(const K& key,
+                                                            Args&&... args) {
+  NodeBase* parent = &header_;
+  NodeBase** link = &header_.parent_;
+  size_type depth = 0;
+
+  while (*link != nullptr) {
+    parent = *link;
+    ++depth;
+    const Key& parent_key = static_cast<Node*>(parent)->key();
+    if (key_less(key, parent_key)) {
+      link = &parent->left_;
+    } else if (key_less(parent_key, key)) {
+      link = &parent->right_;
+    } else {
+      stats_.record_depth(depth);
+      return {iterator(parent), false};
+    }
   }
+  stats_.record_depth(depth);
+
+  return {iterator(link_node(parent, link, std::forward<Args>(args)...)),
+          true};
 }
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::erase(Iterator pos) {
-  if (pos == Iterator(nullptr)) {
-    return;
+// Equal keys go to the right, so duplicates keep their insertion order.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K, typename... Args>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::insert_equal(const K& key,
+                                                          Args&&... args) {
+  NodeBase* parent = &header_;
+  NodeBase** link = &header_.parent_;
+  size_type depth = 0;
+
+  while (*link != nullptr) {
+    parent = *link;
+    ++depth;
+    if (key_less(key, static_cast<Node*>(parent)->key())) {
+      link = &parent->left_;
+    } else {
+      link = &parent->right_;
+    }
   }
+  stats_.record_depth(depth);
 
+  return iterator(link_node(parent, link, std::forward<Args>(args)...));
+}
+
+// A hint that is adjacent to the position of key saves the descent from the
+// root, otherwise it is ignored.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::insert(const_iterator hint,
+                                                    const Key& key,
+                                                    const T& value) {
+  return insert_hint_unique(hint_position(hint), key, key, value).first;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::erase(Iterator pos) {
   Node* node_to_remove = pos.get_node();
   if (!node_to_remove) {
     return;
   }
 
-  root_ = erase_node(root_, node_to_remove->key_);
+  erase_node(node_to_remove);
 }
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::swap(AVLTree& other) noexcept {
-  std::swap(this->root_, other.root_);
+// The span is cut out with two splits by position and the rest is joined
+// back, O(log n) relinking plus O(k) to free the erased nodes. Works for
+// equal keys as well, since nothing is compared. Returns last.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::erase(Iterator first,
+                                                   Iterator last) {
+  if (first == last) {
+    return last;
+  }
+  Iterator next = first;
+  if (++next == last) {
+    erase_node(first.get_node());
+    return last;
+  }
+
+  size_type lo = index_of(first.get_node());
+  size_type hi = last.get_node() != nullptr ? index_of(last.get_node()) : size_;
+  size_type total = size_;
+
+  NodeBase* left;
+  NodeBase* rest;
+  NodeBase* middle;
+  NodeBase* right;
+  split_at(detach_root(), lo, left, rest);
+  split_at(rest, hi - lo, middle, right);
+  attach_root(join2(left, right), total - (hi - lo));
+  release_subtree(middle);
+
+  return last;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::size_type
+AVLTree<Key, T, Compare, Allocator, Policy>::erase(const Key& key) {
+  size_type before = size_;
+  erase(iterator(lower_bound_node(key)), iterator(upper_bound_node(key)));
+  return before - size_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::swap(
+    AVLTree& other) noexcept {
+  std::swap(this->header_, other.header_);
   std::swap(this->size_, other.size_);
+  std::swap(this->comp_, other.comp_);
+  pool_.swap(other.pool_);
+
+  // Links to the header itself have to follow the tree they belong to
+  for (AVLTree* tree : {this, &other}) {
+    if (tree->root() == nullptr) {
+      tree->reset_header();
+    } else {
+      tree->header_.parent_->parent_ = &tree->header_;
+    }
+  }
 }
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::merge(AVLTree& other) {
-  if (this == &other) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::merge(AVLTree& other) {
+  if (this == &other || other.empty()) {
     return;
   }
-  merge_nodes(other.root_);
-  other.clear();
+
+  // Chunks of a different allocator can not be shared
+  if (!(pool_.get_allocator() == other.pool_.get_allocator())) {
+    move_elements(other, true);
+    return;
+  }
+
+  size_type total = size_ + other.size_;
+  std::vector<NodeBase*> duplicates;
+  NodeBase* root = union_nodes(detach_root(), other.detach_root(), duplicates);
+  attach_root(root, total - duplicates.size());
+  other.size_ = 0;
+  return_nodes(other, duplicates);
 }
 
 /////////////////////////////
 ///////    ITERATOR    //////
 /////////////////////////////
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::iterator AVLTree<Key, T>::begin() {
-  return Iterator(find_min_node(root_), this);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::begin() {
+  return Iterator(header_.left_);
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::const_iterator AVLTree<Key, T>::cbegin() {
-  return ConstIterator(find_min_node(root_), this);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::const_iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::cbegin() {
+  return ConstIterator(header_.left_);
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::iterator AVLTree<Key, T>::end() {
-  return Iterator(nullptr, this);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::end() {
+  return Iterator(&header_);
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::const_iterator AVLTree<Key, T>::cend() {
-  return ConstIterator(nullptr, this);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::const_iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::cend() {
+  return ConstIterator(&header_);
 }
 
 // Constructors and Destructor
-template <typename Key, typename T>
-AVLTree<Key, T>::ConstIterator::ConstIterator() noexcept
-    : AVLTree_(nullptr), node_(nullptr) {}
-
-template <typename Key, typename T>
-AVLTree<Key, T>::ConstIterator::ConstIterator(Node* node, AVLTree* tree)
-    : node_(node), AVLTree_(tree) {}
-
-template <typename Key, typename T>
-AVLTree<Key, T>::ConstIterator::ConstIterator(Node* node)
-    : node_(node), AVLTree_(nullptr) {}
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator,
+        Policy>::ConstIterator::ConstIterator() noexcept
+    : node_(nullptr) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::ConstIterator(
+    NodeBase* node) noexcept
+    : node_(node) {}
 
 // Operators
-template <typename Key, typename T>
-bool AVLTree<Key, T>::ConstIterator::operator==(
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+bool AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator==(
     const ConstIterator& other) const {
   return this->node_ == other.node_;
 }
 
-template <typename Key, typename T>
-bool AVLTree<Key, T>::ConstIterator::operator!=(
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+bool AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator!=(
     const ConstIterator& other) const {
   return this->node_ != other.node_;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::value_type AVLTree<Key, T>::ConstIterator::operator*()
-    const {
-  if (node_ == nullptr) {
-    throw std::out_of_range("Iterator is out of bounds[operator *]");
-  }
-  return node_->key_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::const_reference
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator*() const {
+  return get_element();
 }
 
-template <typename Key, typename T>
-const typename AVLTree<Key, T>::value_type*
-AVLTree<Key, T>::ConstIterator::operator->() const {
-  return &(node_->key_);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+const typename AVLTree<Key, T, Compare, Allocator, Policy>::value_type*
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator->() const {
+  return &get_element();
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::ConstIterator&
-AVLTree<Key, T>::ConstIterator::operator++() {
-  if (node_ == nullptr) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator&
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator++() {
+  if (node_ == nullptr || node_->is_header()) {
     throw std::out_of_range("Iterator is out of bounds[operator ++]");
   }
 
-  node_ = AVLTree_->find_next_node(node_);
+  node_ = find_next_node(node_);
 
   return *this;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::ConstIterator
-AVLTree<Key, T>::ConstIterator::operator++(int) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator++(int) {
   ConstIterator temp = *this;
   ++(*this);
   return temp;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::ConstIterator&
-AVLTree<Key, T>::ConstIterator::operator--() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator&
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator--() {
   if (node_ == nullptr) {
-    node_ = AVLTree_->find_last_node();
-    if (node_ == nullptr) {
+    throw std::out_of_range("Iterator is out of bounds[operator --]");
+  }
+  if (node_->is_header()) {
+    if (node_->right_->is_header()) {
       throw std::out_of_range("Cannot decrement iterator in an empty tree.");
     }
+    node_ = node_->right_;
   } else {
-    node_ = AVLTree_->find_prev_node(node_);
-    if (node_ == nullptr) {
+    NodeBase* prev = find_prev_node(node_);
+    if (prev->is_header()) {
       throw std::out_of_range("Iterator moved before the first element.");
     }
+    node_ = prev;
   }
   return *this;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::ConstIterator
-AVLTree<Key, T>::ConstIterator::operator--(int) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::operator--(int) {
   ConstIterator temp = *this;
   --(*this);
   return temp;
 }
 
 // Iterator
-template <typename Key, typename T>
-typename AVLTree<Key, T>::value_type* AVLTree<Key, T>::Iterator::operator->() {
-  return &(this->get_element());
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::reference
+AVLTree<Key, T, Compare, Allocator, Policy>::Iterator::operator*() const {
+  return this->get_element();
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::reference
-AVLTree<Key, T>::ConstIterator::get_element() const {
-  if (!node_) {
-    throw std::out_of_range("Iterator is invalid or points to end().");
-  }
-  return node_->key_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::pointer
+AVLTree<Key, T, Compare, Allocator, Policy>::Iterator::operator->() const {
+  return &this->get_element();
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::ConstIterator::get_node()
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Iterator&
+AVLTree<Key, T, Compare, Allocator, Policy>::Iterator::operator++() {
+  ConstIterator::operator++();
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::Iterator::operator++(int) {
+  Iterator temp = *this;
+  ++(*this);
+  return temp;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Iterator&
+AVLTree<Key, T, Compare, Allocator, Policy>::Iterator::operator--() {
+  ConstIterator::operator--();
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::Iterator::operator--(int) {
+  Iterator temp = *this;
+  --(*this);
+  return temp;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::value_type&
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::get_element()
     const {
-  return node_;
+  if (node_ == nullptr || node_->is_header()) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return static_cast<Node*>(node_)->data_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Node*
+AVLTree<Key, T, Compare, Allocator, Policy>::ConstIterator::get_node() const {
+  if (node_ == nullptr || node_->is_header()) {
+    return nullptr;
+  }
+  return static_cast<Node*>(node_);
+}
+
+/////////////////////////////////////////
+////////    SET ALGEBRA    //////////////
+/////////////////////////////////////////
+
+// If the work throws, the tree keeps its own elements and whatever was
+// already added or removed, size_ matches the nodes attached.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::set_union(
+    const AVLTree& other, size_type grain_size, ForkJoinPool& workers) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  NodeBase* root = nullptr;
+  try {
+    union_copy(detach_root(), other.header_.parent_, pool_, grain_size,
+               workers, root);
+  } catch (...) {
+    attach_root(root, count_of(root));
+    throw;
+  }
+  attach_root(root, count_of(root));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::set_intersection(
+    const AVLTree& other, size_type grain_size, ForkJoinPool& workers) {
+  if (this == &other) {
+    return;
+  }
+  RemovedList removed;
+  NodeBase* root = nullptr;
+  try {
+    intersect_nodes(detach_root(), other.header_.parent_, removed, grain_size,
+                    workers, root);
+  } catch (...) {
+    attach_root(root, count_of(root));
+    release_removed(removed);
+    throw;
+  }
+  attach_root(root, count_of(root));
+  release_removed(removed);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::set_difference(
+    const AVLTree& other, size_type grain_size, ForkJoinPool& workers) {
+  if (this == &other) {
+    clear();
+    return;
+  }
+  RemovedList removed;
+  NodeBase* root = nullptr;
+  try {
+    difference_nodes(detach_root(), other.header_.parent_, removed,
+                     grain_size, workers, root);
+  } catch (...) {
+    attach_root(root, count_of(root));
+    release_removed(removed);
+    throw;
+  }
+  attach_root(root, count_of(root));
+  release_removed(removed);
 }
 
 /////////////////////////////////////////
 ////////    LOOKUP FUNCTIONS    ///////////
 /////////////////////////////////////////
 
-template <typename Key, typename T>
-bool AVLTree<Key, T>::contains(const Key& key) {
-  Node* current = root_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+bool AVLTree<Key, T, Compare, Allocator, Policy>::contains(const Key& key) {
+  return find_node(root(), key) != nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K, typename C, typename>
+bool AVLTree<Key, T, Compare, Allocator, Policy>::contains(const K& key) {
+  return find_node(root(), key) != nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename ForwardIt, typename OutputIt>
+OutputIt AVLTree<Key, T, Compare, Allocator, Policy>::contains_batch(
+    ForwardIt first, ForwardIt last, OutputIt out) {
+  find_nodes(first, last, [&out](Node* node) { *out++ = node != nullptr; });
+  return out;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::lower_bound(const Key& key) {
+  return iterator(lower_bound_node(key));
+}
 
-  while (current != nullptr) {
-    if (key < current->key_) {
-      current = current->left_;
-    } else if (key > current->key_) {
-      current = current->right_;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::upper_bound(const Key& key) {
+  return iterator(upper_bound_node(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+std::pair<typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator,
+          typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator>
+AVLTree<Key, T, Compare, Allocator, Policy>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::key_compare
+AVLTree<Key, T, Compare, Allocator, Policy>::key_comp() const {
+  return comp_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::allocator_type
+AVLTree<Key, T, Compare, Allocator, Policy>::get_allocator() const {
+  return pool_.get_allocator();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::select(size_type k) {
+  NodeBase* node = header_.parent_;
+
+  while (node != nullptr) {
+    size_type left_count = node->left_ != nullptr ? node->left_->count : 0;
+    if (k < left_count) {
+      node = node->left_;
+    } else if (k == left_count) {
+      return iterator(node);
     } else {
-      return true;
+      k -= left_count + 1;
+      node = node->right_;
     }
   }
 
-  return false;
+  return end();
 }
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::display() {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::size_type
+AVLTree<Key, T, Compare, Allocator, Policy>::rank(const Key& key) {
+  return lower_rank(key);
+}
+
+// Number of keys in [lo, hi)
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::size_type
+AVLTree<Key, T, Compare, Allocator, Policy>::count_range(const Key& lo,
+                                                         const Key& hi) {
+  if (!key_less(lo, hi)) {
+    return 0;
+  }
+  return rank(hi) - rank(lo);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::display() {
   printf("\n");
-  if (root_ != nullptr)
-    display(root_);
+  if (root() != nullptr)
+    display(root());
   else
     printf("Empty");
   printf("\n");
 }
 
+/////////////////////////////////////////
+////////    SNAPSHOTS    ////////////////
+/////////////////////////////////////////
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::save(
+    const std::string& path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  save(out);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::save(
+    std::ostream& out) const {
+  using Record = SnapshotRecord<value_type>;
+  static_assert(Record::kSupported,
+                "snapshots need trivially copyable keys and mapped values");
+
+  SnapshotWriter writer(out);
+  SnapshotHeader header =
+      SnapshotHeader::make(Record::kKeySize, Record::kMappedSize, size_);
+  writer.write(&header, sizeof(header));
+
+  SnapshotChecksum checksum(size_);
+  unsigned char record[Record::kSize];
+  for (NodeBase* node = header_.left_; node != &header_;
+       node = find_next_node(node)) {
+    Record::store(static_cast<Node*>(node)->data_, record);
+    checksum.update(record, Record::kSize);
+    writer.write(record, Record::kSize);
+  }
+  std::uint64_t sum = checksum.value();
+  writer.write(&sum, sizeof(sum));
+  writer.flush();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::load(
+    const std::string& path) {
+  MappedFile file(path);
+  SnapshotMemoryReader reader(file.data(), file.size());
+  load_snapshot(reader);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::load(std::istream& in) {
+  SnapshotStreamReader reader(in);
+  load_snapshot(reader);
+}
+
+/////////////////////////////////////////
+////////    INSTRUMENTATION    //////////
+/////////////////////////////////////////
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+TreeStats AVLTree<Key, T, Compare, Allocator, Policy>::stats() const {
+  return stats_.get();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::reset_stats() {
+  stats_.reset();
+}
+
 /////////////////////////////////////////
 ////////    HELP FUNCTIONS    ///////////
 /////////////////////////////////////////
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::clear_tree(Node* root) {
+// Only runs the node destructors, the memory itself is returned to the pool
+// chunk by chunk in clear().
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Node*
+AVLTree<Key, T, Compare, Allocator, Policy>::root() const {
+  return static_cast<Node*>(header_.parent_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::reset_header() {
+  header_.parent_ = nullptr;
+  header_.left_ = &header_;
+  header_.right_ = &header_;
+  header_.count = 0;
+  header_.height = 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::clear_tree(Node* root) {
   if (root == nullptr) return;
-  clear_tree(root->left_);
-  clear_tree(root->right_);
-  delete root;
+  clear_tree(static_cast<Node*>(root->left_));
+  clear_tree(static_cast<Node*>(root->right_));
+  root->~Node();
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::find_node(Node* node,
-                                                           const Key& key) {
-  if (node == nullptr || node->key_ == key) {
-    return node;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::destroy_node(Node* node) {
+  pool_.destroy(node);
+  stats_.count_deallocations();
+  size_--;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename A, typename B>
+bool AVLTree<Key, T, Compare, Allocator, Policy>::key_less(const A& a,
+                                                           const B& b) const {
+  stats_.count_comparison();
+  return comp_(a, b);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Node*
+AVLTree<Key, T, Compare, Allocator, Policy>::find_node(Node* node,
+                                                       const K& key) const {
+  size_type depth = 0;
+  while (node != nullptr) {
+    ++depth;
+    if (key_less(key, node->key())) {
+      node = static_cast<Node*>(node->left_);
+    } else if (key_less(node->key(), key)) {
+      node = static_cast<Node*>(node->right_);
+    } else {
+      break;
+    }
   }
-  if (key < node->key_) {
-    return find_node(node->left_, key);
-  } else {
-    return find_node(node->right_, key);
+  stats_.record_depth(depth);
+  return node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::prefetch_node(
+    const NodeBase* node) {
+#if defined(__GNUC__)
+  __builtin_prefetch(node);
+#else
+  (void)node;
+#endif
+}
+
+// A lane that has found its key, or fallen off the tree, keeps its node
+// and drops out of the rounds
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename ForwardIt, typename Visit>
+void AVLTree<Key, T, Compare, Allocator, Policy>::find_nodes(
+    ForwardIt first, ForwardIt last, Visit visit) const {
+  std::array<ForwardIt, kBatchWidth> keys;
+  std::array<Node*, kBatchWidth> nodes;
+  std::array<bool, kBatchWidth> searching;
+  while (first != last) {
+    size_type lanes = 0;
+    for (; lanes < kBatchWidth && first != last; ++lanes, ++first) {
+      keys[lanes] = first;
+      nodes[lanes] = root();
+      searching[lanes] = true;
+    }
+    size_type depth = 0;
+    for (size_type active = lanes; active > 0;) {
+      bool compared = false;
+      for (size_type i = 0; i < lanes; ++i) {
+        if (!searching[i]) {
+          continue;
+        }
+        Node* node = nodes[i];
+        compared = compared || node != nullptr;
+        if (node != nullptr && key_less(*keys[i], node->key())) {
+          node = static_cast<Node*>(node->left_);
+        } else if (node != nullptr && key_less(node->key(), *keys[i])) {
+          node = static_cast<Node*>(node->right_);
+        } else {
+          searching[i] = false;
+          --active;
+          continue;
+        }
+        prefetch_node(node);
+        nodes[i] = node;
+      }
+      depth += compared;
+    }
+    stats_.record_depth(depth);
+    for (size_type i = 0; i < lanes; ++i) {
+      visit(nodes[i]);
+    }
   }
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::copy_node(Node* other_node) {
-  if (other_node == nullptr) {
-    return nullptr;
+// Number of keys strictly less than key
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::size_type
+AVLTree<Key, T, Compare, Allocator, Policy>::lower_rank(const K& key) {
+  size_type result = 0;
+  NodeBase* node = header_.parent_;
+  size_type depth = 0;
+
+  while (node != nullptr) {
+    ++depth;
+    if (key_less(static_cast<Node*>(node)->key(), key)) {
+      result += (node->left_ != nullptr ? node->left_->count : 0) + 1;
+      node = node->right_;
+    } else {
+      node = node->left_;
+    }
   }
-  Node* new_node = new Node(other_node->key_, other_node->value_);
+  stats_.record_depth(depth);
+
+  return result;
+}
 
-  new_node->left_ = copy_node(other_node->left_);
-  if (new_node->left_ != nullptr) {
-    new_node->left_->parent_ = new_node;
+// First node whose key is not less than key, the header if there is none
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::lower_bound_node(const K& key) {
+  NodeBase* result = &header_;
+  NodeBase* node = header_.parent_;
+  size_type depth = 0;
+
+  while (node != nullptr) {
+    ++depth;
+    if (key_less(static_cast<Node*>(node)->key(), key)) {
+      node = node->right_;
+    } else {
+      result = node;
+      node = node->left_;
+    }
   }
-  new_node->right_ = copy_node(other_node->right_);
-  if (new_node->right_ != nullptr) {
-    new_node->right_->parent_ = new_node;
+  stats_.record_depth(depth);
+
+  return result;
+}
+
+// First node whose key is greater than key, the header if there is none
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::upper_bound_node(const K& key) {
+  NodeBase* result = &header_;
+  NodeBase* node = header_.parent_;
+  size_type depth = 0;
+
+  while (node != nullptr) {
+    ++depth;
+    if (key_less(key, static_cast<Node*>(node)->key())) {
+      result = node;
+      node = node->left_;
+    } else {
+      node = node->right_;
+    }
   }
+  stats_.record_depth(depth);
 
-  return new_node;
+  return result;
 }
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::merge_nodes(Node* node) {
-  if (node == nullptr) return;
-  merge_nodes(node->left_);
-  // insert(node->element_.first, node->element_.second);
-  insert(node->key_, node->value_);
-  // insert(value_type value)
-  merge_nodes(node->right_);
+// Number of keys less than or equal to key
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::size_type
+AVLTree<Key, T, Compare, Allocator, Policy>::upper_rank(const K& key) {
+  size_type result = 0;
+  NodeBase* node = header_.parent_;
+  size_type depth = 0;
+
+  while (node != nullptr) {
+    ++depth;
+    if (key_less(key, static_cast<Node*>(node)->key())) {
+      node = node->left_;
+    } else {
+      result += (node->left_ != nullptr ? node->left_->count : 0) + 1;
+      node = node->right_;
+    }
+  }
+  stats_.record_depth(depth);
+
+  return result;
 }
 
-template <typename Key, typename T>
-void AVLTree<Key, T>::display(
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Node*
+AVLTree<Key, T, Compare, Allocator, Policy>::copy_node(Node* other_node) {
+  return copy_node(other_node, pool_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Node*
+AVLTree<Key, T, Compare, Allocator, Policy>::copy_node(
+    Node* other_node, NodePool<Node, Allocator>& pool) {
+  if (other_node == nullptr) {
+    return nullptr;
+  }
+  Node* new_node = pool.create(other_node->data_);
+  stats_.count_allocations();
+  new_node->count = other_node->count;
+  new_node->height = other_node->height;
+
+  try {
+    new_node->left_ = copy_node(static_cast<Node*>(other_node->left_), pool);
+    if (new_node->left_ != nullptr) {
+      new_node->left_->parent_ = new_node;
+    }
+    new_node->right_ =
+        copy_node(static_cast<Node*>(other_node->right_), pool);
+    if (new_node->right_ != nullptr) {
+      new_node->right_->parent_ = new_node;
+    }
+  } catch (...) {
+    release_subtree(new_node, pool);
+    throw;
+  }
+
+  return new_node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::display(
     Node* current, int depth,
     int state) {  // state: 1 -> left, 2 -> right , 0 -> root
-  if (current->left_) display(current->left_, depth + 1, 1);
+  if (current->left_)
+    display(static_cast<Node*>(current->left_), depth + 1, 1);
 
   for (int i = 0; i < depth; i++) printf("     ");
 
@@ -464,13 +1074,7 @@ void AVLTree<Key, T>::display(
     printf("└───");
   // printf("\\---");
 
-  if (current->parent_ != nullptr) {
-    std::cout << "[" << current->value_ << "] - (k:" << current->key_ << ")"
-              << std::endl;
-  } else {
-    std::cout << "[" << current->value_ << "] - (k:" << current->key_ << ")"
-              << std::endl;
-  }
+  std::cout << "[" << current->key() << "]" << std::endl;
   // if (current->parent_ != nullptr) {
   //     std::cout << "[" << current->value_ << "] - (p:" <<
   //     current->parent_->value_ << ")" << std::endl;
@@ -483,20 +1087,21 @@ void AVLTree<Key, T>::display(
   //     std::cout << "[" << current->value_ << "]" << std::endl;
   // }
 
-  if (current->right_) display(current->right_, depth + 1, 2);
+  if (current->right_)
+    display(static_cast<Node*>(current->right_), depth + 1, 2);
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::find_next_node(Node* node) {
-  if (!node) return nullptr;
-  if (node == find_max_node(root_)) {
-    return nullptr;
-  }
+// Both walks stop at the header, which is what find_next_node returns for
+// the rightmost node and find_prev_node for the leftmost one.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::find_next_node(NodeBase* node) {
   if (node->right_) {
     return find_min_node(node->right_);
   }
-  Node* parent = node->parent_;
-  while (parent && node == parent->right_) {
+  NodeBase* parent = node->parent_;
+  while (!parent->is_header() && node == parent->right_) {
     node = parent;
     parent = parent->parent_;
   }
@@ -504,187 +1109,1097 @@ typename AVLTree<Key, T>::Node* AVLTree<Key, T>::find_next_node(Node* node) {
   return parent;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::find_min_node(Node* node) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::find_prev_node(NodeBase* node) {
+  if (node->left_) {
+    return find_max_node(node->left_);
+  }
+  NodeBase* parent = node->parent_;
+  while (!parent->is_header() && node == parent->left_) {
+    node = parent;
+    parent = parent->parent_;
+  }
+  return parent;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::find_min_node(NodeBase* node) {
   while (node && node->left_) {
     node = node->left_;
   }
   return node;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::find_max_node(Node* node) {
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::find_max_node(NodeBase* node) {
   while (node && node->right_ != nullptr) {
     node = node->right_;
   }
   return node;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::find_last_node() const {
-  Node* current = root_;
-  if (current == nullptr) {
-    return nullptr;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::erase_node(Node* node) {
+  NodeBase* rebalance_from = node->parent_;
+
+  if (node == header_.left_) {
+    header_.left_ = find_next_node(node);
+  }
+  if (node == header_.right_) {
+    header_.right_ = find_prev_node(node);
   }
-  while (current->right_ != nullptr) {
-    current = current->right_;
+
+  if (node->left_ != nullptr && node->right_ != nullptr) {
+    // Узел - два потомка: на его место переносится сам преемник, ключи не
+    // копируются
+    NodeBase* successor = find_min_node(node->right_);
+    if (successor->parent_ != node) {
+      rebalance_from = successor->parent_;
+      rebalance_from->left_ = successor->right_;
+      if (successor->right_ != nullptr) {
+        successor->right_->parent_ = rebalance_from;
+      }
+      successor->right_ = node->right_;
+      successor->right_->parent_ = successor;
+    } else {
+      rebalance_from = successor;
+    }
+    successor->left_ = node->left_;
+    successor->left_->parent_ = successor;
+    successor->height = node->height;
+    successor->count = node->count;
+    replace_child(node, successor);
+  } else {
+    // Лист или один потомок
+    replace_child(node, node->left_ != nullptr ? node->left_ : node->right_);
   }
-  return current;
+
+  destroy_node(node);
+  rebalance_path(rebalance_from, -1);
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::find_prev_node(Node* node) {
-  if (!node) return nullptr;
-  if (node->left_) {
-    return find_max_node(node->left_);
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::replace_child(
+    NodeBase* old_child, NodeBase* new_child) {
+  NodeBase* parent = old_child->parent_;
+  if (new_child != nullptr) {
+    new_child->parent_ = parent;
   }
-  Node* parent = node->parent_;
-  while (parent && node == parent->left_) {
-    node = parent;
-    parent = parent->parent_;
+
+  if (parent == nullptr) {
+    // root of a detached subtree, nothing to relink
+  } else if (parent->is_header()) {
+    header_.parent_ = new_child;
+  } else if (parent->left_ == old_child) {
+    parent->left_ = new_child;
+  } else {
+    parent->right_ = new_child;
   }
-  return parent;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::erase_node(Node* node,
-                                                            const Key& key) {
-  if (!node) {
-    return nullptr;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::left_rotate(NodeBase* node) {
+  stats_.count_left_rotation();
+  NodeBase* R = node->right_;
+  node->right_ = R->left_;
+  if (R->left_ != nullptr) {
+    R->left_->parent_ = node;
   }
+  replace_child(node, R);
+  R->left_ = node;
+  node->parent_ = R;
 
-  if (key < node->key_) {
-    node->left_ = erase_node(node->left_, key);
-    if (node->left_) {
-      node->left_->parent_ = node;
+  node->update_values();
+  R->update_values();
+
+  return R;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::right_rotate(NodeBase* node) {
+  stats_.count_right_rotation();
+  NodeBase* L = node->left_;
+  node->left_ = L->right_;
+  if (L->right_ != nullptr) {
+    L->right_->parent_ = node;
+  }
+  // Обновляем родителя узла L
+  replace_child(node, L);
+  L->right_ = node;
+  node->parent_ = L;
+
+  node->update_values();
+  L->update_values();
+
+  return L;
+}
+
+// Restores the AVL invariant for a single node whose children are already
+// balanced and returns the new root of its subtree.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::balance_node(NodeBase* node) {
+  node->update_values();
+  int balance = node->balance_factor();
+
+  // Левый перекос
+  if (balance > 1) {
+    if (node->left_->balance_factor() < 0) {
+      left_rotate(node->left_);
     }
-  } else if (key > node->key_) {
-    node->right_ = erase_node(node->right_, key);
-    if (node->right_) {
-      node->right_->parent_ = node;
+    node = right_rotate(node);
+  }
+
+  // Правый перекос
+  if (balance < -1) {
+    if (node->right_->balance_factor() > 0) {
+      right_rotate(node->right_);
     }
-  } else {
-    if (!node->left_ && !node->right_) {
-      // Узел — лист
-      delete node;
-      size_--;
-      return nullptr;
-    } else if (!node->left_ || !node->right_) {
-      // Узел имеет одного потомка
-      Node* child = node->left_ ? node->left_ : node->right_;
-      child->parent_ = node->parent_;
-      delete node;
-      size_--;
-      return child;
+    node = left_rotate(node);
+  }
+
+  return node;
+}
+
+// Walks from node up to the root after an insert or erase below it. Once a
+// subtree keeps its height the ancestors cannot get unbalanced anymore and
+// each of them just gained or lost one node, count_delta.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::rebalance_path(
+    NodeBase* node, int count_delta) {
+  bool height_changed = true;
+
+  while (!node->is_header()) {
+    if (height_changed) {
+      int old_height = node->height;
+      node = balance_node(node);
+      height_changed = node->height != old_height;
     } else {
-      // Узел - два потомка
-      node = replace_with_successor(node);
+      node->count += count_delta;
     }
+    node = node->parent_;
   }
+}
+
+// The node a hint points to, the header for end()
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::hint_position(
+    const_iterator hint) {
+  return hint.node_;
+}
+
+// Links a new node right before pos in key order, pos may be the header.
+// The free link is the left child of pos or the right child of its
+// predecessor, so no comparisons are needed.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename... Args>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Node*
+AVLTree<Key, T, Compare, Allocator, Policy>::link_before(NodeBase* pos,
+                                                         Args&&... args) {
+  if (pos == &header_) {
+    if (header_.parent_ == nullptr) {
+      return link_node(&header_, &header_.parent_,
+                       std::forward<Args>(args)...);
+    }
+    return link_node(header_.right_, &header_.right_->right_,
+                     std::forward<Args>(args)...);
+  }
+  if (pos->left_ == nullptr) {
+    return link_node(pos, &pos->left_, std::forward<Args>(args)...);
+  }
+  NodeBase* before = find_max_node(pos->left_);
+  return link_node(before, &before->right_, std::forward<Args>(args)...);
+}
 
-  // Балансировка
+// Tries the gap right before pos and the one right after it, which covers
+// appends with end() or the last inserted element as the hint. Appends and
+// prepends compare only with the cached rightmost or leftmost node.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K, typename... Args>
+std::pair<typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator, bool>
+AVLTree<Key, T, Compare, Allocator, Policy>::insert_hint_unique(
+    NodeBase* pos, const K& key, Args&&... args) {
+  if (pos != &header_ && !key_less(key, static_cast<Node*>(pos)->key())) {
+    if (!key_less(static_cast<Node*>(pos)->key(), key)) {
+      return {iterator(pos), false};
+    }
+    pos = find_next_node(pos);
+    if (pos != &header_ && !key_less(key, static_cast<Node*>(pos)->key())) {
+      return emplace_unique(key, std::forward<Args>(args)...);
+    }
+  } else if (pos != header_.left_) {
+    NodeBase* before = pos == &header_ ? header_.right_ : find_prev_node(pos);
+    if (!key_less(static_cast<Node*>(before)->key(), key)) {
+      return emplace_unique(key, std::forward<Args>(args)...);
+    }
+  }
+  return {iterator(link_before(pos, std::forward<Args>(args)...)), true};
+}
+
+// Same for equal keys, which end up as close to pos as possible
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename K, typename... Args>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::iterator
+AVLTree<Key, T, Compare, Allocator, Policy>::insert_hint_equal(
+    NodeBase* pos, const K& key, Args&&... args) {
+  if (pos != &header_ && key_less(static_cast<Node*>(pos)->key(), key)) {
+    pos = find_next_node(pos);
+    if (pos != &header_ && key_less(static_cast<Node*>(pos)->key(), key)) {
+      return insert_equal(key, std::forward<Args>(args)...);
+    }
+  } else if (pos != header_.left_) {
+    NodeBase* before = pos == &header_ ? header_.right_ : find_prev_node(pos);
+    if (key_less(key, static_cast<Node*>(before)->key())) {
+      return insert_equal(key, std::forward<Args>(args)...);
+    }
+  }
+  return iterator(link_before(pos, std::forward<Args>(args)...));
+}
+
+// Attaches a new node at link below parent, keeps the cached leftmost and
+// rightmost nodes up to date and rebalances the path to the root.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename... Args>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::Node*
+AVLTree<Key, T, Compare, Allocator, Policy>::link_node(NodeBase* parent,
+                                                       NodeBase** link,
+                                                       Args&&... args) {
+  Node* inserted_node = pool_.create(std::forward<Args>(args)...);
+  stats_.count_allocations();
+  inserted_node->parent_ = parent;
+  *link = inserted_node;
+  size_++;
+
+  if (parent == &header_) {
+    header_.left_ = inserted_node;
+    header_.right_ = inserted_node;
+  } else if (link == &header_.left_->left_) {
+    header_.left_ = inserted_node;
+  } else if (link == &header_.right_->right_) {
+    header_.right_ = inserted_node;
+  }
+
+  rebalance_path(parent, 1);
+  return inserted_node;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::attach_root(NodeBase* root,
+                                                              size_type size) {
+  if (root == nullptr) {
+    reset_header();
+  } else {
+    header_.parent_ = root;
+    root->parent_ = &header_;
+    header_.left_ = find_min_node(root);
+    header_.right_ = find_max_node(root);
+  }
+  size_ = size;
+}
+
+// Links already allocated nodes, given in key order, into a perfectly
+// balanced subtree. Sizes of sibling subtrees differ by at most one, so the
+// result is a valid AVL tree with no rotations.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::build_balanced(NodeBase** nodes,
+                                                            size_type n,
+                                                            NodeBase* parent) {
+  if (n == 0) {
+    return nullptr;
+  }
+
+  size_type mid = n / 2;
+  NodeBase* node = nodes[mid];
+  node->parent_ = parent;
+  node->left_ = build_balanced(nodes, mid, node);
+  node->right_ = build_balanced(nodes + mid + 1, n - mid - 1, node);
   node->update_values();
-  int balance = node->balance_factor();
 
-  // Левый перекос
-  if (balance > 1 && node->left_->balance_factor() >= 0) {
-    return node->right_rotate();
+  return node;
+}
+
+// Same shape as build_balanced, but the nodes are created in order while
+// consuming a sorted range. data_of maps an element of the range to the
+// value a node is built from. Runs of equal keys are collapsed to their
+// first element, so n has to be the number of distinct keys left in the
+// range. If a copy throws, what was built so far is released.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename ForwardIt, typename DataOf>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::build_sorted(
+    ForwardIt& it, ForwardIt last, size_type n, DataOf data_of) {
+  if (n == 0) {
+    return nullptr;
   }
-  if (balance > 1 && node->left_->balance_factor() < 0) {
-    node->left_ = node->left_->left_rotate();
-    return node->right_rotate();
+
+  size_type left_size = n / 2;
+  NodeBase* left = build_sorted(it, last, left_size, data_of);
+
+  Node* node;
+  try {
+    node = pool_.create(data_of(*it));
+  } catch (...) {
+    release_subtree(left);
+    throw;
+  }
+  stats_.count_allocations();
+  node->left_ = left;
+  if (left != nullptr) {
+    left->parent_ = node;
   }
+  node->right_ = nullptr;
 
-  // Правый перекос
-  if (balance < -1 && node->right_->balance_factor() <= 0) {
-    return node->left_rotate();
+  try {
+    for (++it;
+         it != last && !key_less(node->key(), Policy::key(data_of(*it)));
+         ++it) {
+    }
+    node->right_ = build_sorted(it, last, n - left_size - 1, data_of);
+  } catch (...) {
+    release_subtree(node);
+    throw;
   }
-  if (balance < -1 && node->right_->balance_factor() > 0) {
-    node->right_ = node->right_->right_rotate();
-    return node->left_rotate();
+  if (node->right_ != nullptr) {
+    node->right_->parent_ = node;
   }
+  node->update_values();
 
   return node;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::replace_with_successor(
-    Node* node) {
-  Node* successor = find_min_node(node->right_);
-  Node* successor_parent = successor->parent_;
-  Node* successor_right_child = successor->right_;
+// Same shape as build_balanced, with the nodes made in key order by
+// make_node. If it throws, what was built so far is released.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename MakeNode>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::build_in_order(
+    size_type n, MakeNode& make_node) {
+  if (n == 0) {
+    return nullptr;
+  }
+
+  size_type left_size = n / 2;
+  NodeBase* left = build_in_order(left_size, make_node);
+
+  Node* node;
+  try {
+    node = make_node();
+  } catch (...) {
+    release_subtree(left);
+    throw;
+  }
+  node->left_ = left;
+  if (left != nullptr) {
+    left->parent_ = node;
+  }
+  node->right_ = nullptr;
+  try {
+    node->right_ = build_in_order(n - left_size - 1, make_node);
+  } catch (...) {
+    release_subtree(node);
+    throw;
+  }
+  if (node->right_ != nullptr) {
+    node->right_->parent_ = node;
+  }
+  node->update_values();
 
-  node->key_ = successor->key_;
-  node->value_ = successor->value_;
+  return node;
+}
 
-  if (successor_parent != node) {
-    successor_parent->left_ = successor_right_child;
-    if (successor_right_child) {
-      successor_right_child->parent_ = successor_parent;
+// The header is checked before the tree is cleared, the checksum only once
+// the new tree is built
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename Reader>
+void AVLTree<Key, T, Compare, Allocator, Policy>::load_snapshot(
+    Reader& reader) {
+  using Record = SnapshotRecord<value_type>;
+  static_assert(Record::kSupported,
+                "snapshots need trivially copyable keys and mapped values");
+
+  SnapshotHeader header;
+  std::memcpy(&header, reader.read(sizeof(header)), sizeof(header));
+  header.check(Record::kKeySize, Record::kMappedSize);
+  if (header.count > (std::numeric_limits<size_type>::max() -
+                      sizeof(std::uint64_t)) /
+                         Record::kSize) {
+    throw std::runtime_error("Snapshot is truncated");
+  }
+  size_type count = static_cast<size_type>(header.count);
+  reader.expect(count * Record::kSize + sizeof(std::uint64_t));
+
+  clear();
+  SnapshotChecksum checksum(header.count);
+  auto make_node = [&]() {
+    const unsigned char* record = reader.read(Record::kSize);
+    checksum.update(record, Record::kSize);
+    Node* node = Record::load(record, [this](const auto&... data) {
+      return pool_.create(data...);
+    });
+    stats_.count_allocations();
+    return node;
+  };
+  NodeBase* root = build_in_order(count, make_node);
+
+  std::uint64_t sum;
+  try {
+    std::memcpy(&sum, reader.read(sizeof(sum)), sizeof(sum));
+  } catch (...) {
+    release_subtree(root);
+    throw;
+  }
+  if (sum != checksum.value()) {
+    release_subtree(root);
+    throw std::runtime_error("Snapshot checksum mismatch");
+  }
+  attach_root(root, count);
+}
+
+// Replaces the contents with [first, last)
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename InputIt>
+void AVLTree<Key, T, Compare, Allocator, Policy>::assign_range(InputIt first,
+                                                               InputIt last) {
+  clear();
+  assign_range(first, last,
+               typename std::iterator_traits<InputIt>::iterator_category());
+}
+
+// Sorted input is detected in one pass and built bottom-up in O(n) in a
+// second one; anything else is inserted one by one.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename ForwardIt>
+void AVLTree<Key, T, Compare, Allocator, Policy>::assign_range(
+    ForwardIt first, ForwardIt last, std::forward_iterator_tag) {
+  if (first == last) {
+    return;
+  }
+
+  bool sorted = true;
+  size_type unique = 1;
+  for (ForwardIt prev = first, it = std::next(first); it != last;
+       prev = it, ++it) {
+    if (key_less(Policy::key(*it), Policy::key(*prev))) {
+      sorted = false;
+      break;
     }
+    if (key_less(Policy::key(*prev), Policy::key(*it))) {
+      unique++;
+    }
+  }
+
+  if (sorted) {
+    ForwardIt it = first;
+    auto data_of = [](const auto& value) -> const auto& { return value; };
+    attach_root(build_sorted(it, last, unique, data_of), unique);
   } else {
-    node->right_ = successor_right_child;
-    if (successor_right_child) {
-      successor_right_child->parent_ = node;
+    for (; first != last; ++first) {
+      emplace_unique(Policy::key(*first), *first);
     }
   }
+}
 
-  delete successor;
-  size_--;
+// A single-pass range can not be checked for order before it is consumed
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+template <typename InputIt>
+void AVLTree<Key, T, Compare, Allocator, Policy>::assign_range(
+    InputIt first, InputIt last, std::input_iterator_tag) {
+  for (; first != last; ++first) {
+    emplace_unique(Policy::key(*first), *first);
+  }
+}
+
+// Merges two in-order node sequences and relinks them into one balanced
+// tree in O(n + m), no node is copied. With unique set, nodes whose keys are
+// already present stay in other.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::merge_linear(AVLTree& other,
+                                                               bool unique) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  // Chunks of a different allocator can not be shared
+  if (!(pool_.get_allocator() == other.pool_.get_allocator())) {
+    move_elements(other, unique);
+    return;
+  }
+
+  std::vector<NodeBase*> merged;
+  std::vector<NodeBase*> rest;
+  merged.reserve(size_ + other.size_);
+
+  NodeBase* a = header_.left_;
+  NodeBase* b = other.header_.left_;
+  while (!a->is_header() && !b->is_header()) {
+    const Key& a_key = static_cast<Node*>(a)->key();
+    const Key& b_key = static_cast<Node*>(b)->key();
+    if (key_less(b_key, a_key)) {
+      merged.push_back(b);
+      b = find_next_node(b);
+    } else if (unique && !key_less(a_key, b_key)) {
+      merged.push_back(a);
+      rest.push_back(b);
+      a = find_next_node(a);
+      b = find_next_node(b);
+    } else {
+      merged.push_back(a);
+      a = find_next_node(a);
+    }
+  }
+  for (; !a->is_header(); a = find_next_node(a)) {
+    merged.push_back(a);
+  }
+  for (; !b->is_header(); b = find_next_node(b)) {
+    merged.push_back(b);
+  }
+
+  attach_root(build_balanced(merged.data(), merged.size(), &header_),
+              merged.size());
+  other.reset_header();
+  other.size_ = 0;
+  return_nodes(other, rest);
+}
+
+// Finishes a merge that moved all of other's nodes into this tree except
+// nodes, which are relinked into other's tree. Both pools then own other's
+// chunks, or this pool alone if other is left empty. nodes must be sorted
+// by key and other's tree has to be empty.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::return_nodes(
+    AVLTree& other, std::vector<NodeBase*>& nodes) {
+  if (nodes.empty()) {
+    pool_.splice(other.pool_);
+    return;
+  }
+
+  pool_.share(other.pool_);
+  other.attach_root(
+      build_balanced(nodes.data(), nodes.size(), &other.header_),
+      nodes.size());
+}
+
+// Merge for unequal allocators: the elements of other are moved over one
+// by one. With unique set, keys that are already present stay in other.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::move_elements(AVLTree& other,
+                                                                bool unique) {
+  for (iterator it = other.begin(); it != other.end();) {
+    Node* node = it.get_node();
+    ++it;
+    if (!unique) {
+      insert_equal(node->key(), std::move(node->data_));
+    } else if (!emplace_unique(node->key(), std::move(node->data_)).second) {
+      continue;
+    }
+    other.erase(iterator(node));
+  }
+}
+
+/////////////////////////////////////////
+////////    JOIN / SPLIT    /////////////
+/////////////////////////////////////////
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+int AVLTree<Key, T, Compare, Allocator, Policy>::height_of(NodeBase* node) {
+  return node != nullptr ? node->height : 0;
+}
+
+// Cuts both children off node, leaving them as detached subtrees
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::expose(NodeBase* node,
+                                                         NodeBase*& left,
+                                                         NodeBase*& right) {
+  left = node->left_;
+  right = node->right_;
+  if (left != nullptr) {
+    left->parent_ = nullptr;
+  }
+  if (right != nullptr) {
+    right->parent_ = nullptr;
+  }
+  node->left_ = nullptr;
+  node->right_ = nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::link(NodeBase* left,
+                                                  NodeBase* node,
+                                                  NodeBase* right) {
+  node->left_ = left;
+  node->right_ = right;
+  node->parent_ = nullptr;
+  if (left != nullptr) {
+    left->parent_ = node;
+  }
+  if (right != nullptr) {
+    right->parent_ = node;
+  }
+  node->update_values();
   return node;
 }
 
-template <typename Key, typename T>
-typename AVLTree<Key, T>::Node* AVLTree<Key, T>::insert_node(
-    Node* node, const Key& key, const T& value, Node*& inserted_node,
-    bool& inserted) {
-  if (node == nullptr) {
-    size_++;
-    inserted_node = new Node(key, value);
-    inserted = true;
-    return inserted_node;
+// Takes the whole tree out of the header. The caller is responsible for
+// attaching a root again (attach_root) and fixing size_.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::detach_root() {
+  NodeBase* root = header_.parent_;
+  if (root != nullptr) {
+    root->parent_ = nullptr;
   }
+  reset_header();
+  return root;
+}
 
-  if (key < node->key_) {
-    node->left_ = insert_node(node->left_, key, value, inserted_node, inserted);
-    node->left_->parent_ = node;
-  } else if (key > node->key_) {
-    node->right_ =
-        insert_node(node->right_, key, value, inserted_node, inserted);
-    node->right_->parent_ = node;
+// All keys of left < pivot < all keys of right. Costs
+// O(|height(left) - height(right)| + 1).
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::join(NodeBase* left,
+                                                  NodeBase* pivot,
+                                                  NodeBase* right) {
+  if (height_of(left) > height_of(right) + 1) {
+    return join_right(left, pivot, right);
+  }
+  if (height_of(right) > height_of(left) + 1) {
+    return join_left(left, pivot, right);
+  }
+  return link(left, pivot, right);
+}
+
+// left is the taller tree: walk down its right spine until the heights
+// match, hang pivot there and rebalance on the way back up.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::join_right(NodeBase* left,
+                                                        NodeBase* pivot,
+                                                        NodeBase* right) {
+  NodeBase* l;
+  NodeBase* c;
+  expose(left, l, c);
+
+  if (height_of(c) <= height_of(right) + 1) {
+    NodeBase* t = link(c, pivot, right);
+    if (height_of(t) <= height_of(l) + 1) {
+      return link(l, left, t);
+    }
+    return left_rotate(link(l, left, right_rotate(t)));
+  }
+
+  NodeBase* t = join_right(c, pivot, right);
+  NodeBase* result = link(l, left, t);
+  if (height_of(t) <= height_of(l) + 1) {
+    return result;
+  }
+  return left_rotate(result);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::join_left(NodeBase* left,
+                                                       NodeBase* pivot,
+                                                       NodeBase* right) {
+  NodeBase* c;
+  NodeBase* r;
+  expose(right, c, r);
+
+  if (height_of(c) <= height_of(left) + 1) {
+    NodeBase* t = link(left, pivot, c);
+    if (height_of(t) <= height_of(r) + 1) {
+      return link(t, right, r);
+    }
+    return right_rotate(link(left_rotate(t), right, r));
+  }
+
+  NodeBase* t = join_left(left, pivot, c);
+  NodeBase* result = link(t, right, r);
+  if (height_of(t) <= height_of(r) + 1) {
+    return result;
+  }
+  return right_rotate(result);
+}
+
+// Splits a detached subtree into keys < key (left) and keys > key (right).
+// The node holding key itself, if any, is returned detached.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::split(NodeBase* root,
+                                                   const Key& key,
+                                                   NodeBase*& left,
+                                                   NodeBase*& right) {
+  if (root == nullptr) {
+    left = nullptr;
+    right = nullptr;
+    return nullptr;
+  }
+
+  NodeBase* l;
+  NodeBase* r;
+  expose(root, l, r);
+  const Key& root_key = static_cast<Node*>(root)->key();
+
+  if (key_less(key, root_key)) {
+    NodeBase* right_part;
+    NodeBase* found = split(l, key, left, right_part);
+    right = join(right_part, root, r);
+    return found;
+  }
+  if (key_less(root_key, key)) {
+    NodeBase* left_part;
+    NodeBase* found = split(r, key, left_part, right);
+    left = join(l, root, left_part);
+    return found;
+  }
+
+  left = l;
+  right = r;
+  root->update_values();
+  return root;
+}
+
+// Union of two detached subtrees in O(m log(n / m + 1)). For keys present
+// in both, a's node is kept and b's node is appended to duplicates, which
+// therefore stay in key order.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::union_nodes(
+    NodeBase* a, NodeBase* b, std::vector<NodeBase*>& duplicates) {
+  if (a == nullptr) {
+    return b;
+  }
+  if (b == nullptr) {
+    return a;
+  }
+
+  NodeBase* b_left;
+  NodeBase* b_right;
+  expose(b, b_left, b_right);
+  NodeBase* a_left;
+  NodeBase* a_right;
+  NodeBase* found = split(a, static_cast<Node*>(b)->key(), a_left, a_right);
+
+  NodeBase* left = union_nodes(a_left, b_left, duplicates);
+  NodeBase* pivot = b;
+  if (found != nullptr) {
+    duplicates.push_back(b);
+    pivot = found;
+  }
+  NodeBase* right = union_nodes(a_right, b_right, duplicates);
+
+  return join(left, pivot, right);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::size_type
+AVLTree<Key, T, Compare, Allocator, Policy>::count_of(NodeBase* node) {
+  return node != nullptr ? node->count : 0;
+}
+
+// Detaches and returns the rightmost node of a detached subtree
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::split_last(NodeBase* root,
+                                                        NodeBase*& last) {
+  NodeBase* l;
+  NodeBase* r;
+  expose(root, l, r);
+  if (r == nullptr) {
+    last = root;
+    return l;
+  }
+  NodeBase* rest = split_last(r, last);
+  return join(l, root, rest);
+}
+
+// join without a pivot, all keys of left < all keys of right
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::NodeBase*
+AVLTree<Key, T, Compare, Allocator, Policy>::join2(NodeBase* left,
+                                                   NodeBase* right) {
+  if (left == nullptr) {
+    return right;
+  }
+  if (right == nullptr) {
+    return left;
+  }
+  NodeBase* last;
+  NodeBase* rest = split_last(left, last);
+  return join(rest, last, right);
+}
+
+// Splits a detached subtree into its first k nodes (left) and the rest
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::split_at(NodeBase* root,
+                                                           size_type k,
+                                                           NodeBase*& left,
+                                                           NodeBase*& right) {
+  if (root == nullptr) {
+    left = nullptr;
+    right = nullptr;
+    return;
+  }
+
+  NodeBase* l;
+  NodeBase* r;
+  expose(root, l, r);
+  size_type left_count = count_of(l);
+
+  if (k <= left_count) {
+    NodeBase* right_part;
+    split_at(l, k, left, right_part);
+    right = join(right_part, root, r);
   } else {
-    inserted = false;
-    return node;
+    NodeBase* left_part;
+    split_at(r, k - left_count - 1, left_part, right);
+    left = join(l, root, left_part);
   }
+}
 
-  node->update_values();
-  int balance = node->balance_factor();
+// In-order position of a node of the tree, O(log n)
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+typename AVLTree<Key, T, Compare, Allocator, Policy>::size_type
+AVLTree<Key, T, Compare, Allocator, Policy>::index_of(NodeBase* node) {
+  size_type index = count_of(node->left_);
+  for (NodeBase* parent = node->parent_; !parent->is_header();
+       node = parent, parent = parent->parent_) {
+    if (node == parent->right_) {
+      index += count_of(parent->left_) + 1;
+    }
+  }
+  return index;
+}
 
-  // Левый перекос
-  if (balance > 1 && key < node->left_->key_) {
-    return node->right_rotate();
+// Keys of b missing in a are copied into pool. A forked branch copies into
+// its own pool, which is spliced back once both branches are done. out is
+// set first and on a throw it still gets the partial union of this level.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::union_copy(
+    NodeBase* a, NodeBase* b, NodePool<Node, Allocator>& pool,
+    size_type grain_size, ForkJoinPool& workers, NodeBase*& out) {
+  out = a;
+  if (b == nullptr) {
+    return;
+  }
+  if (a == nullptr) {
+    out = copy_node(static_cast<Node*>(b), pool);
+    return;
   }
 
-  // Левый-правый перекос
-  if (balance > 1 && key > node->left_->key_) {
-    node->left_ = node->left_->left_rotate();
-    return node->right_rotate();
+  Node* b_node = static_cast<Node*>(b);
+  NodeBase* left;
+  NodeBase* right;
+  NodeBase* pivot = split(a, b_node->key(), left, right);
+
+  try {
+    if (count_of(left) + count_of(right) + count_of(b) > grain_size) {
+      NodePool<Node, Allocator> right_pool(pool.get_allocator());
+      try {
+        workers.invoke(
+            [&] {
+              union_copy(left, b->left_, pool, grain_size, workers, left);
+            },
+            [&] {
+              union_copy(right, b->right_, right_pool, grain_size, workers,
+                         right);
+            });
+      } catch (...) {
+        pool.splice(right_pool);
+        throw;
+      }
+      pool.splice(right_pool);
+    } else {
+      union_copy(left, b->left_, pool, grain_size, workers, left);
+      union_copy(right, b->right_, pool, grain_size, workers, right);
+    }
+
+    if (pivot == nullptr) {
+      pivot = pool.create(b_node->data_);
+      stats_.count_allocations();
+    }
+  } catch (...) {
+    out = pivot != nullptr ? join(left, pivot, right) : join2(left, right);
+    throw;
   }
+  out = join(left, pivot, right);
+}
 
-  // Правый перекос
-  if (balance < -1 && key > node->right_->key_) {
-    return node->left_rotate();
+// Subtrees of a without a match in b go to removed, they are freed by the
+// caller once all branches are joined.
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::intersect_nodes(
+    NodeBase* a, NodeBase* b, RemovedList& removed, size_type grain_size,
+    ForkJoinPool& workers, NodeBase*& out) {
+  out = nullptr;
+  if (a == nullptr) {
+    return;
+  }
+  if (b == nullptr) {
+    removed.push(a);
+    return;
   }
 
-  // Правый-левый перекос
-  if (balance < -1 && key < node->right_->key_) {
-    node->right_ = node->right_->right_rotate();
-    return node->left_rotate();
+  NodeBase* left;
+  NodeBase* right;
+  NodeBase* found = split(a, static_cast<Node*>(b)->key(), left, right);
+
+  try {
+    if (count_of(left) + count_of(right) + count_of(b) > grain_size) {
+      RemovedList right_removed;
+      try {
+        workers.invoke(
+            [&] {
+              intersect_nodes(left, b->left_, removed, grain_size, workers,
+                              left);
+            },
+            [&] {
+              intersect_nodes(right, b->right_, right_removed, grain_size,
+                              workers, right);
+            });
+      } catch (...) {
+        removed.append(right_removed);
+        throw;
+      }
+      removed.append(right_removed);
+    } else {
+      intersect_nodes(left, b->left_, removed, grain_size, workers, left);
+      intersect_nodes(right, b->right_, removed, grain_size, workers, right);
+    }
+  } catch (...) {
+    out = found != nullptr ? join(left, found, right) : join2(left, right);
+    throw;
   }
+  out = found != nullptr ? join(left, found, right) : join2(left, right);
+}
 
-  return node;
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::difference_nodes(
+    NodeBase* a, NodeBase* b, RemovedList& removed, size_type grain_size,
+    ForkJoinPool& workers, NodeBase*& out) {
+  out = a;
+  if (a == nullptr || b == nullptr) {
+    return;
+  }
+
+  NodeBase* left;
+  NodeBase* right;
+  NodeBase* found = split(a, static_cast<Node*>(b)->key(), left, right);
+  if (found != nullptr) {
+    removed.push(found);
+  }
+
+  try {
+    if (count_of(left) + count_of(right) + count_of(b) > grain_size) {
+      RemovedList right_removed;
+      try {
+        workers.invoke(
+            [&] {
+              difference_nodes(left, b->left_, removed, grain_size, workers,
+                               left);
+            },
+            [&] {
+              difference_nodes(right, b->right_, right_removed, grain_size,
+                               workers, right);
+            });
+      } catch (...) {
+        removed.append(right_removed);
+        throw;
+      }
+      removed.append(right_removed);
+    } else {
+      difference_nodes(left, b->left_, removed, grain_size, workers, left);
+      difference_nodes(right, b->right_, removed, grain_size, workers, right);
+    }
+  } catch (...) {
+    out = join2(left, right);
+    throw;
+  }
+  out = join2(left, right);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::release_removed(
+    RemovedList& removed) {
+  NodeBase* root = removed.head_;
+  while (root != nullptr) {
+    NodeBase* next = root->parent_;
+    release_subtree(root);
+    root = next;
+  }
+  removed = RemovedList();
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::release_subtree(
+    NodeBase* root) {
+  release_subtree(root, pool_);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator,
+          typename Policy>
+void AVLTree<Key, T, Compare, Allocator, Policy>::release_subtree(
+    NodeBase* root, NodePool<Node, Allocator>& pool) {
+  if (root == nullptr) {
+    return;
+  }
+  release_subtree(root->left_, pool);
+  release_subtree(root->right_, pool);
+  pool.destroy(static_cast<Node*>(root));
+  stats_.count_deallocations();
 }
 
+S21_STATS_NAMESPACE_END
 }  // namespace s21
 
-#endif
\ No newline at end of file
+#endif
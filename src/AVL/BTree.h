@@ -0,0 +1,206 @@
+#ifndef S21_BTREE_H
+#define S21_BTREE_H
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "NodePolicy.h"
+
+namespace s21 {
+
+// B-tree that keeps up to kSlots values per node, sized so that a leaf is
+// about kTargetNodeBytes (four cache lines): 15 values of map<uint64_t,
+// uint64_t>, 60 of set<int>. A lookup touches log_16(n) nodes instead of
+// log_2(n), and the values of a node are compared within the same lines.
+//
+// Every node but the root holds at least kMinSlots values. Values move
+// between nodes on insert and erase, so every modification invalidates
+// iterators, references and pointers into the tree, except that erase
+// returns a valid iterator to the next element.
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+class BTree {
+ public:
+  using key_type = Key;
+  using value_type = typename Policy::value_type;
+  using reference = typename Policy::reference;
+  using const_reference = const value_type&;
+  using pointer = typename Policy::pointer;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ protected:
+  // Values move between slots by constructing the new one and destroying
+  // the old one, which for maps copies the const key
+  using slot_type = value_type;
+
+  static constexpr size_type kTargetNodeBytes = 256;
+  static constexpr size_type kSlots = std::min<size_type>(
+      255, std::max<size_type>(3, (kTargetNodeBytes - 2 * sizeof(void*)) /
+                                      sizeof(slot_type)));
+  static constexpr size_type kMinSlots = (kSlots - 1) / 2;
+
+  // position is the index of the node among its parent's children
+  struct Node {
+    Node* parent;
+    unsigned char position;
+    unsigned char count;
+    bool leaf;
+    alignas(slot_type) unsigned char storage[kSlots * sizeof(slot_type)];
+
+    slot_type* slot(size_type i);
+    const Key& key(size_type i);
+  };
+
+  struct InternalNode : Node {
+    Node* children[kSlots + 1];
+  };
+
+  using SlotAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<slot_type>;
+  using SlotTraits = std::allocator_traits<SlotAllocator>;
+  using LeafAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using InternalAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<InternalNode>;
+
+  Node* root_ = nullptr;
+  size_type size_ = 0;
+  SlotAllocator alloc_;
+  Compare comp_;
+
+ public:
+  class ConstIterator {
+    friend class BTree;
+
+   protected:
+    BTree* tree_;
+    Node* node_;
+    size_type position_;
+
+   public:
+    ConstIterator() noexcept;
+    ConstIterator(BTree* tree, Node* node, size_type position) noexcept;
+
+    bool operator==(const ConstIterator& other) const;
+    bool operator!=(const ConstIterator& other) const;
+    const_reference operator*() const;
+    const value_type* operator->() const;
+    ConstIterator& operator++();
+    ConstIterator operator++(int);
+    ConstIterator& operator--();
+    ConstIterator operator--(int);
+  };
+
+  class Iterator : public ConstIterator {
+   public:
+    Iterator() noexcept : ConstIterator() {}
+    Iterator(BTree* tree, Node* node, size_type position) noexcept
+        : ConstIterator(tree, node, position) {}
+    reference operator*() const;
+    pointer operator->() const;
+    Iterator& operator++();
+    Iterator operator++(int);
+    Iterator& operator--();
+    Iterator operator--(int);
+  };
+
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  iterator begin();
+  iterator end();
+  const_iterator cbegin();
+  const_iterator cend();
+
+  // Constructors
+  BTree();
+  explicit BTree(const Compare& comp, const Allocator& alloc = Allocator());
+  BTree(const BTree& other);
+  BTree(BTree&& other) noexcept;
+  BTree& operator=(BTree&& other) noexcept;
+  ~BTree();
+
+ protected:
+  static InternalNode* internal(Node* node);
+  static Node* child(Node* node, size_type i);
+  void set_child(Node* node, size_type i, Node* child);
+  Node* new_node(bool leaf);
+  void delete_node(Node* node);
+  void destroy_tree(Node* node);
+  Node* copy_tree(Node* other, Node* parent);
+  template <typename... Args>
+  void construct_slot(Node* node, size_type i, Args&&... args);
+  void transfer(Node* dest, size_type i, Node* src, size_type j);
+  static Node* leftmost_leaf(Node* node);
+  static Node* rightmost_leaf(Node* node);
+  template <typename K>
+  size_type lower_index(Node* node, const K& key) const;
+  template <typename K>
+  size_type upper_index(Node* node, const K& key) const;
+  template <typename K>
+  iterator find_position(const K& key);
+
+  // Insertion. insert_slot makes room by splitting node if it is full and
+  // then stores value at pos, and child right after it in internal nodes.
+  iterator insert_slot(Node* node, size_type pos, slot_type&& value,
+                       Node* child);
+  void split_node(Node*& node, size_type& pos);
+  // key is only looked up, args build the value if it is missing
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(const K& key, Args&&... args);
+  // Stores the value right before pos, which has to be the right place
+  template <typename... Args>
+  iterator insert_before(const_iterator pos, Args&&... args);
+  // O(1) when hint is the position of key, emplace_unique otherwise
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> insert_hint_unique(const_iterator hint,
+                                               const K& key, Args&&... args);
+
+  // Erasure. The rebalancing steps keep it, the position of the element
+  // after the erased one, pointing at the same element.
+  iterator erase_position(const_iterator pos);
+  void rebalance_after_erase(Node* node, iterator& it);
+  void rotate_right(Node* parent, size_type i, iterator& it);
+  void rotate_left(Node* parent, size_type i, iterator& it);
+  void merge_children(Node* parent, size_type i, iterator& it);
+
+ public:
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+
+  // Modifiers
+  void clear();
+  iterator erase(iterator pos);
+  iterator erase(iterator first, iterator last);
+  size_type erase(const Key& key);
+  void swap(BTree& other) noexcept;
+  // Moves over the elements whose keys are missing here
+  void merge(BTree& other);
+
+  // Lookup
+  bool contains(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key);
+  iterator lower_bound(const Key& key);
+  iterator upper_bound(const Key& key);
+  std::pair<iterator, iterator> equal_range(const Key& key);
+
+  // Observers
+  key_compare key_comp() const;
+  allocator_type get_allocator() const;
+};
+
+}  // namespace s21
+
+#include "BTree.tpp"
+
+#endif
@@ -0,0 +1,877 @@
+#ifndef S21_BTREE_TPP
+#define S21_BTREE_TPP
+
+#include "BTree.h"
+
+namespace s21 {
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::slot_type*
+BTree<Key, Compare, Allocator, Policy>::Node::slot(size_type i) {
+  return reinterpret_cast<slot_type*>(storage) + i;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+const Key& BTree<Key, Compare, Allocator, Policy>::Node::key(size_type i) {
+  return Policy::key(*slot(i));
+}
+
+/////////////////////////////////////
+/////////    ITERATORS    ///////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::ConstIterator() noexcept
+    : tree_(nullptr), node_(nullptr), position_(0) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::ConstIterator(
+    BTree* tree, Node* node, size_type position) noexcept
+    : tree_(tree), node_(node), position_(position) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator==(
+    const ConstIterator& other) const {
+  return node_ == other.node_ && position_ == other.position_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator!=(
+    const ConstIterator& other) const {
+  return !(*this == other);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::const_reference
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator*() const {
+  if (node_ == nullptr) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return *node_->slot(position_);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+const typename BTree<Key, Compare, Allocator, Policy>::value_type*
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator->() const {
+  return &**this;
+}
+
+// In an internal node the next value is the first one of the right subtree,
+// in a leaf it is the next slot or the first ancestor we come from the left
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::ConstIterator&
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator++() {
+  if (node_ == nullptr) {
+    throw std::out_of_range("Iterator is out of bounds[operator ++]");
+  }
+  if (!node_->leaf) {
+    node_ = leftmost_leaf(child(node_, position_ + 1));
+    position_ = 0;
+    return *this;
+  }
+  ++position_;
+  while (node_ != nullptr && position_ == node_->count) {
+    position_ = node_->position;
+    node_ = node_->parent;
+  }
+  if (node_ == nullptr) {
+    position_ = 0;
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::ConstIterator
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator++(int) {
+  ConstIterator temp = *this;
+  ++(*this);
+  return temp;
+}
+
+// end() steps back to the largest element
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::ConstIterator&
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator--() {
+  if (node_ == nullptr) {
+    if (tree_ == nullptr || tree_->root_ == nullptr) {
+      throw std::out_of_range("Cannot decrement iterator in an empty tree.");
+    }
+    node_ = rightmost_leaf(tree_->root_);
+    position_ = node_->count - 1;
+  } else if (!node_->leaf) {
+    node_ = rightmost_leaf(child(node_, position_));
+    position_ = node_->count - 1;
+  } else if (position_ > 0) {
+    --position_;
+  } else {
+    Node* node = node_;
+    size_type position = 0;
+    while (node != nullptr && position == 0) {
+      position = node->position;
+      node = node->parent;
+    }
+    if (node == nullptr) {
+      throw std::out_of_range("Iterator moved before the first element.");
+    }
+    node_ = node;
+    position_ = position - 1;
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::ConstIterator
+BTree<Key, Compare, Allocator, Policy>::ConstIterator::operator--(int) {
+  ConstIterator temp = *this;
+  --(*this);
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::reference
+BTree<Key, Compare, Allocator, Policy>::Iterator::operator*() const {
+  if (this->node_ == nullptr) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return *this->node_->slot(this->position_);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::pointer
+BTree<Key, Compare, Allocator, Policy>::Iterator::operator->() const {
+  return &**this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Iterator&
+BTree<Key, Compare, Allocator, Policy>::Iterator::operator++() {
+  ConstIterator::operator++();
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Iterator
+BTree<Key, Compare, Allocator, Policy>::Iterator::operator++(int) {
+  Iterator temp = *this;
+  ++(*this);
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Iterator&
+BTree<Key, Compare, Allocator, Policy>::Iterator::operator--() {
+  ConstIterator::operator--();
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Iterator
+BTree<Key, Compare, Allocator, Policy>::Iterator::operator--(int) {
+  Iterator temp = *this;
+  --(*this);
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::begin() {
+  if (root_ == nullptr) {
+    return end();
+  }
+  return iterator(this, leftmost_leaf(root_), 0);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::end() {
+  return iterator(this, nullptr, 0);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::const_iterator
+BTree<Key, Compare, Allocator, Policy>::cbegin() {
+  return begin();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::const_iterator
+BTree<Key, Compare, Allocator, Policy>::cend() {
+  return end();
+}
+
+/////////////////////////////////////
+////////    CONSTRUCTORS    /////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>::BTree() : BTree(Compare()) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>::BTree(const Compare& comp,
+                                              const Allocator& alloc)
+    : alloc_(alloc), comp_(comp) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>::BTree(const BTree& other)
+    : size_(other.size_),
+      alloc_(SlotTraits::select_on_container_copy_construction(other.alloc_)),
+      comp_(other.comp_) {
+  if (other.root_ != nullptr) {
+    root_ = copy_tree(other.root_, nullptr);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>::BTree(BTree&& other) noexcept
+    : root_(other.root_),
+      size_(other.size_),
+      alloc_(std::move(other.alloc_)),
+      comp_(other.comp_) {
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>&
+BTree<Key, Compare, Allocator, Policy>::operator=(BTree&& other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+BTree<Key, Compare, Allocator, Policy>::~BTree() {
+  destroy_tree(root_);
+}
+
+/////////////////////////////////////
+///////////    NODES    /////////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::InternalNode*
+BTree<Key, Compare, Allocator, Policy>::internal(Node* node) {
+  return static_cast<InternalNode*>(node);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Node*
+BTree<Key, Compare, Allocator, Policy>::child(Node* node, size_type i) {
+  return internal(node)->children[i];
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::set_child(Node* node,
+                                                       size_type i,
+                                                       Node* child) {
+  internal(node)->children[i] = child;
+  child->parent = node;
+  child->position = static_cast<unsigned char>(i);
+}
+
+// Leaves are allocated without the children array
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Node*
+BTree<Key, Compare, Allocator, Policy>::new_node(bool leaf) {
+  Node* node;
+  if (leaf) {
+    LeafAllocator alloc(alloc_);
+    node = ::new (std::allocator_traits<LeafAllocator>::allocate(alloc, 1))
+        Node;
+  } else {
+    InternalAllocator alloc(alloc_);
+    node = ::new (std::allocator_traits<InternalAllocator>::allocate(alloc, 1))
+        InternalNode;
+  }
+  node->parent = nullptr;
+  node->position = 0;
+  node->count = 0;
+  node->leaf = leaf;
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::delete_node(Node* node) {
+  if (node->leaf) {
+    LeafAllocator alloc(alloc_);
+    std::allocator_traits<LeafAllocator>::deallocate(alloc, node, 1);
+  } else {
+    InternalAllocator alloc(alloc_);
+    std::allocator_traits<InternalAllocator>::deallocate(alloc,
+                                                         internal(node), 1);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::destroy_tree(Node* node) {
+  if (node == nullptr) {
+    return;
+  }
+  for (size_type i = 0; i < node->count; ++i) {
+    SlotTraits::destroy(alloc_, node->slot(i));
+  }
+  if (!node->leaf) {
+    for (size_type i = 0; i <= node->count; ++i) {
+      destroy_tree(child(node, i));
+    }
+  }
+  delete_node(node);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Node*
+BTree<Key, Compare, Allocator, Policy>::copy_tree(Node* other, Node* parent) {
+  Node* node = new_node(other->leaf);
+  node->parent = parent;
+  node->position = other->position;
+  for (; node->count < other->count; ++node->count) {
+    construct_slot(node, node->count, *other->slot(node->count));
+  }
+  if (!node->leaf) {
+    for (size_type i = 0; i <= node->count; ++i) {
+      set_child(node, i, copy_tree(child(other, i), node));
+    }
+  }
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename... Args>
+void BTree<Key, Compare, Allocator, Policy>::construct_slot(Node* node,
+                                                            size_type i,
+                                                            Args&&... args) {
+  SlotTraits::construct(alloc_, node->slot(i), std::forward<Args>(args)...);
+}
+
+// Moves a value into an unconstructed slot and destroys the source
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::transfer(Node* dest, size_type i,
+                                                      Node* src, size_type j) {
+  SlotTraits::construct(alloc_, dest->slot(i), std::move(*src->slot(j)));
+  SlotTraits::destroy(alloc_, src->slot(j));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Node*
+BTree<Key, Compare, Allocator, Policy>::leftmost_leaf(Node* node) {
+  while (!node->leaf) {
+    node = child(node, 0);
+  }
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::Node*
+BTree<Key, Compare, Allocator, Policy>::rightmost_leaf(Node* node) {
+  while (!node->leaf) {
+    node = child(node, node->count);
+  }
+  return node;
+}
+
+/////////////////////////////////////
+//////////    SEARCH    /////////////
+/////////////////////////////////////
+
+// Index of the first key in node that is not less than key
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename BTree<Key, Compare, Allocator, Policy>::size_type
+BTree<Key, Compare, Allocator, Policy>::lower_index(Node* node,
+                                                    const K& key) const {
+  size_type lo = 0;
+  size_type hi = node->count;
+  while (lo < hi) {
+    size_type mid = (lo + hi) / 2;
+    if (comp_(node->key(mid), key)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Index of the first key in node that is greater than key
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename BTree<Key, Compare, Allocator, Policy>::size_type
+BTree<Key, Compare, Allocator, Policy>::upper_index(Node* node,
+                                                    const K& key) const {
+  size_type lo = 0;
+  size_type hi = node->count;
+  while (lo < hi) {
+    size_type mid = (lo + hi) / 2;
+    if (comp_(key, node->key(mid))) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::find_position(const K& key) {
+  for (Node* node = root_; node != nullptr;) {
+    size_type i = lower_index(node, key);
+    if (i < node->count && !comp_(key, node->key(i))) {
+      return iterator(this, node, i);
+    }
+    if (node->leaf) {
+      break;
+    }
+    node = child(node, i);
+  }
+  return end();
+}
+
+/////////////////////////////////////
+/////////    INSERTION    ///////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::insert_slot(Node* node, size_type pos,
+                                                    slot_type&& value,
+                                                    Node* child) {
+  if (node->count == kSlots) {
+    split_node(node, pos);
+  }
+  for (size_type i = node->count; i > pos; --i) {
+    transfer(node, i, node, i - 1);
+    if (!node->leaf) {
+      set_child(node, i + 1, BTree::child(node, i));
+    }
+  }
+  construct_slot(node, pos, std::move(value));
+  if (!node->leaf) {
+    set_child(node, pos + 1, child);
+  }
+  ++node->count;
+  return iterator(this, node, pos);
+}
+
+// Moves the upper half of a full node to a new right sibling and the middle
+// value up to the parent, which may split in turn. node and pos are updated
+// to where the value meant for pos goes now.
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::split_node(Node*& node,
+                                                        size_type& pos) {
+  if (node->parent == nullptr) {
+    root_ = new_node(false);
+    set_child(root_, 0, node);
+  }
+
+  Node* sibling = new_node(node->leaf);
+  size_type keep = kSlots / 2;
+  for (size_type i = keep + 1; i < node->count; ++i) {
+    transfer(sibling, i - keep - 1, node, i);
+  }
+  if (!node->leaf) {
+    for (size_type i = keep + 1; i <= node->count; ++i) {
+      set_child(sibling, i - keep - 1, child(node, i));
+    }
+  }
+  sibling->count = static_cast<unsigned char>(node->count - keep - 1);
+
+  slot_type middle(std::move(*node->slot(keep)));
+  SlotTraits::destroy(alloc_, node->slot(keep));
+  node->count = static_cast<unsigned char>(keep);
+  insert_slot(node->parent, node->position, std::move(middle), sibling);
+
+  if (pos > keep) {
+    node = sibling;
+    pos -= keep + 1;
+  }
+}
+
+// The value is built before anything moves, args may refer into the tree
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename... Args>
+std::pair<typename BTree<Key, Compare, Allocator, Policy>::iterator, bool>
+BTree<Key, Compare, Allocator, Policy>::emplace_unique(const K& key,
+                                                       Args&&... args) {
+  Node* node = root_;
+  size_type pos = 0;
+  while (node != nullptr) {
+    pos = lower_index(node, key);
+    if (pos < node->count && !comp_(key, node->key(pos))) {
+      return {iterator(this, node, pos), false};
+    }
+    if (node->leaf) {
+      break;
+    }
+    node = child(node, pos);
+  }
+
+  slot_type value(std::forward<Args>(args)...);
+  if (node == nullptr) {
+    node = root_ = new_node(true);
+  }
+  iterator it = insert_slot(node, pos, std::move(value), nullptr);
+  ++size_;
+  return {it, true};
+}
+
+// The slot right before an internal value is the end of its left subtree
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename... Args>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::insert_before(const_iterator pos,
+                                                      Args&&... args) {
+  slot_type value(std::forward<Args>(args)...);
+  Node* node = pos.node_;
+  size_type i = pos.position_;
+  if (node == nullptr) {
+    if (root_ == nullptr) {
+      root_ = new_node(true);
+    }
+    node = rightmost_leaf(root_);
+    i = node->count;
+  } else if (!node->leaf) {
+    node = rightmost_leaf(child(node, i));
+    i = node->count;
+  }
+  iterator it = insert_slot(node, i, std::move(value), nullptr);
+  ++size_;
+  return it;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename... Args>
+std::pair<typename BTree<Key, Compare, Allocator, Policy>::iterator, bool>
+BTree<Key, Compare, Allocator, Policy>::insert_hint_unique(const_iterator hint,
+                                                           const K& key,
+                                                           Args&&... args) {
+  if (hint.node_ == nullptr || comp_(key, Policy::key(*hint))) {
+    if (hint == begin()) {
+      return {insert_before(hint, std::forward<Args>(args)...), true};
+    }
+    const_iterator prev = hint;
+    --prev;
+    if (comp_(Policy::key(*prev), key)) {
+      return {insert_before(hint, std::forward<Args>(args)...), true};
+    }
+  }
+  return emplace_unique(key, std::forward<Args>(args)...);
+}
+
+/////////////////////////////////////
+//////////    ERASURE    ////////////
+/////////////////////////////////////
+
+// A value of an internal node is replaced by its successor, the first value
+// of a leaf, so the removal itself always happens in a leaf
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::erase_position(const_iterator pos) {
+  Node* node = pos.node_;
+  size_type i = pos.position_;
+  iterator it(this, node, i);
+
+  SlotTraits::destroy(alloc_, node->slot(i));
+  if (!node->leaf) {
+    Node* leaf = leftmost_leaf(child(node, i + 1));
+    transfer(node, i, leaf, 0);
+    node = leaf;
+    i = 0;
+  }
+  for (size_type j = i + 1; j < node->count; ++j) {
+    transfer(node, j - 1, node, j);
+  }
+  --node->count;
+  --size_;
+
+  rebalance_after_erase(node, it);
+  while (it.node_ != nullptr && it.position_ == it.node_->count) {
+    it.position_ = it.node_->position;
+    it.node_ = it.node_->parent;
+  }
+  if (it.node_ == nullptr) {
+    it.position_ = 0;
+  }
+  return it;
+}
+
+// Refills a node below kMinSlots from a sibling with values to spare, or
+// merges it with a sibling and goes on with the parent
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::rebalance_after_erase(
+    Node* node, iterator& it) {
+  while (node != root_ && node->count < kMinSlots) {
+    Node* parent = node->parent;
+    size_type i = node->position;
+    Node* left = i > 0 ? child(parent, i - 1) : nullptr;
+    Node* right = i < parent->count ? child(parent, i + 1) : nullptr;
+    if (left != nullptr && left->count > kMinSlots) {
+      rotate_right(parent, i - 1, it);
+      return;
+    }
+    if (right != nullptr && right->count > kMinSlots) {
+      rotate_left(parent, i, it);
+      return;
+    }
+    merge_children(parent, left != nullptr ? i - 1 : i, it);
+    node = parent;
+  }
+
+  if (root_->count == 0) {
+    Node* old_root = root_;
+    if (old_root->leaf) {
+      root_ = nullptr;
+      it = end();
+    } else {
+      root_ = child(old_root, 0);
+      root_->parent = nullptr;
+      root_->position = 0;
+    }
+    delete_node(old_root);
+  }
+}
+
+// The last value of child i goes up to the parent, the parent's value down
+// to the front of child i + 1
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::rotate_right(Node* parent,
+                                                          size_type i,
+                                                          iterator& it) {
+  Node* left = child(parent, i);
+  Node* right = child(parent, i + 1);
+  if (it.node_ == right) {
+    ++it.position_;
+  } else if (it.node_ == parent && it.position_ == i) {
+    it.node_ = right;
+    it.position_ = 0;
+  }
+
+  for (size_type j = right->count; j > 0; --j) {
+    transfer(right, j, right, j - 1);
+  }
+  transfer(right, 0, parent, i);
+  transfer(parent, i, left, left->count - 1);
+  if (!right->leaf) {
+    for (size_type j = right->count + 1; j > 0; --j) {
+      set_child(right, j, child(right, j - 1));
+    }
+    set_child(right, 0, child(left, left->count));
+  }
+  --left->count;
+  ++right->count;
+}
+
+// The first value of child i + 1 goes up to the parent, the parent's value
+// down to the end of child i
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::rotate_left(Node* parent,
+                                                         size_type i,
+                                                         iterator& it) {
+  Node* left = child(parent, i);
+  Node* right = child(parent, i + 1);
+  if (it.node_ == parent && it.position_ == i) {
+    it.node_ = left;
+    it.position_ = left->count;
+  }
+
+  transfer(left, left->count, parent, i);
+  transfer(parent, i, right, 0);
+  for (size_type j = 1; j < right->count; ++j) {
+    transfer(right, j - 1, right, j);
+  }
+  if (!left->leaf) {
+    set_child(left, left->count + 1, child(right, 0));
+    for (size_type j = 1; j <= right->count; ++j) {
+      set_child(right, j - 1, child(right, j));
+    }
+  }
+  ++left->count;
+  --right->count;
+}
+
+// Child i, the parent's value i and child i + 1 become one node
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::merge_children(Node* parent,
+                                                            size_type i,
+                                                            iterator& it) {
+  Node* left = child(parent, i);
+  Node* right = child(parent, i + 1);
+  if (it.node_ == right) {
+    it.node_ = left;
+    it.position_ += left->count + 1;
+  } else if (it.node_ == parent && it.position_ == i) {
+    it.node_ = left;
+    it.position_ = left->count;
+  } else if (it.node_ == parent && it.position_ > i) {
+    --it.position_;
+  }
+
+  size_type offset = left->count + 1;
+  transfer(left, left->count, parent, i);
+  for (size_type j = 0; j < right->count; ++j) {
+    transfer(left, offset + j, right, j);
+  }
+  if (!left->leaf) {
+    for (size_type j = 0; j <= right->count; ++j) {
+      set_child(left, offset + j, child(right, j));
+    }
+  }
+  left->count = static_cast<unsigned char>(offset + right->count);
+
+  for (size_type j = i + 1; j < parent->count; ++j) {
+    transfer(parent, j - 1, parent, j);
+    set_child(parent, j, child(parent, j + 1));
+  }
+  --parent->count;
+  delete_node(right);
+}
+
+/////////////////////////////////////
+////////    PUBLIC METHODS    ///////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool BTree<Key, Compare, Allocator, Policy>::empty() const {
+  return size_ == 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::size_type
+BTree<Key, Compare, Allocator, Policy>::size() const {
+  return size_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::size_type
+BTree<Key, Compare, Allocator, Policy>::max_size() const {
+  return std::numeric_limits<size_type>::max() / sizeof(slot_type);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::clear() {
+  destroy_tree(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::erase(iterator pos) {
+  if (pos.node_ == nullptr) {
+    return end();
+  }
+  return erase_position(pos);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::erase(iterator first, iterator last) {
+  size_type count = 0;
+  for (iterator it = first; it != last; ++it) {
+    ++count;
+  }
+  for (; count > 0; --count) {
+    first = erase_position(first);
+  }
+  return first;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::size_type
+BTree<Key, Compare, Allocator, Policy>::erase(const Key& key) {
+  iterator pos = find_position(key);
+  if (pos == end()) {
+    return 0;
+  }
+  erase_position(pos);
+  return 1;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::swap(BTree& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void BTree<Key, Compare, Allocator, Policy>::merge(BTree& other) {
+  if (this == &other) {
+    return;
+  }
+  for (iterator it = other.begin(); it != other.end();) {
+    slot_type& slot = *it.node_->slot(it.position_);
+    if (emplace_unique(Policy::key(slot), std::move(slot)).second) {
+      it = other.erase_position(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool BTree<Key, Compare, Allocator, Policy>::contains(const Key& key) {
+  return find_position(key) != end();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename C, typename>
+bool BTree<Key, Compare, Allocator, Policy>::contains(const K& key) {
+  return find_position(key) != end();
+}
+
+// Candidates found deeper are smaller, the last one is the bound
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::lower_bound(const Key& key) {
+  iterator result = end();
+  for (Node* node = root_; node != nullptr;) {
+    size_type i = lower_index(node, key);
+    if (i < node->count) {
+      result = iterator(this, node, i);
+    }
+    node = node->leaf ? nullptr : child(node, i);
+  }
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::iterator
+BTree<Key, Compare, Allocator, Policy>::upper_bound(const Key& key) {
+  iterator result = end();
+  for (Node* node = root_; node != nullptr;) {
+    size_type i = upper_index(node, key);
+    if (i < node->count) {
+      result = iterator(this, node, i);
+    }
+    node = node->leaf ? nullptr : child(node, i);
+  }
+  return result;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+std::pair<typename BTree<Key, Compare, Allocator, Policy>::iterator,
+          typename BTree<Key, Compare, Allocator, Policy>::iterator>
+BTree<Key, Compare, Allocator, Policy>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::key_compare
+BTree<Key, Compare, Allocator, Policy>::key_comp() const {
+  return comp_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename BTree<Key, Compare, Allocator, Policy>::allocator_type
+BTree<Key, Compare, Allocator, Policy>::get_allocator() const {
+  return allocator_type(alloc_);
+}
+
+}  // namespace s21
+
+#endif
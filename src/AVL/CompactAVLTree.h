@@ -0,0 +1,184 @@
+#ifndef S21_COMPACT_AVL_TREE_H
+#define S21_COMPACT_AVL_TREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "NodePolicy.h"
+
+namespace s21 {
+
+// AVL tree whose nodes live in two parallel arrays: the links, addressed by
+// 32-bit indices, and the stored values. A node costs 16 bytes of links plus
+// its value, e.g. 24 bytes for set<uint64_t> and 48 for set<std::string>,
+// against 40 and 64 in AVLTree, and the links of a whole search path share
+// far fewer cache lines. There are no subtree counts, so no order
+// statistics.
+//
+// Erased slots are chained into a freelist and reused. Iterators are
+// indices, they stay valid until their own element is erased; references
+// and pointers to values are invalidated when the arrays grow, see
+// reserve().
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+class CompactAVLTree {
+ public:
+  using key_type = Key;
+  using value_type = typename Policy::value_type;
+  using reference = typename Policy::reference;
+  using const_reference = const value_type&;
+  using pointer = typename Policy::pointer;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using index_type = std::uint32_t;
+
+  // Stands for a missing child or parent and for end()
+  static constexpr index_type kNull = ~index_type(0);
+
+ protected:
+  // Free slots have height 0 and are chained through left
+  struct Links {
+    index_type left;
+    index_type right;
+    index_type parent;
+    std::int32_t height;
+  };
+
+  using ValueAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<value_type>;
+  using ValueTraits = std::allocator_traits<ValueAllocator>;
+  using LinksAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Links>;
+
+  std::vector<Links, LinksAllocator> links_;
+  value_type* values_ = nullptr;
+  size_type capacity_ = 0;
+  ValueAllocator alloc_;
+  index_type root_ = kNull;
+  index_type free_ = kNull;
+  size_type size_ = 0;
+  Compare comp_;
+
+ public:
+  class ConstIterator {
+    friend class CompactAVLTree;
+
+   protected:
+    CompactAVLTree* tree_;
+    index_type index_;
+
+   public:
+    ConstIterator() noexcept;
+    ConstIterator(CompactAVLTree* tree, index_type index) noexcept;
+
+    bool operator==(const ConstIterator& other) const;
+    bool operator!=(const ConstIterator& other) const;
+    const_reference operator*() const;
+    const value_type* operator->() const;
+    ConstIterator& operator++();
+    ConstIterator operator++(int);
+    ConstIterator& operator--();
+    ConstIterator operator--(int);
+
+    // kNull for end()
+    index_type index() const;
+  };
+
+  class Iterator : public ConstIterator {
+   public:
+    Iterator() noexcept : ConstIterator() {}
+    Iterator(CompactAVLTree* tree, index_type index) noexcept
+        : ConstIterator(tree, index) {}
+    reference operator*() const;
+    pointer operator->() const;
+    Iterator& operator++();
+    Iterator operator++(int);
+    Iterator& operator--();
+    Iterator operator--(int);
+  };
+
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  iterator begin();
+  iterator end();
+  const_iterator cbegin();
+  const_iterator cend();
+
+  // Constructors
+  CompactAVLTree();
+  explicit CompactAVLTree(const Compare& comp,
+                          const Allocator& alloc = Allocator());
+  CompactAVLTree(const CompactAVLTree& other);
+  CompactAVLTree(CompactAVLTree&& other) noexcept;
+  CompactAVLTree& operator=(CompactAVLTree&& other) noexcept;
+  ~CompactAVLTree();
+
+ protected:
+  int height_of(index_type node) const;
+  void update_height(index_type node);
+  int balance_factor(index_type node) const;
+  index_type min_index(index_type node) const;
+  index_type max_index(index_type node) const;
+  index_type next_index(index_type node) const;
+  index_type prev_index(index_type node) const;
+  template <typename K>
+  index_type find_index(const K& key) const;
+  template <typename K>
+  index_type lower_bound_index(const K& key) const;
+  template <typename K>
+  index_type upper_bound_index(const K& key) const;
+  void replace_child(index_type old_child, index_type new_child);
+  index_type left_rotate(index_type node);
+  index_type right_rotate(index_type node);
+  index_type balance_node(index_type node);
+  void rebalance_path(index_type node);
+  void grow(size_type capacity);
+  void relocate(value_type* values, size_type capacity);
+  template <typename... Args>
+  index_type create_slot(Args&&... args);
+  void erase_index(index_type node);
+  // key is only looked up, args construct the stored value if it is missing
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(const K& key, Args&&... args);
+  void destroy_values();
+
+ public:
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  size_type capacity() const;
+  // Grows the arrays once instead of doubling them on the way
+  void reserve(size_type count);
+
+  // Modifiers
+  void clear();
+  void erase(iterator pos);
+  size_type erase(const Key& key);
+  void swap(CompactAVLTree& other) noexcept;
+
+  // Lookup
+  bool contains(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const;
+  iterator lower_bound(const Key& key);
+  iterator upper_bound(const Key& key);
+  std::pair<iterator, iterator> equal_range(const Key& key);
+
+  // Observers
+  key_compare key_comp() const;
+  allocator_type get_allocator() const;
+};
+
+}  // namespace s21
+
+#include "CompactAVLTree.tpp"
+
+#endif
@@ -0,0 +1,739 @@
+#ifndef S21_COMPACT_AVL_TREE_TPP
+#define S21_COMPACT_AVL_TREE_TPP
+
+#include "CompactAVLTree.h"
+
+namespace s21 {
+
+/////////////////////////////////////
+/////////    ITERATORS    ///////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::ConstIterator()
+    noexcept
+    : tree_(nullptr), index_(kNull) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::ConstIterator(
+    CompactAVLTree* tree, index_type index) noexcept
+    : tree_(tree), index_(index) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator==(
+    const ConstIterator& other) const {
+  return index_ == other.index_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator!=(
+    const ConstIterator& other) const {
+  return index_ != other.index_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::const_reference
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator*()
+    const {
+  if (tree_ == nullptr || index_ == kNull) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return tree_->values_[index_];
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+const typename CompactAVLTree<Key, Compare, Allocator, Policy>::value_type*
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator->()
+    const {
+  return &**this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator&
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator++() {
+  if (tree_ == nullptr || index_ == kNull) {
+    throw std::out_of_range("Iterator is out of bounds[operator ++]");
+  }
+  index_ = tree_->next_index(index_);
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator++(
+    int) {
+  ConstIterator temp = *this;
+  ++(*this);
+  return temp;
+}
+
+// end() steps back to the largest element
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator&
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator--() {
+  if (tree_ == nullptr || tree_->root_ == kNull) {
+    throw std::out_of_range("Cannot decrement iterator in an empty tree.");
+  }
+  index_type prev = index_ == kNull ? tree_->max_index(tree_->root_)
+                                    : tree_->prev_index(index_);
+  if (prev == kNull) {
+    throw std::out_of_range("Iterator moved before the first element.");
+  }
+  index_ = prev;
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator--(
+    int) {
+  ConstIterator temp = *this;
+  --(*this);
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::index() const {
+  return index_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::reference
+CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator::operator*() const {
+  if (this->tree_ == nullptr || this->index_ == kNull) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return this->tree_->values_[this->index_];
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::pointer
+CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator::operator->() const {
+  return &**this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator&
+CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator::operator++() {
+  ConstIterator::operator++();
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator::operator++(int) {
+  Iterator temp = *this;
+  ++(*this);
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator&
+CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator::operator--() {
+  ConstIterator::operator--();
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::Iterator::operator--(int) {
+  Iterator temp = *this;
+  --(*this);
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::begin() {
+  return iterator(this, root_ == kNull ? kNull : min_index(root_));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::end() {
+  return iterator(this, kNull);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::cbegin() {
+  return begin();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::cend() {
+  return end();
+}
+
+/////////////////////////////////////
+////////    CONSTRUCTORS    /////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>::CompactAVLTree()
+    : CompactAVLTree(Compare()) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>::CompactAVLTree(
+    const Compare& comp, const Allocator& alloc)
+    : links_(LinksAllocator(alloc)), alloc_(alloc), comp_(comp) {}
+
+// The arrays are copied slot by slot, so the copy has the same shape and
+// the same free slots
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>::CompactAVLTree(
+    const CompactAVLTree& other)
+    : links_(other.links_),
+      alloc_(ValueTraits::select_on_container_copy_construction(other.alloc_)),
+      root_(other.root_),
+      free_(other.free_),
+      size_(other.size_),
+      comp_(other.comp_) {
+  if (links_.empty()) {
+    return;
+  }
+  values_ = ValueTraits::allocate(alloc_, links_.size());
+  capacity_ = links_.size();
+  index_type copied = 0;
+  try {
+    for (; copied < links_.size(); ++copied) {
+      if (links_[copied].height != 0) {
+        ValueTraits::construct(alloc_, values_ + copied,
+                               other.values_[copied]);
+      }
+    }
+  } catch (...) {
+    links_.resize(copied);
+    destroy_values();
+    throw;
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>::CompactAVLTree(
+    CompactAVLTree&& other) noexcept
+    : CompactAVLTree(other.comp_, other.alloc_) {
+  swap(other);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>&
+CompactAVLTree<Key, Compare, Allocator, Policy>::operator=(
+    CompactAVLTree&& other) noexcept {
+  if (this != &other) {
+    clear();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+CompactAVLTree<Key, Compare, Allocator, Policy>::~CompactAVLTree() {
+  destroy_values();
+}
+
+/////////////////////////////////////
+/////////    NAVIGATION    //////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+int CompactAVLTree<Key, Compare, Allocator, Policy>::height_of(
+    index_type node) const {
+  return node != kNull ? links_[node].height : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::update_height(
+    index_type node) {
+  links_[node].height =
+      std::max(height_of(links_[node].left), height_of(links_[node].right)) +
+      1;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+int CompactAVLTree<Key, Compare, Allocator, Policy>::balance_factor(
+    index_type node) const {
+  return height_of(links_[node].left) - height_of(links_[node].right);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::min_index(
+    index_type node) const {
+  while (links_[node].left != kNull) {
+    node = links_[node].left;
+  }
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::max_index(
+    index_type node) const {
+  while (links_[node].right != kNull) {
+    node = links_[node].right;
+  }
+  return node;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::next_index(
+    index_type node) const {
+  if (links_[node].right != kNull) {
+    return min_index(links_[node].right);
+  }
+  index_type parent = links_[node].parent;
+  while (parent != kNull && links_[parent].right == node) {
+    node = parent;
+    parent = links_[node].parent;
+  }
+  return parent;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::prev_index(
+    index_type node) const {
+  if (links_[node].left != kNull) {
+    return max_index(links_[node].left);
+  }
+  index_type parent = links_[node].parent;
+  while (parent != kNull && links_[parent].left == node) {
+    node = parent;
+    parent = links_[node].parent;
+  }
+  return parent;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::find_index(
+    const K& key) const {
+  index_type node = root_;
+  while (node != kNull) {
+    const Key& node_key = Policy::key(values_[node]);
+    if (comp_(key, node_key)) {
+      node = links_[node].left;
+    } else if (comp_(node_key, key)) {
+      node = links_[node].right;
+    } else {
+      break;
+    }
+  }
+  return node;
+}
+
+// First node whose key is not less than key, kNull if there is none
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::lower_bound_index(
+    const K& key) const {
+  index_type result = kNull;
+  index_type node = root_;
+  while (node != kNull) {
+    if (comp_(Policy::key(values_[node]), key)) {
+      node = links_[node].right;
+    } else {
+      result = node;
+      node = links_[node].left;
+    }
+  }
+  return result;
+}
+
+// First node whose key is greater than key, kNull if there is none
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::upper_bound_index(
+    const K& key) const {
+  index_type result = kNull;
+  index_type node = root_;
+  while (node != kNull) {
+    if (comp_(key, Policy::key(values_[node]))) {
+      result = node;
+      node = links_[node].left;
+    } else {
+      node = links_[node].right;
+    }
+  }
+  return result;
+}
+
+/////////////////////////////////////
+/////////    BALANCING    ///////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::replace_child(
+    index_type old_child, index_type new_child) {
+  index_type parent = links_[old_child].parent;
+  if (parent == kNull) {
+    root_ = new_child;
+  } else if (links_[parent].left == old_child) {
+    links_[parent].left = new_child;
+  } else {
+    links_[parent].right = new_child;
+  }
+  if (new_child != kNull) {
+    links_[new_child].parent = parent;
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::left_rotate(
+    index_type node) {
+  index_type pivot = links_[node].right;
+  replace_child(node, pivot);
+
+  links_[node].right = links_[pivot].left;
+  if (links_[pivot].left != kNull) {
+    links_[links_[pivot].left].parent = node;
+  }
+  links_[pivot].left = node;
+  links_[node].parent = pivot;
+
+  update_height(node);
+  update_height(pivot);
+  return pivot;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::right_rotate(
+    index_type node) {
+  index_type pivot = links_[node].left;
+  replace_child(node, pivot);
+
+  links_[node].left = links_[pivot].right;
+  if (links_[pivot].right != kNull) {
+    links_[links_[pivot].right].parent = node;
+  }
+  links_[pivot].right = node;
+  links_[node].parent = pivot;
+
+  update_height(node);
+  update_height(pivot);
+  return pivot;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::balance_node(
+    index_type node) {
+  update_height(node);
+  int balance = balance_factor(node);
+
+  if (balance > 1) {
+    if (balance_factor(links_[node].left) < 0) {
+      left_rotate(links_[node].left);
+    }
+    node = right_rotate(node);
+  } else if (balance < -1) {
+    if (balance_factor(links_[node].right) > 0) {
+      right_rotate(links_[node].right);
+    }
+    node = left_rotate(node);
+  }
+
+  return node;
+}
+
+// Stops as soon as a subtree keeps its height, nothing above can change
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::rebalance_path(
+    index_type node) {
+  while (node != kNull) {
+    int old_height = links_[node].height;
+    node = balance_node(node);
+    if (links_[node].height == old_height) {
+      break;
+    }
+    node = links_[node].parent;
+  }
+}
+
+/////////////////////////////////////
+//////////    STORAGE    ////////////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::grow(
+    size_type capacity) {
+  if (capacity > max_size()) {
+    throw std::length_error("CompactAVLTree is limited to 2^32 - 1 nodes");
+  }
+  links_.reserve(capacity);
+  relocate(ValueTraits::allocate(alloc_, capacity), capacity);
+}
+
+// Live values are moved to the new array, free slots are left unconstructed
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::relocate(
+    value_type* values, size_type capacity) {
+  for (size_type i = 0; i < links_.size(); ++i) {
+    if (links_[i].height != 0) {
+      ValueTraits::construct(alloc_, values + i, std::move(values_[i]));
+      ValueTraits::destroy(alloc_, values_ + i);
+    }
+  }
+  if (values_ != nullptr) {
+    ValueTraits::deallocate(alloc_, values_, capacity_);
+  }
+  values_ = values;
+  capacity_ = capacity;
+}
+
+// Takes the most recently freed slot, or appends one. When the arrays are
+// full the new value is built in the grown array before the old one is
+// released, args may refer to a value of this tree.
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename... Args>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::index_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::create_slot(
+    Args&&... args) {
+  index_type slot = free_;
+  if (slot != kNull) {
+    ValueTraits::construct(alloc_, values_ + slot,
+                           std::forward<Args>(args)...);
+    free_ = links_[slot].left;
+    links_[slot] = {kNull, kNull, kNull, 1};
+  } else {
+    slot = static_cast<index_type>(links_.size());
+    if (links_.size() == capacity_) {
+      if (capacity_ == max_size()) {
+        throw std::length_error("CompactAVLTree is limited to 2^32 - 1 nodes");
+      }
+      size_type capacity =
+          std::max<size_type>(16, std::min(2 * capacity_, max_size()));
+      links_.reserve(capacity);
+      value_type* values = ValueTraits::allocate(alloc_, capacity);
+      try {
+        ValueTraits::construct(alloc_, values + slot,
+                               std::forward<Args>(args)...);
+      } catch (...) {
+        ValueTraits::deallocate(alloc_, values, capacity);
+        throw;
+      }
+      relocate(values, capacity);
+    } else {
+      ValueTraits::construct(alloc_, values_ + slot,
+                             std::forward<Args>(args)...);
+    }
+    links_.push_back({kNull, kNull, kNull, 1});
+  }
+  size_++;
+  return slot;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename... Args>
+std::pair<typename CompactAVLTree<Key, Compare, Allocator, Policy>::iterator,
+          bool>
+CompactAVLTree<Key, Compare, Allocator, Policy>::emplace_unique(
+    const K& key, Args&&... args) {
+  index_type parent = kNull;
+  bool left = false;
+
+  for (index_type node = root_; node != kNull;) {
+    parent = node;
+    const Key& node_key = Policy::key(values_[node]);
+    if (comp_(key, node_key)) {
+      left = true;
+      node = links_[node].left;
+    } else if (comp_(node_key, key)) {
+      left = false;
+      node = links_[node].right;
+    } else {
+      return {iterator(this, node), false};
+    }
+  }
+
+  index_type slot = create_slot(std::forward<Args>(args)...);
+  links_[slot].parent = parent;
+  if (parent == kNull) {
+    root_ = slot;
+  } else {
+    (left ? links_[parent].left : links_[parent].right) = slot;
+    rebalance_path(parent);
+  }
+  return {iterator(this, slot), true};
+}
+
+// A node with two children is replaced by its successor, which is relinked
+// rather than moved, so no value changes its slot
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::erase_index(
+    index_type node) {
+  Links& links = links_[node];
+  index_type rebalance_from = links.parent;
+
+  if (links.left != kNull && links.right != kNull) {
+    index_type successor = min_index(links.right);
+    if (links_[successor].parent != node) {
+      rebalance_from = links_[successor].parent;
+      replace_child(successor, links_[successor].right);
+      links_[successor].right = links.right;
+      links_[links.right].parent = successor;
+    } else {
+      rebalance_from = successor;
+    }
+    links_[successor].left = links.left;
+    links_[links.left].parent = successor;
+    links_[successor].height = links.height;
+    replace_child(node, successor);
+  } else {
+    replace_child(node, links.left != kNull ? links.left : links.right);
+  }
+
+  ValueTraits::destroy(alloc_, values_ + node);
+  links = {free_, kNull, kNull, 0};
+  free_ = node;
+  size_--;
+  rebalance_path(rebalance_from);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::destroy_values() {
+  if (values_ == nullptr) {
+    return;
+  }
+  for (size_type i = 0; i < links_.size(); ++i) {
+    if (links_[i].height != 0) {
+      ValueTraits::destroy(alloc_, values_ + i);
+    }
+  }
+  ValueTraits::deallocate(alloc_, values_, capacity_);
+  values_ = nullptr;
+  capacity_ = 0;
+}
+
+/////////////////////////////////////
+////////    PUBLIC METHODS    ///////
+/////////////////////////////////////
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool CompactAVLTree<Key, Compare, Allocator, Policy>::empty() const {
+  return size_ == 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::size_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::size() const {
+  return size_;
+}
+
+// kNull is reserved, every other index may hold a node
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::size_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::max_size() const {
+  return kNull;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::size_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::capacity() const {
+  return capacity_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::reserve(
+    size_type count) {
+  if (count > capacity_) {
+    grow(count);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::clear() {
+  destroy_values();
+  std::vector<Links, LinksAllocator>(links_.get_allocator()).swap(links_);
+  root_ = kNull;
+  free_ = kNull;
+  size_ = 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::erase(iterator pos) {
+  if (pos.index() != kNull) {
+    erase_index(pos.index());
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::size_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::erase(const Key& key) {
+  index_type node = find_index(key);
+  if (node == kNull) {
+    return 0;
+  }
+  erase_index(node);
+  return 1;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void CompactAVLTree<Key, Compare, Allocator, Policy>::swap(
+    CompactAVLTree& other) noexcept {
+  links_.swap(other.links_);
+  std::swap(values_, other.values_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(root_, other.root_);
+  std::swap(free_, other.free_);
+  std::swap(size_, other.size_);
+  std::swap(comp_, other.comp_);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool CompactAVLTree<Key, Compare, Allocator, Policy>::contains(
+    const Key& key) const {
+  return find_index(key) != kNull;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename C, typename>
+bool CompactAVLTree<Key, Compare, Allocator, Policy>::contains(
+    const K& key) const {
+  return find_index(key) != kNull;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::lower_bound(const Key& key) {
+  return iterator(this, lower_bound_index(key));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::iterator
+CompactAVLTree<Key, Compare, Allocator, Policy>::upper_bound(const Key& key) {
+  return iterator(this, upper_bound_index(key));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+std::pair<typename CompactAVLTree<Key, Compare, Allocator, Policy>::iterator,
+          typename CompactAVLTree<Key, Compare, Allocator, Policy>::iterator>
+CompactAVLTree<Key, Compare, Allocator, Policy>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::key_compare
+CompactAVLTree<Key, Compare, Allocator, Policy>::key_comp() const {
+  return comp_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename CompactAVLTree<Key, Compare, Allocator, Policy>::allocator_type
+CompactAVLTree<Key, Compare, Allocator, Policy>::get_allocator() const {
+  return allocator_type(alloc_);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef S21_CONCURRENT_AVL_TREE_H
+#define S21_CONCURRENT_AVL_TREE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "EpochReclaimer.h"
+
+namespace s21 {
+
+// Relaxed-balance AVL tree for concurrent use after Bronson, Casper, Chafi
+// and Olukotun, "A Practical Concurrent Binary Search Tree" (PPoPP 2010).
+//
+// Searches take no locks. They descend hand over hand and validate every
+// step against the version of the node they came from; a rotation marks
+// the node that moves down as shrinking for its duration and bumps its
+// version afterwards, and a search that sees either backs up one level.
+// Writers lock the parent and the child they change, top down, and
+// rebalance bottom up one rotation at a time, each under the locks of the
+// nodes it touches.
+//
+// Erasing a key with two children only clears the value and leaves a
+// routing node, which is unlinked once it has at most one child. Values
+// live in separate immutable boxes so that a lock-free reader can copy
+// one. Unlinked nodes and replaced boxes are freed through an
+// EpochReclaimer once no reader can hold them.
+template <typename Key, typename T, typename Compare, typename Allocator>
+class ConcurrentAVLTree {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ protected:
+  // Bits of a node version, the rest counts finished shrinks
+  static constexpr std::uint64_t kUnlinked = 1;
+  static constexpr std::uint64_t kShrinking = 2;
+  static constexpr std::uint64_t kShrinkCountIncr = 4;
+  // A reader spins this often on a shrinking node before it waits for the
+  // node's lock
+  static constexpr int kSpinCount = 100;
+
+  // What a node needs besides a new height
+  static constexpr int kUnlinkRequired = -1;
+  static constexpr int kRebalanceRequired = -2;
+  static constexpr int kNothingRequired = -3;
+
+  // Yields at once, there may be more threads than cores
+  class SpinLock {
+   public:
+    void lock();
+    void unlock();
+
+   private:
+    std::atomic<bool> locked_{false};
+  };
+
+  struct Node;
+
+  // Links and lock, all that the root holder has
+  struct NodeBase {
+    std::atomic<Node*> left{nullptr};
+    std::atomic<Node*> right{nullptr};
+    std::atomic<NodeBase*> parent{nullptr};
+    std::atomic<std::uint64_t> version{0};
+    std::atomic<int> height{0};
+    SpinLock lock;
+
+    // dir < 0 is left, dir > 0 right
+    std::atomic<Node*>& child(int dir);
+  };
+
+  // A null value makes a routing node
+  struct Node : NodeBase {
+    const Key key;
+    std::atomic<T*> value;
+
+    Node(const Key& k, T* v, NodeBase* p);
+  };
+
+  struct alignas(64) Counter {
+    std::atomic<std::ptrdiff_t> value{0};
+  };
+
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+  using ValueAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+  using ValueTraits = std::allocator_traits<ValueAllocator>;
+  using Guard = EpochReclaimer::Guard;
+
+  // Its right child is the root
+  mutable NodeBase holder_;
+  mutable EpochReclaimer reclaimer_;
+  // Size changes per reclaimer slot, so writers do not share a counter
+  std::unique_ptr<Counter[]> counts_;
+  NodeAllocator node_alloc_;
+  ValueAllocator value_alloc_;
+  Compare comp_;
+
+ public:
+  // Constructors. The tree is not copyable, it is shared instead.
+  ConcurrentAVLTree();
+  explicit ConcurrentAVLTree(const Compare& comp,
+                             const Allocator& alloc = Allocator());
+  ConcurrentAVLTree(const ConcurrentAVLTree& other) = delete;
+  ConcurrentAVLTree& operator=(const ConcurrentAVLTree& other) = delete;
+  ~ConcurrentAVLTree();
+
+ protected:
+  static bool is_unlinked(std::uint64_t version);
+  static std::uint64_t begin_shrink(std::uint64_t version);
+  static std::uint64_t end_shrink(std::uint64_t version);
+  static int height_of(Node* node);
+  static void wait_until_not_changing(Node* node);
+  template <typename K>
+  int direction(const K& key, Node* node) const;
+
+  // Value boxes are built before they are published and retired after they
+  // are replaced
+  template <typename... Args>
+  T* create_value(Args&&... args);
+  void destroy_value(T* value);
+  void retire_value(Guard& guard, T* value);
+  static void delete_value(void* owner, void* object);
+  static void delete_node(void* owner, void* object);
+  void destroy_subtree(Node* node);
+  void add_size(Guard& guard, std::ptrdiff_t delta);
+
+  // Descends from node, reached with node_version, in direction dir.
+  // on_missing(parent, dir, parent_version) runs where key would hang and
+  // on_found(parent, node) on the node holding it; both return false to be
+  // retried. Returns false when the caller has to retry from its own node.
+  template <typename K, typename OnMissing, typename OnFound>
+  bool descend(const K& key, NodeBase* node, int dir,
+               std::uint64_t node_version, OnMissing& on_missing,
+               OnFound& on_found) const;
+  template <typename K, typename OnMissing, typename OnFound>
+  void search(const K& key, OnMissing on_missing, OnFound on_found) const;
+
+  // The box of key, or nullptr. Valid while guard lives.
+  template <typename K>
+  T* find_value(const K& key, Guard& guard) const;
+  // Links value under key, replacing the present box only with overwrite.
+  // Returns the box that was there; value is not consumed if that is not
+  // null and overwrite is false. If put throws before value is linked, for
+  // instance when the new node can not be allocated, value is destroyed.
+  T* put(const Key& key, T* value, bool overwrite, Guard& guard);
+  // Unlinks key, returns its box or nullptr
+  T* remove(const Key& key, Guard& guard);
+
+  bool attempt_insert(const Key& key, T* value, NodeBase* parent, int dir,
+                      std::uint64_t parent_version);
+  bool attempt_update(Node* node, T* value, bool overwrite, T*& previous);
+  bool attempt_remove_node(NodeBase* parent, Node* node, T*& previous,
+                           Guard& guard);
+  static bool can_unlink(Node* node);
+
+  // Bottom-up repair. The _nl functions expect the locks of their first
+  // nodes to be held and return the next node to repair, or nullptr.
+  void fix_height_and_rebalance(NodeBase* node, Guard& guard);
+  int node_condition(Node* node) const;
+  NodeBase* fix_height_nl(NodeBase* node);
+  NodeBase* rebalance_nl(NodeBase* parent, Node* node, Guard& guard);
+  bool attempt_unlink_nl(NodeBase* parent, Node* node);
+  NodeBase* rebalance_to_right_nl(NodeBase* parent, Node* node, Node* left,
+                                  int right_height, Guard& guard);
+  NodeBase* rebalance_to_left_nl(NodeBase* parent, Node* node, Node* right,
+                                 int left_height, Guard& guard);
+  NodeBase* rotate_right_nl(NodeBase* parent, Node* node, Node* left,
+                            int right_height, int left_left_height,
+                            Node* left_right, int left_right_height);
+  NodeBase* rotate_left_nl(NodeBase* parent, Node* node, Node* right,
+                           int left_height, int right_right_height,
+                           Node* right_left, int right_left_height);
+  NodeBase* rotate_right_over_left_nl(NodeBase* parent, Node* node,
+                                      Node* left, int right_height,
+                                      int left_left_height, Node* left_right,
+                                      int left_right_left_height,
+                                      Guard& guard);
+  NodeBase* rotate_left_over_right_nl(NodeBase* parent, Node* node,
+                                      Node* right, int left_height,
+                                      int right_right_height,
+                                      Node* right_left,
+                                      int right_left_right_height,
+                                      Guard& guard);
+
+ public:
+  // Capacity. size() adds up per-thread counts and may be off while other
+  // threads are modifying the tree.
+  bool empty() const;
+  size_type size() const;
+
+  // Modifiers. clear() must not run concurrently with anything else.
+  void clear();
+
+  // Observers
+  key_compare key_comp() const;
+  allocator_type get_allocator() const;
+};
+
+}  // namespace s21
+
+#include "ConcurrentAVLTree.tpp"
+
+#endif
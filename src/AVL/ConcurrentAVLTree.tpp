@@ -0,0 +1,871 @@
+#ifndef S21_CONCURRENT_AVL_TREE_TPP
+#define S21_CONCURRENT_AVL_TREE_TPP
+
+#include "ConcurrentAVLTree.h"
+
+namespace s21 {
+
+// SpinLock
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::SpinLock::lock() {
+  while (locked_.exchange(true, std::memory_order_acquire)) {
+    while (locked_.load(std::memory_order_relaxed)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::SpinLock::unlock() {
+  locked_.store(false, std::memory_order_release);
+}
+
+// Nodes
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::atomic<typename ConcurrentAVLTree<Key, T, Compare, Allocator>::Node*>&
+ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase::child(int dir) {
+  return dir < 0 ? left : right;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+ConcurrentAVLTree<Key, T, Compare, Allocator>::Node::Node(const Key& k, T* v,
+                                                          NodeBase* p)
+    : key(k), value(v) {
+  this->parent.store(p);
+  this->height.store(1);
+}
+
+// Constructors
+template <typename Key, typename T, typename Compare, typename Allocator>
+ConcurrentAVLTree<Key, T, Compare, Allocator>::ConcurrentAVLTree()
+    : counts_(new Counter[EpochReclaimer::kSlots]) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+ConcurrentAVLTree<Key, T, Compare, Allocator>::ConcurrentAVLTree(
+    const Compare& comp, const Allocator& alloc)
+    : counts_(new Counter[EpochReclaimer::kSlots]),
+      node_alloc_(alloc),
+      value_alloc_(alloc),
+      comp_(comp) {}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+ConcurrentAVLTree<Key, T, Compare, Allocator>::~ConcurrentAVLTree() {
+  clear();
+}
+
+// Helpers
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::is_unlinked(
+    std::uint64_t version) {
+  return (version & kUnlinked) != 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::uint64_t ConcurrentAVLTree<Key, T, Compare, Allocator>::begin_shrink(
+    std::uint64_t version) {
+  return version | kShrinking;
+}
+
+// version is the one from before begin_shrink
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::uint64_t ConcurrentAVLTree<Key, T, Compare, Allocator>::end_shrink(
+    std::uint64_t version) {
+  return version + kShrinkCountIncr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+int ConcurrentAVLTree<Key, T, Compare, Allocator>::height_of(Node* node) {
+  return node ? node->height.load() : 0;
+}
+
+// A shrink runs under the node's lock, so taking the lock waits it out
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::wait_until_not_changing(
+    Node* node) {
+  std::uint64_t version = node->version.load();
+  if ((version & kShrinking) != 0) {
+    int spins = 0;
+    while (node->version.load() == version && spins < kSpinCount) {
+      ++spins;
+    }
+    if (spins == kSpinCount) {
+      std::lock_guard<SpinLock> lock(node->lock);
+    }
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K>
+int ConcurrentAVLTree<Key, T, Compare, Allocator>::direction(
+    const K& key, Node* node) const {
+  if (comp_(key, node->key)) {
+    return -1;
+  }
+  return comp_(node->key, key) ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+T* ConcurrentAVLTree<Key, T, Compare, Allocator>::create_value(
+    Args&&... args) {
+  T* value = ValueTraits::allocate(value_alloc_, 1);
+  try {
+    ValueTraits::construct(value_alloc_, value, std::forward<Args>(args)...);
+  } catch (...) {
+    ValueTraits::deallocate(value_alloc_, value, 1);
+    throw;
+  }
+  return value;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::destroy_value(T* value) {
+  ValueTraits::destroy(value_alloc_, value);
+  ValueTraits::deallocate(value_alloc_, value, 1);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::retire_value(Guard& guard,
+                                                                 T* value) {
+  guard.retire(value, delete_value, this);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::delete_value(
+    void* owner, void* object) {
+  static_cast<ConcurrentAVLTree*>(owner)->destroy_value(
+      static_cast<T*>(object));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::delete_node(void* owner,
+                                                                void* object) {
+  ConcurrentAVLTree* tree = static_cast<ConcurrentAVLTree*>(owner);
+  Node* node = static_cast<Node*>(object);
+  NodeTraits::destroy(tree->node_alloc_, node);
+  NodeTraits::deallocate(tree->node_alloc_, node, 1);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::destroy_subtree(
+    Node* node) {
+  if (node) {
+    destroy_subtree(node->left.load());
+    destroy_subtree(node->right.load());
+    if (T* value = node->value.load()) {
+      destroy_value(value);
+    }
+    delete_node(this, node);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::add_size(
+    Guard& guard, std::ptrdiff_t delta) {
+  counts_[guard.slot()].value.fetch_add(delta, std::memory_order_relaxed);
+}
+
+// Search
+// A step is taken only if the child was linked under node while node still
+// had node_version; otherwise the step is retried, or the whole level when
+// node itself has moved
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename OnMissing, typename OnFound>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::descend(
+    const K& key, NodeBase* node, int dir, std::uint64_t node_version,
+    OnMissing& on_missing, OnFound& on_found) const {
+  while (true) {
+    Node* child = node->child(dir).load();
+    if (node->version.load() != node_version) {
+      return false;
+    }
+    if (child == nullptr) {
+      if (on_missing(node, dir, node_version)) {
+        return true;
+      }
+      continue;
+    }
+    int next_dir = direction(key, child);
+    if (next_dir == 0) {
+      if (on_found(node, child)) {
+        return true;
+      }
+      continue;
+    }
+    std::uint64_t child_version = child->version.load();
+    if ((child_version & kShrinking) != 0) {
+      wait_until_not_changing(child);
+    } else if (!is_unlinked(child_version) &&
+               child == node->child(dir).load()) {
+      if (node->version.load() != node_version) {
+        return false;
+      }
+      if (descend(key, child, next_dir, child_version, on_missing,
+                  on_found)) {
+        return true;
+      }
+    }
+  }
+}
+
+// The holder never shrinks, so the search always succeeds from there
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename OnMissing, typename OnFound>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::search(
+    const K& key, OnMissing on_missing, OnFound on_found) const {
+  while (!descend(key, &holder_, 1, holder_.version.load(), on_missing,
+                  on_found)) {
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K>
+T* ConcurrentAVLTree<Key, T, Compare, Allocator>::find_value(
+    const K& key, Guard&) const {
+  T* found = nullptr;
+  search(
+      key, [](NodeBase*, int, std::uint64_t) { return true; },
+      [&found](NodeBase*, Node* node) {
+        found = node->value.load();
+        return true;
+      });
+  return found;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+T* ConcurrentAVLTree<Key, T, Compare, Allocator>::put(const Key& key,
+                                                      T* value,
+                                                      bool overwrite,
+                                                      Guard& guard) {
+  T* previous = nullptr;
+  bool linked = false;
+  try {
+    search(
+        key,
+        [&](NodeBase* parent, int dir, std::uint64_t parent_version) {
+          if (!attempt_insert(key, value, parent, dir, parent_version)) {
+            return false;
+          }
+          linked = true;
+          fix_height_and_rebalance(parent, guard);
+          return true;
+        },
+        [&](NodeBase*, Node* node) {
+          return attempt_update(node, value, overwrite, previous);
+        });
+  } catch (...) {
+    // Once linked the box belongs to the tree, even if rebalancing threw
+    if (!linked) {
+      destroy_value(value);
+    }
+    throw;
+  }
+  if (previous == nullptr) {
+    add_size(guard, 1);
+  }
+  return previous;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+T* ConcurrentAVLTree<Key, T, Compare, Allocator>::remove(const Key& key,
+                                                         Guard& guard) {
+  T* previous = nullptr;
+  search(
+      key, [](NodeBase*, int, std::uint64_t) { return true; },
+      [&](NodeBase* parent, Node* node) {
+        return attempt_remove_node(parent, node, previous, guard);
+      });
+  if (previous != nullptr) {
+    add_size(guard, -1);
+  }
+  return previous;
+}
+
+// Updates
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::attempt_insert(
+    const Key& key, T* value, NodeBase* parent, int dir,
+    std::uint64_t parent_version) {
+  Node* node = NodeTraits::allocate(node_alloc_, 1);
+  try {
+    NodeTraits::construct(node_alloc_, node, key, value, parent);
+  } catch (...) {
+    NodeTraits::deallocate(node_alloc_, node, 1);
+    throw;
+  }
+  {
+    std::lock_guard<SpinLock> lock(parent->lock);
+    if (parent->version.load() != parent_version ||
+        parent->child(dir).load() != nullptr) {
+      delete_node(this, node);
+      return false;
+    }
+    parent->child(dir).store(node);
+  }
+  return true;
+}
+
+// A routing node becomes a value node again
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::attempt_update(
+    Node* node, T* value, bool overwrite, T*& previous) {
+  std::lock_guard<SpinLock> lock(node->lock);
+  if (is_unlinked(node->version.load())) {
+    return false;
+  }
+  previous = node->value.load();
+  if (overwrite || previous == nullptr) {
+    node->value.store(value);
+  }
+  return true;
+}
+
+// With two children the node stays as a routing node, otherwise it is
+// spliced out under the locks of its parent and itself
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::attempt_remove_node(
+    NodeBase* parent, Node* node, T*& previous, Guard& guard) {
+  if (node->value.load() == nullptr) {
+    previous = nullptr;
+    return true;
+  }
+  if (!can_unlink(node)) {
+    std::lock_guard<SpinLock> lock(node->lock);
+    if (is_unlinked(node->version.load()) || can_unlink(node)) {
+      return false;
+    }
+    previous = node->value.exchange(nullptr);
+    return true;
+  }
+  {
+    std::lock_guard<SpinLock> parent_lock(parent->lock);
+    if (is_unlinked(parent->version.load()) ||
+        node->parent.load() != parent) {
+      return false;
+    }
+    std::lock_guard<SpinLock> node_lock(node->lock);
+    if (is_unlinked(node->version.load())) {
+      return false;
+    }
+    previous = node->value.load();
+    if (previous == nullptr) {
+      return true;
+    }
+    if (!can_unlink(node)) {
+      return false;
+    }
+    Node* child = node->left.load() ? node->left.load() : node->right.load();
+    if (parent->left.load() == node) {
+      parent->left.store(child);
+    } else {
+      parent->right.store(child);
+    }
+    if (child) {
+      child->parent.store(parent);
+    }
+    node->value.store(nullptr);
+    node->version.store(kUnlinked);
+  }
+  guard.retire(node, delete_node, this);
+  fix_height_and_rebalance(parent, guard);
+  return true;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::can_unlink(Node* node) {
+  return node->left.load() == nullptr || node->right.load() == nullptr;
+}
+
+// Rebalancing
+// A rotation may hand back a node below the one it was called for, which
+// is repaired first. The heights above were not checked then, so the parent
+// is kept and the walk resumes there.
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::fix_height_and_rebalance(
+    NodeBase* node, Guard& guard) {
+  std::vector<NodeBase*> pending;
+  while (true) {
+    if (node == nullptr || node == &holder_) {
+      if (pending.empty()) {
+        return;
+      }
+      node = pending.back();
+      pending.pop_back();
+      continue;
+    }
+    Node* current = static_cast<Node*>(node);
+    int condition = node_condition(current);
+    if (condition == kNothingRequired ||
+        is_unlinked(current->version.load())) {
+      node = nullptr;
+    } else if (condition != kUnlinkRequired &&
+               condition != kRebalanceRequired) {
+      std::lock_guard<SpinLock> lock(current->lock);
+      node = fix_height_nl(current);
+    } else {
+      NodeBase* parent = current->parent.load();
+      std::lock_guard<SpinLock> parent_lock(parent->lock);
+      if (!is_unlinked(parent->version.load()) &&
+          current->parent.load() == parent) {
+        std::lock_guard<SpinLock> node_lock(current->lock);
+        node = rebalance_nl(parent, current, guard);
+        if (node != nullptr && node != parent &&
+            node != parent->parent.load() &&
+            (pending.empty() || pending.back() != parent)) {
+          pending.push_back(parent);
+        }
+      }
+    }
+  }
+}
+
+// A new height, or one of kUnlinkRequired, kRebalanceRequired and
+// kNothingRequired
+template <typename Key, typename T, typename Compare, typename Allocator>
+int ConcurrentAVLTree<Key, T, Compare, Allocator>::node_condition(
+    Node* node) const {
+  Node* left = node->left.load();
+  Node* right = node->right.load();
+  if ((left == nullptr || right == nullptr) &&
+      node->value.load() == nullptr) {
+    return kUnlinkRequired;
+  }
+  int height = node->height.load();
+  int left_height = height_of(left);
+  int right_height = height_of(right);
+  int new_height = 1 + std::max(left_height, right_height);
+  int balance = left_height - right_height;
+  if (balance < -1 || balance > 1) {
+    return kRebalanceRequired;
+  }
+  return height != new_height ? new_height : kNothingRequired;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::fix_height_nl(NodeBase* node) {
+  if (node == &holder_) {
+    return nullptr;
+  }
+  Node* current = static_cast<Node*>(node);
+  int condition = node_condition(current);
+  switch (condition) {
+    case kRebalanceRequired:
+    case kUnlinkRequired:
+      return current;
+    case kNothingRequired:
+      return nullptr;
+    default:
+      current->height.store(condition);
+      return current->parent.load();
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::rebalance_nl(NodeBase* parent,
+                                                            Node* node,
+                                                            Guard& guard) {
+  Node* left = node->left.load();
+  Node* right = node->right.load();
+  if ((left == nullptr || right == nullptr) &&
+      node->value.load() == nullptr) {
+    if (attempt_unlink_nl(parent, node)) {
+      guard.retire(node, delete_node, this);
+      return fix_height_nl(parent);
+    }
+    return node;
+  }
+  int height = node->height.load();
+  int left_height = height_of(left);
+  int right_height = height_of(right);
+  int new_height = 1 + std::max(left_height, right_height);
+  int balance = left_height - right_height;
+  if (balance > 1) {
+    return rebalance_to_right_nl(parent, node, left, right_height, guard);
+  } else if (balance < -1) {
+    return rebalance_to_left_nl(parent, node, right, left_height, guard);
+  } else if (new_height != height) {
+    node->height.store(new_height);
+    return fix_height_nl(parent);
+  }
+  return nullptr;
+}
+
+// node is a routing node with at most one child
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::attempt_unlink_nl(
+    NodeBase* parent, Node* node) {
+  Node* parent_left = parent->left.load();
+  if (parent_left != node && parent->right.load() != node) {
+    return false;
+  }
+  Node* left = node->left.load();
+  Node* right = node->right.load();
+  if (left != nullptr && right != nullptr) {
+    return false;
+  }
+  Node* splice = left ? left : right;
+  if (parent_left == node) {
+    parent->left.store(splice);
+  } else {
+    parent->right.store(splice);
+  }
+  if (splice) {
+    splice->parent.store(parent);
+  }
+  node->version.store(kUnlinked);
+  node->value.store(nullptr);
+  return true;
+}
+
+// Heights read before a child was locked are checked again under its lock
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::rebalance_to_right_nl(
+    NodeBase* parent, Node* node, Node* left, int right_height,
+    Guard& guard) {
+  std::lock_guard<SpinLock> left_lock(left->lock);
+  if (left->height.load() - right_height <= 1) {
+    return node;
+  }
+  Node* left_right = left->right.load();
+  int left_left_height = height_of(left->left.load());
+  int left_right_height = height_of(left_right);
+  if (left_left_height >= left_right_height) {
+    return rotate_right_nl(parent, node, left, right_height, left_left_height,
+                           left_right, left_right_height);
+  }
+  {
+    std::lock_guard<SpinLock> left_right_lock(left_right->lock);
+    left_right_height = left_right->height.load();
+    if (left_left_height >= left_right_height) {
+      return rotate_right_nl(parent, node, left, right_height,
+                             left_left_height, left_right, left_right_height);
+    }
+    int left_right_left_height = height_of(left_right->left.load());
+    int balance = left_left_height - left_right_left_height;
+    if (balance >= -1 && balance <= 1) {
+      return rotate_right_over_left_nl(parent, node, left, right_height,
+                                       left_left_height, left_right,
+                                       left_right_left_height, guard);
+    }
+  }
+  return rebalance_to_left_nl(node, left, left_right, left_left_height,
+                              guard);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::rebalance_to_left_nl(
+    NodeBase* parent, Node* node, Node* right, int left_height,
+    Guard& guard) {
+  std::lock_guard<SpinLock> right_lock(right->lock);
+  if (left_height - right->height.load() >= -1) {
+    return node;
+  }
+  Node* right_left = right->left.load();
+  int right_left_height = height_of(right_left);
+  int right_right_height = height_of(right->right.load());
+  if (right_right_height >= right_left_height) {
+    return rotate_left_nl(parent, node, right, left_height,
+                          right_right_height, right_left, right_left_height);
+  }
+  {
+    std::lock_guard<SpinLock> right_left_lock(right_left->lock);
+    right_left_height = right_left->height.load();
+    if (right_right_height >= right_left_height) {
+      return rotate_left_nl(parent, node, right, left_height,
+                            right_right_height, right_left,
+                            right_left_height);
+    }
+    int right_left_right_height = height_of(right_left->right.load());
+    int balance = right_right_height - right_left_right_height;
+    if (balance >= -1 && balance <= 1) {
+      return rotate_left_over_right_nl(parent, node, right, left_height,
+                                       right_right_height, right_left,
+                                       right_left_right_height, guard);
+    }
+  }
+  return rebalance_to_right_nl(node, right, right_left, right_right_height,
+                               guard);
+}
+
+// node moves down, so it is marked as shrinking while the links change.
+// The result is the node that may need repair next.
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::rotate_right_nl(
+    NodeBase* parent, Node* node, Node* left, int right_height,
+    int left_left_height, Node* left_right, int left_right_height) {
+  std::uint64_t node_version = node->version.load();
+  Node* parent_left = parent->left.load();
+  node->version.store(begin_shrink(node_version));
+
+  node->left.store(left_right);
+  if (left_right) {
+    left_right->parent.store(node);
+  }
+  left->right.store(node);
+  node->parent.store(left);
+  if (parent_left == node) {
+    parent->left.store(left);
+  } else {
+    parent->right.store(left);
+  }
+  left->parent.store(parent);
+
+  int node_height = 1 + std::max(left_right_height, right_height);
+  node->height.store(node_height);
+  left->height.store(1 + std::max(left_left_height, node_height));
+  node->version.store(end_shrink(node_version));
+
+  int node_balance = left_right_height - right_height;
+  if (node_balance < -1 || node_balance > 1) {
+    return node;
+  }
+  if ((left_right == nullptr || right_height == 0) &&
+      node->value.load() == nullptr) {
+    return node;
+  }
+  int left_balance = left_left_height - node_height;
+  if (left_balance < -1 || left_balance > 1) {
+    return left;
+  }
+  if (left_left_height == 0 && left->value.load() == nullptr) {
+    return left;
+  }
+  return fix_height_nl(parent);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::rotate_left_nl(
+    NodeBase* parent, Node* node, Node* right, int left_height,
+    int right_right_height, Node* right_left, int right_left_height) {
+  std::uint64_t node_version = node->version.load();
+  Node* parent_left = parent->left.load();
+  node->version.store(begin_shrink(node_version));
+
+  node->right.store(right_left);
+  if (right_left) {
+    right_left->parent.store(node);
+  }
+  right->left.store(node);
+  node->parent.store(right);
+  if (parent_left == node) {
+    parent->left.store(right);
+  } else {
+    parent->right.store(right);
+  }
+  right->parent.store(parent);
+
+  int node_height = 1 + std::max(left_height, right_left_height);
+  node->height.store(node_height);
+  right->height.store(1 + std::max(node_height, right_right_height));
+  node->version.store(end_shrink(node_version));
+
+  int node_balance = right_left_height - left_height;
+  if (node_balance < -1 || node_balance > 1) {
+    return node;
+  }
+  if ((right_left == nullptr || left_height == 0) &&
+      node->value.load() == nullptr) {
+    return node;
+  }
+  int right_balance = right_right_height - node_height;
+  if (right_balance < -1 || right_balance > 1) {
+    return right;
+  }
+  if (right_right_height == 0 && right->value.load() == nullptr) {
+    return right;
+  }
+  return fix_height_nl(parent);
+}
+
+// left_right comes up between node and left, both of which move down. A
+// routing left that is left with one child is spliced out on the spot: its
+// sibling node may need repair as well, and only one path is followed.
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::rotate_right_over_left_nl(
+    NodeBase* parent, Node* node, Node* left, int right_height,
+    int left_left_height, Node* left_right, int left_right_left_height,
+    Guard& guard) {
+  std::uint64_t node_version = node->version.load();
+  std::uint64_t left_version = left->version.load();
+  Node* parent_left = parent->left.load();
+  Node* left_right_left = left_right->left.load();
+  Node* left_right_right = left_right->right.load();
+  int left_right_right_height = height_of(left_right_right);
+  node->version.store(begin_shrink(node_version));
+  left->version.store(begin_shrink(left_version));
+
+  node->left.store(left_right_right);
+  if (left_right_right) {
+    left_right_right->parent.store(node);
+  }
+  left->right.store(left_right_left);
+  if (left_right_left) {
+    left_right_left->parent.store(left);
+  }
+  left_right->left.store(left);
+  left->parent.store(left_right);
+  left_right->right.store(node);
+  node->parent.store(left_right);
+  if (parent_left == node) {
+    parent->left.store(left_right);
+  } else {
+    parent->right.store(left_right);
+  }
+  left_right->parent.store(parent);
+
+  int node_height = 1 + std::max(left_right_right_height, right_height);
+  node->height.store(node_height);
+  int left_height = 1 + std::max(left_left_height, left_right_left_height);
+  Node* left_left = left->left.load();
+  if (left->value.load() == nullptr &&
+      (left_left == nullptr || left_right_left == nullptr)) {
+    Node* splice = left_left ? left_left : left_right_left;
+    left_right->left.store(splice);
+    if (splice) {
+      splice->parent.store(left_right);
+    }
+    left_height = height_of(splice);
+    left->version.store(kUnlinked);
+    guard.retire(left, delete_node, this);
+  } else {
+    left->height.store(left_height);
+    left->version.store(end_shrink(left_version));
+  }
+  left_right->height.store(1 + std::max(left_height, node_height));
+  node->version.store(end_shrink(node_version));
+
+  int node_balance = left_right_right_height - right_height;
+  if (node_balance < -1 || node_balance > 1) {
+    return node;
+  }
+  if ((left_right_right == nullptr || right_height == 0) &&
+      node->value.load() == nullptr) {
+    return node;
+  }
+  int left_right_balance = left_height - node_height;
+  if (left_right_balance < -1 || left_right_balance > 1) {
+    return left_right;
+  }
+  return fix_height_nl(parent);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::NodeBase*
+ConcurrentAVLTree<Key, T, Compare, Allocator>::rotate_left_over_right_nl(
+    NodeBase* parent, Node* node, Node* right, int left_height,
+    int right_right_height, Node* right_left, int right_left_right_height,
+    Guard& guard) {
+  std::uint64_t node_version = node->version.load();
+  std::uint64_t right_version = right->version.load();
+  Node* parent_left = parent->left.load();
+  Node* right_left_left = right_left->left.load();
+  Node* right_left_right = right_left->right.load();
+  int right_left_left_height = height_of(right_left_left);
+  node->version.store(begin_shrink(node_version));
+  right->version.store(begin_shrink(right_version));
+
+  node->right.store(right_left_left);
+  if (right_left_left) {
+    right_left_left->parent.store(node);
+  }
+  right->left.store(right_left_right);
+  if (right_left_right) {
+    right_left_right->parent.store(right);
+  }
+  right_left->right.store(right);
+  right->parent.store(right_left);
+  right_left->left.store(node);
+  node->parent.store(right_left);
+  if (parent_left == node) {
+    parent->left.store(right_left);
+  } else {
+    parent->right.store(right_left);
+  }
+  right_left->parent.store(parent);
+
+  int node_height = 1 + std::max(left_height, right_left_left_height);
+  node->height.store(node_height);
+  int right_height = 1 + std::max(right_left_right_height, right_right_height);
+  Node* right_right = right->right.load();
+  if (right->value.load() == nullptr &&
+      (right_left_right == nullptr || right_right == nullptr)) {
+    Node* splice = right_right ? right_right : right_left_right;
+    right_left->right.store(splice);
+    if (splice) {
+      splice->parent.store(right_left);
+    }
+    right_height = height_of(splice);
+    right->version.store(kUnlinked);
+    guard.retire(right, delete_node, this);
+  } else {
+    right->height.store(right_height);
+    right->version.store(end_shrink(right_version));
+  }
+  right_left->height.store(1 + std::max(node_height, right_height));
+  node->version.store(end_shrink(node_version));
+
+  int node_balance = right_left_left_height - left_height;
+  if (node_balance < -1 || node_balance > 1) {
+    return node;
+  }
+  if ((right_left_left == nullptr || left_height == 0) &&
+      node->value.load() == nullptr) {
+    return node;
+  }
+  int right_left_balance = right_height - node_height;
+  if (right_left_balance < -1 || right_left_balance > 1) {
+    return right_left;
+  }
+  return fix_height_nl(parent);
+}
+
+// Capacity
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool ConcurrentAVLTree<Key, T, Compare, Allocator>::empty() const {
+  return size() == 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::size_type
+ConcurrentAVLTree<Key, T, Compare, Allocator>::size() const {
+  std::ptrdiff_t total = 0;
+  for (size_type i = 0; i < EpochReclaimer::kSlots; ++i) {
+    total += counts_[i].value.load(std::memory_order_relaxed);
+  }
+  return total > 0 ? static_cast<size_type>(total) : 0;
+}
+
+// Modifiers
+template <typename Key, typename T, typename Compare, typename Allocator>
+void ConcurrentAVLTree<Key, T, Compare, Allocator>::clear() {
+  destroy_subtree(holder_.right.load());
+  holder_.right.store(nullptr);
+  reclaimer_.reclaim_all();
+  for (size_type i = 0; i < EpochReclaimer::kSlots; ++i) {
+    counts_[i].value.store(0);
+  }
+}
+
+// Observers
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::key_compare
+ConcurrentAVLTree<Key, T, Compare, Allocator>::key_comp() const {
+  return comp_;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename ConcurrentAVLTree<Key, T, Compare, Allocator>::allocator_type
+ConcurrentAVLTree<Key, T, Compare, Allocator>::get_allocator() const {
+  return allocator_type(node_alloc_);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef S21_EPOCH_RECLAIMER_H
+#define S21_EPOCH_RECLAIMER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace s21 {
+
+// Epoch-based reclamation for structures read without locks. A thread pins
+// itself for the length of an operation; whatever it unlinks meanwhile is
+// retired, and freed once every thread that was pinned at the time has
+// unpinned. Two epoch advances guarantee that.
+//
+// Pinned threads occupy one of kSlots slots, each with its own list of
+// retired objects, so retiring needs no lock. Slots are picked by thread id
+// and probed linearly; with more than kSlots threads pinned at once the
+// others wait.
+class EpochReclaimer {
+ public:
+  using size_type = std::size_t;
+  // Frees object, owner is what was passed to retire()
+  using Deleter = void (*)(void* owner, void* object);
+
+  static constexpr size_type kSlots = 128;
+  // A slot tries to free its list once it holds this many objects
+  static constexpr size_type kCollectThreshold = 64;
+
+  // Pins the calling thread until destruction
+  class Guard {
+   public:
+    explicit Guard(EpochReclaimer& reclaimer);
+    Guard(const Guard& other) = delete;
+    Guard& operator=(const Guard& other) = delete;
+    ~Guard();
+
+    // object must already be unreachable for threads pinned from now on
+    void retire(void* object, Deleter deleter, void* owner);
+    // Distinct among the threads pinned at the same time
+    size_type slot() const noexcept;
+
+   private:
+    EpochReclaimer& reclaimer_;
+    size_type slot_;
+  };
+
+  EpochReclaimer();
+  EpochReclaimer(const EpochReclaimer& other) = delete;
+  EpochReclaimer& operator=(const EpochReclaimer& other) = delete;
+  // Frees everything still retired, no thread may be pinned
+  ~EpochReclaimer();
+
+  // Frees everything retired so far, no thread may be pinned
+  void reclaim_all();
+
+ private:
+  struct Retired {
+    void* object;
+    Deleter deleter;
+    void* owner;
+    std::uint64_t epoch;
+  };
+
+  // state_ is 0 when the slot is free and (epoch << 1) | 1 while a thread
+  // pinned in that epoch holds it
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> state_{0};
+    std::vector<Retired> retired_;
+  };
+
+  alignas(64) std::atomic<std::uint64_t> epoch_{1};
+  std::unique_ptr<Slot[]> slots_;
+
+  size_type pin();
+  void unpin(size_type slot);
+  bool try_advance();
+  void collect(Slot& slot);
+};
+
+}  // namespace s21
+
+#include "EpochReclaimer.tpp"
+
+#endif
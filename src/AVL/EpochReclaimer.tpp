@@ -0,0 +1,103 @@
+#ifndef S21_EPOCH_RECLAIMER_TPP
+#define S21_EPOCH_RECLAIMER_TPP
+
+#include <functional>
+#include <thread>
+
+#include "EpochReclaimer.h"
+
+namespace s21 {
+
+inline EpochReclaimer::Guard::Guard(EpochReclaimer& reclaimer)
+    : reclaimer_(reclaimer), slot_(reclaimer.pin()) {}
+
+inline EpochReclaimer::Guard::~Guard() { reclaimer_.unpin(slot_); }
+
+inline void EpochReclaimer::Guard::retire(void* object, Deleter deleter,
+                                          void* owner) {
+  Slot& slot = reclaimer_.slots_[slot_];
+  slot.retired_.push_back(
+      {object, deleter, owner, reclaimer_.epoch_.load()});
+  if (slot.retired_.size() >= kCollectThreshold) {
+    reclaimer_.collect(slot);
+  }
+}
+
+inline EpochReclaimer::size_type EpochReclaimer::Guard::slot() const noexcept {
+  return slot_;
+}
+
+inline EpochReclaimer::EpochReclaimer() : slots_(new Slot[kSlots]) {}
+
+inline EpochReclaimer::~EpochReclaimer() { reclaim_all(); }
+
+inline void EpochReclaimer::reclaim_all() {
+  for (size_type i = 0; i < kSlots; ++i) {
+    for (const Retired& retired : slots_[i].retired_) {
+      retired.deleter(retired.owner, retired.object);
+    }
+    slots_[i].retired_.clear();
+  }
+}
+
+// The slot is announced before the epoch is checked again, so an advance
+// either sees this thread or happened before it read anything
+inline EpochReclaimer::size_type EpochReclaimer::pin() {
+  static thread_local size_type hint =
+      std::hash<std::thread::id>()(std::this_thread::get_id()) % kSlots;
+  for (size_type probe = 0;; ++probe) {
+    size_type index = (hint + probe) % kSlots;
+    Slot& slot = slots_[index];
+    std::uint64_t epoch = epoch_.load();
+    std::uint64_t expected = 0;
+    if (slot.state_.load(std::memory_order_relaxed) == 0 &&
+        slot.state_.compare_exchange_strong(expected, (epoch << 1) | 1)) {
+      for (std::uint64_t now = epoch_.load(); now != epoch;
+           now = epoch_.load()) {
+        epoch = now;
+        slot.state_.store((epoch << 1) | 1);
+      }
+      hint = index;
+      return index;
+    }
+    if (probe % kSlots == kSlots - 1) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+inline void EpochReclaimer::unpin(size_type slot) {
+  slots_[slot].state_.store(0, std::memory_order_release);
+}
+
+// Moves to the next epoch if every pinned thread has seen the current one
+inline bool EpochReclaimer::try_advance() {
+  std::uint64_t epoch = epoch_.load();
+  for (size_type i = 0; i < kSlots; ++i) {
+    std::uint64_t state = slots_[i].state_.load();
+    if ((state & 1) != 0 && (state >> 1) != epoch) {
+      return false;
+    }
+  }
+  return epoch_.compare_exchange_strong(epoch, epoch + 1);
+}
+
+// Only threads pinned in epoch e - 1 or e can still see an object retired
+// in e, and none of them is left once the epoch reaches e + 2. The list is
+// ordered by epoch.
+inline void EpochReclaimer::collect(Slot& slot) {
+  try_advance();
+  std::uint64_t epoch = epoch_.load();
+  size_type freed = 0;
+  while (freed < slot.retired_.size() &&
+         slot.retired_[freed].epoch + 2 <= epoch) {
+    const Retired& retired = slot.retired_[freed++];
+    retired.deleter(retired.owner, retired.object);
+  }
+  slot.retired_.erase(slot.retired_.begin(),
+                      slot.retired_.begin() + freed);
+}
+
+}  // namespace s21
+
+#endif
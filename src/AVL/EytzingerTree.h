@@ -0,0 +1,149 @@
+#ifndef S21_EYTZINGER_TREE_H
+#define S21_EYTZINGER_TREE_H
+
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "NodePolicy.h"
+
+namespace s21 {
+
+// Immutable search tree in one array in Eytzinger (BFS) order: the root is
+// position 1, the children of k are 2k and 2k + 1, and the values are
+// stored at position - 1. A search touches no links, only values, and the
+// first levels are packed together at the front of the array.
+//
+// The descent is branchless, it goes to 2k + (value < key) until it falls
+// off the tree and then strips the trailing right turns to find the lower
+// bound. On the way it prefetches the descendants a cache line of levels
+// ahead, they are contiguous in this layout.
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+class EytzingerTree {
+ public:
+  using key_type = Key;
+  using value_type = typename Policy::value_type;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ protected:
+  using ValueAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<value_type>;
+
+  // The kBlock descendants of k that are log2(kBlock) levels down start at
+  // kBlock * k and fill a cache line
+  static constexpr size_type kCacheLine = 64;
+  static constexpr size_type kBlock = sizeof(value_type) >= kCacheLine
+                                          ? 1
+                                          : kCacheLine / sizeof(value_type);
+
+  std::vector<value_type, ValueAllocator> values_;
+  Compare comp_;
+
+ public:
+  // Only const iteration, the snapshot can not be changed. Positions are
+  // visited in key order, 0 is end().
+  class ConstIterator {
+    friend class EytzingerTree;
+
+   protected:
+    const EytzingerTree* tree_;
+    size_type position_;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename EytzingerTree::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    ConstIterator() noexcept;
+    ConstIterator(const EytzingerTree* tree, size_type position) noexcept;
+
+    bool operator==(const ConstIterator& other) const;
+    bool operator!=(const ConstIterator& other) const;
+    const_reference operator*() const;
+    const value_type* operator->() const;
+    ConstIterator& operator++();
+    ConstIterator operator++(int);
+    ConstIterator& operator--();
+    ConstIterator operator--(int);
+
+    // 0 for end()
+    size_type position() const;
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+
+  // Constructors. first..last must be sorted by comp and free of equal keys,
+  // as set and map iterate.
+  EytzingerTree();
+  explicit EytzingerTree(const Compare& comp,
+                         const Allocator& alloc = Allocator());
+  template <typename ForwardIt>
+  EytzingerTree(ForwardIt first, ForwardIt last, const Compare& comp,
+                const Allocator& alloc);
+  EytzingerTree(const EytzingerTree& other) = default;
+  EytzingerTree(EytzingerTree&& other) noexcept = default;
+  EytzingerTree& operator=(EytzingerTree&& other) noexcept = default;
+
+ protected:
+  // In-order walk over the positions of a tree of n values
+  static size_type first_position(size_type n);
+  static size_type last_position(size_type n);
+  static size_type next_position(size_type position, size_type n);
+  static size_type prev_position(size_type position, size_type n);
+  // Undoes the right turns at the bottom of a descent, which leaves the
+  // last position where it went left
+  static size_type strip_right_turns(size_type position);
+
+  const value_type& at_position(size_type position) const;
+  void prefetch(size_type position) const;
+  template <typename K>
+  size_type lower_bound_position(const K& key) const;
+  template <typename K>
+  size_type upper_bound_position(const K& key) const;
+  template <typename K>
+  size_type find_position(const K& key) const;
+
+ public:
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+
+  // Lookup. The templated overloads need a transparent Compare.
+  const_iterator find(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const;
+  size_type count(const Key& key) const;
+  bool contains(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const;
+  const_iterator lower_bound(const Key& key) const;
+  const_iterator upper_bound(const Key& key) const;
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+
+  // Observers
+  key_compare key_comp() const;
+  allocator_type get_allocator() const;
+};
+
+}  // namespace s21
+
+#include "EytzingerTree.tpp"
+
+#endif
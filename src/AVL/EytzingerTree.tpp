@@ -0,0 +1,355 @@
+#ifndef S21_EYTZINGER_TREE_TPP
+#define S21_EYTZINGER_TREE_TPP
+
+#include "EytzingerTree.h"
+
+namespace s21 {
+
+// ConstIterator
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::
+    ConstIterator() noexcept
+    : tree_(nullptr), position_(0) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::ConstIterator(
+    const EytzingerTree* tree, size_type position) noexcept
+    : tree_(tree), position_(position) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator==(
+    const ConstIterator& other) const {
+  return position_ == other.position_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator!=(
+    const ConstIterator& other) const {
+  return position_ != other.position_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_reference
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator*()
+    const {
+  if (position_ == 0) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return tree_->at_position(position_);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+const typename EytzingerTree<Key, Compare, Allocator, Policy>::value_type*
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator->()
+    const {
+  return &**this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator&
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator++() {
+  position_ = next_position(position_, tree_->size());
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator++(
+    int) {
+  ConstIterator temp = *this;
+  ++*this;
+  return temp;
+}
+
+// From end() to the last element
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator&
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator--() {
+  position_ = position_ == 0 ? last_position(tree_->size())
+                             : prev_position(position_, tree_->size());
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::operator--(
+    int) {
+  ConstIterator temp = *this;
+  --*this;
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::ConstIterator::position()
+    const {
+  return position_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::begin() const {
+  return const_iterator(this, first_position(size()));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::end() const {
+  return const_iterator(this, 0);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::cbegin() const {
+  return begin();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::cend() const {
+  return end();
+}
+
+// Constructors
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+EytzingerTree<Key, Compare, Allocator, Policy>::EytzingerTree() {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+EytzingerTree<Key, Compare, Allocator, Policy>::EytzingerTree(
+    const Compare& comp, const Allocator& alloc)
+    : values_(ValueAllocator(alloc)), comp_(comp) {}
+
+// The in-order walk tells which sorted element goes to each position, the
+// values are then copied in position order
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename ForwardIt>
+EytzingerTree<Key, Compare, Allocator, Policy>::EytzingerTree(
+    ForwardIt first, ForwardIt last, const Compare& comp,
+    const Allocator& alloc)
+    : values_(ValueAllocator(alloc)), comp_(comp) {
+  size_type n = 0;
+  for (ForwardIt it = first; it != last; ++it) {
+    ++n;
+  }
+  std::vector<ForwardIt> sources(n + 1);
+  for (size_type k = first_position(n); k != 0; k = next_position(k, n)) {
+    sources[k] = first++;
+  }
+  values_.reserve(n);
+  for (size_type k = 1; k <= n; ++k) {
+    values_.emplace_back(*sources[k]);
+  }
+}
+
+// Helpers
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::first_position(size_type n) {
+  size_type k = n == 0 ? 0 : 1;
+  while (k != 0 && 2 * k <= n) {
+    k = 2 * k;
+  }
+  return k;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::last_position(size_type n) {
+  size_type k = n == 0 ? 0 : 1;
+  while (k != 0 && 2 * k + 1 <= n) {
+    k = 2 * k + 1;
+  }
+  return k;
+}
+
+// The leftmost position of the right subtree, or else the nearest ancestor
+// reached from its left
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::next_position(
+    size_type position, size_type n) {
+  if (2 * position + 1 <= n) {
+    position = 2 * position + 1;
+    while (2 * position <= n) {
+      position = 2 * position;
+    }
+    return position;
+  }
+  return strip_right_turns(position);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::prev_position(
+    size_type position, size_type n) {
+  if (2 * position <= n) {
+    position = 2 * position;
+    while (2 * position + 1 <= n) {
+      position = 2 * position + 1;
+    }
+    return position;
+  }
+  while (position != 0 && (position & 1) == 0) {
+    position >>= 1;
+  }
+  return position >> 1;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::strip_right_turns(
+    size_type position) {
+#if defined(__GNUC__)
+  // ~position has a set bit above the top one, so it is never zero
+  return position >> (__builtin_ctzll(~static_cast<unsigned long long>(
+                          position)) +
+                      1);
+#else
+  while (position & 1) {
+    position >>= 1;
+  }
+  return position >> 1;
+#endif
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+const typename EytzingerTree<Key, Compare, Allocator, Policy>::value_type&
+EytzingerTree<Key, Compare, Allocator, Policy>::at_position(
+    size_type position) const {
+  return values_.data()[position - 1];
+}
+
+// The address is only computed, it may lie past the array
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void EytzingerTree<Key, Compare, Allocator, Policy>::prefetch(
+    size_type position) const {
+#if defined(__GNUC__)
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(values_.data()) +
+                           (kBlock * position - 1) * sizeof(value_type);
+  __builtin_prefetch(reinterpret_cast<const void*>(address));
+#else
+  (void)position;
+#endif
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::lower_bound_position(
+    const K& key) const {
+  size_type n = values_.size();
+  size_type k = 1;
+  while (k <= n) {
+    prefetch(k);
+    k = 2 * k + comp_(Policy::key(at_position(k)), key);
+  }
+  return strip_right_turns(k);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::upper_bound_position(
+    const K& key) const {
+  size_type n = values_.size();
+  size_type k = 1;
+  while (k <= n) {
+    prefetch(k);
+    k = 2 * k + !comp_(key, Policy::key(at_position(k)));
+  }
+  return strip_right_turns(k);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::find_position(
+    const K& key) const {
+  size_type k = lower_bound_position(key);
+  return k != 0 && !comp_(key, Policy::key(at_position(k))) ? k : 0;
+}
+
+// Capacity
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool EytzingerTree<Key, Compare, Allocator, Policy>::empty() const {
+  return values_.empty();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::size() const {
+  return values_.size();
+}
+
+// Lookup
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::find(const Key& key) const {
+  return const_iterator(this, find_position(key));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename C, typename>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::find(const K& key) const {
+  return const_iterator(this, find_position(key));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::size_type
+EytzingerTree<Key, Compare, Allocator, Policy>::count(const Key& key) const {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool EytzingerTree<Key, Compare, Allocator, Policy>::contains(
+    const Key& key) const {
+  return find_position(key) != 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename C, typename>
+bool EytzingerTree<Key, Compare, Allocator, Policy>::contains(
+    const K& key) const {
+  return find_position(key) != 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::lower_bound(
+    const Key& key) const {
+  return const_iterator(this, lower_bound_position(key));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator
+EytzingerTree<Key, Compare, Allocator, Policy>::upper_bound(
+    const Key& key) const {
+  return const_iterator(this, upper_bound_position(key));
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+std::pair<
+    typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator,
+    typename EytzingerTree<Key, Compare, Allocator, Policy>::const_iterator>
+EytzingerTree<Key, Compare, Allocator, Policy>::equal_range(
+    const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+// Observers
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::key_compare
+EytzingerTree<Key, Compare, Allocator, Policy>::key_comp() const {
+  return comp_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename EytzingerTree<Key, Compare, Allocator, Policy>::allocator_type
+EytzingerTree<Key, Compare, Allocator, Policy>::get_allocator() const {
+  return allocator_type(values_.get_allocator());
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef S21_FORK_JOIN_POOL_H
+#define S21_FORK_JOIN_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s21 {
+
+// Work-stealing fork-join pool. invoke(a, b) pushes b onto the deque of
+// the calling thread, runs a and then pops b back if no other thread has
+// stolen it meanwhile; otherwise it helps with other tasks until b is done,
+// so nested invokes never deadlock. Owners work at the back of their deque
+// and thieves take from the front, where the largest subproblems are.
+//
+// Tasks live on the stack of invoke() and hold a plain function pointer,
+// so forking allocates nothing. Each worker has its own deque and lock;
+// threads that are not workers share one more deque.
+class ForkJoinPool {
+ public:
+  using size_type = std::size_t;
+
+  // A full deque runs b inline instead of publishing it
+  static constexpr size_type kDequeCapacity = 256;
+
+  // threads counts the calling thread too, so threads - 1 workers are started
+  explicit ForkJoinPool(size_type threads = default_threads());
+  ForkJoinPool(const ForkJoinPool& other) = delete;
+  ForkJoinPool& operator=(const ForkJoinPool& other) = delete;
+  ~ForkJoinPool();
+
+  template <typename A, typename B>
+  void invoke(A&& a, B&& b);
+  size_type threads() const noexcept;
+
+  static ForkJoinPool& global();
+  static size_type default_threads() noexcept;
+
+ private:
+  struct Task {
+    void (*run_)(void* function);
+    void* function_;
+    std::atomic<bool> done_{false};
+    std::exception_ptr error_;
+  };
+
+  // Ring buffer of tasks, the owner pushes and pops at the back
+  struct alignas(64) Deque {
+    std::mutex mutex_;
+    Task* tasks_[kDequeCapacity];
+    size_type front_ = 0;
+    size_type size_ = 0;
+
+    bool push(Task* task);
+    bool pop_back(Task* task);
+    Task* steal();
+  };
+
+  // Fixed before any worker starts, workers_ grows while they run
+  size_type count_;
+  std::unique_ptr<Deque[]> deques_;
+  std::vector<std::thread> workers_;
+  // Tasks published and not taken yet, sleeping workers wait for it
+  std::atomic<size_type> pending_{0};
+  std::atomic<size_type> sleeping_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable ready_;
+  bool stop_ = false;
+
+  void stop();
+  Deque& own_deque();
+  void worker_loop(size_type index);
+  void push(Deque& deque, Task* task);
+  Task* try_steal(size_type start);
+  static void execute(Task* task) noexcept;
+};
+
+}  // namespace s21
+
+#include "ForkJoinPool.tpp"
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef S21_FORK_JOIN_POOL_TPP
+#define S21_FORK_JOIN_POOL_TPP
+
+#include <algorithm>
+#include <type_traits>
+
+#include "ForkJoinPool.h"
+
+namespace s21 {
+
+namespace fork_join_detail {
+
+// The pool and deque index of the calling thread, set for workers only
+struct Worker {
+  const void* pool_ = nullptr;
+  std::size_t index_ = 0;
+};
+
+inline Worker& current_worker() noexcept {
+  static thread_local Worker worker;
+  return worker;
+}
+
+}  // namespace fork_join_detail
+
+// Deque
+inline bool ForkJoinPool::Deque::push(Task* task) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ == kDequeCapacity) {
+    return false;
+  }
+  tasks_[(front_ + size_) % kDequeCapacity] = task;
+  ++size_;
+  return true;
+}
+
+// Nested invokes push and pop in stack order, so task is at the back
+// unless it was stolen
+inline bool ForkJoinPool::Deque::pop_back(Task* task) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ == 0 || tasks_[(front_ + size_ - 1) % kDequeCapacity] != task) {
+    return false;
+  }
+  --size_;
+  return true;
+}
+
+inline ForkJoinPool::Task* ForkJoinPool::Deque::steal() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (size_ == 0) {
+    return nullptr;
+  }
+  Task* task = tasks_[front_];
+  front_ = (front_ + 1) % kDequeCapacity;
+  --size_;
+  return task;
+}
+
+// ForkJoinPool
+inline ForkJoinPool::ForkJoinPool(size_type threads)
+    : count_(std::max<size_type>(threads, 1)), deques_(new Deque[count_]) {
+  try {
+    workers_.reserve(count_ - 1);
+    for (size_type i = 1; i < count_; i++) {
+      workers_.emplace_back([this, i] { worker_loop(i); });
+    }
+  } catch (...) {
+    stop();
+    throw;
+  }
+}
+
+inline ForkJoinPool::~ForkJoinPool() { stop(); }
+
+template <typename A, typename B>
+void ForkJoinPool::invoke(A&& a, B&& b) {
+  using Function = std::remove_reference_t<B>;
+  if (count_ == 1) {
+    a();
+    b();
+    return;
+  }
+
+  Task task;
+  task.run_ = [](void* function) { (*static_cast<Function*>(function))(); };
+  task.function_ = const_cast<void*>(static_cast<const void*>(&b));
+  Deque& deque = own_deque();
+  if (!deque.push(&task)) {
+    a();
+    b();
+    return;
+  }
+  pending_.fetch_add(1);
+  if (sleeping_.load() > 0) {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    ready_.notify_one();
+  }
+
+  std::exception_ptr error;
+  try {
+    a();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  if (deque.pop_back(&task)) {
+    pending_.fetch_sub(1);
+    execute(&task);
+  } else {
+    // Somebody else runs b, help with other tasks meanwhile
+    size_type start = static_cast<size_type>(&deque - deques_.get());
+    while (!task.done_.load(std::memory_order_acquire)) {
+      Task* other = try_steal(start);
+      if (other != nullptr) {
+        execute(other);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  if (task.error_) {
+    std::rethrow_exception(task.error_);
+  }
+}
+
+inline ForkJoinPool::size_type ForkJoinPool::threads() const noexcept {
+  return count_;
+}
+
+inline ForkJoinPool& ForkJoinPool::global() {
+  static ForkJoinPool pool;
+  return pool;
+}
+
+inline ForkJoinPool::size_type ForkJoinPool::default_threads() noexcept {
+  return std::max<size_type>(1, std::thread::hardware_concurrency());
+}
+
+inline void ForkJoinPool::stop() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  ready_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+// Workers own deques 1.., every other thread shares deque 0
+inline ForkJoinPool::Deque& ForkJoinPool::own_deque() {
+  fork_join_detail::Worker& worker = fork_join_detail::current_worker();
+  return deques_[worker.pool_ == this ? worker.index_ : 0];
+}
+
+inline void ForkJoinPool::worker_loop(size_type index) {
+  fork_join_detail::current_worker() = {this, index};
+  for (;;) {
+    Task* task = try_steal(index);
+    if (task != nullptr) {
+      execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    sleeping_.fetch_add(1);
+    ready_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+    sleeping_.fetch_sub(1);
+    if (stop_) {
+      return;
+    }
+  }
+}
+
+// Visits the other deques round-robin, starting after start
+inline ForkJoinPool::Task* ForkJoinPool::try_steal(size_type start) {
+  for (size_type i = 1; i <= count_; ++i) {
+    Task* task = deques_[(start + i) % count_].steal();
+    if (task != nullptr) {
+      pending_.fetch_sub(1);
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+inline void ForkJoinPool::execute(Task* task) noexcept {
+  try {
+    task->run_(task->function_);
+  } catch (...) {
+    task->error_ = std::current_exception();
+  }
+  task->done_.store(true, std::memory_order_release);
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,40 @@
+#ifndef S21_NODE_POLICY_H
+#define S21_NODE_POLICY_H
+
+#include <utility>
+
+namespace s21 {
+
+// What a tree node stores next to its links, and how the key is read from
+// it. Nodes are built from the same arguments as value_type. reference and
+// pointer are what a mutable tree iterator hands out into the node.
+
+// Sets: the key is the whole value and can not be changed in place
+template <typename Key>
+struct SetNodePolicy {
+  using value_type = Key;
+  using reference = const Key&;
+  using pointer = const Key*;
+
+  template <typename V>
+  static const V& key(const V& value) {
+    return value;
+  }
+};
+
+// Maps: the key and the mapped value, stored as the map's value_type
+template <typename Key, typename T>
+struct MapNodePolicy {
+  using value_type = std::pair<const Key, T>;
+  using reference = value_type&;
+  using pointer = value_type*;
+
+  template <typename V>
+  static const auto& key(const V& value) {
+    return value.first;
+  }
+};
+
+}  // namespace s21
+
+#endif
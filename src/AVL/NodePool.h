@@ -0,0 +1,97 @@
+#ifndef S21_NODE_POOL_H
+#define S21_NODE_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Slab allocator for tree nodes. Nodes are carved out of contiguous chunks
+// of growing size, erased nodes are recycled through an intrusive freelist
+// and release() returns every chunk at once without touching single nodes.
+// Chunks are requested from Allocator rebound to the slot type.
+//
+// After share() two pools hold chunks in common, each keeps its own
+// freelist and the chunks are freed along with the last pool owning them.
+template <typename Node, typename Allocator = std::allocator<Node>>
+class NodePool {
+ public:
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  NodePool() noexcept(noexcept(Allocator()));
+  explicit NodePool(const Allocator& alloc) noexcept;
+  NodePool(const NodePool& other) = delete;
+  NodePool(NodePool&& other) noexcept;
+  NodePool& operator=(const NodePool& other) = delete;
+  NodePool& operator=(NodePool&& other) noexcept;
+  ~NodePool();
+
+  template <typename... Args>
+  Node* create(Args&&... args);
+  void destroy(Node* node) noexcept;
+  // Frees all chunks, shared ones once no other pool owns them. Live nodes
+  // are not destructed, the caller has to do it beforehand if Node is not
+  // trivially destructible.
+  void release() noexcept;
+  void swap(NodePool& other) noexcept;
+  // Takes over all chunks of other, so nodes created by other may be
+  // relinked into a tree owning this pool. other is left empty.
+  // Requires equal allocators.
+  void splice(NodePool& other);
+  // Makes both pools own the chunks of other, so nodes created by other may
+  // be relinked into a tree owning this pool while the rest stay in other's
+  // tree. Requires equal allocators.
+  void share(NodePool& other);
+  // Number of chunk groups held in common with other pools
+  size_type shared_count() const noexcept;
+  allocator_type get_allocator() const noexcept;
+
+ private:
+  union Slot {
+    Slot* next_;
+    struct {
+      Slot* next_;
+      size_type size_;
+    } chunk_;
+    alignas(Node) unsigned char storage_[sizeof(Node)];
+  };
+
+  using SlotAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  using SlotTraits = std::allocator_traits<SlotAllocator>;
+
+  // Chunks handed over by share(), freed by the last pool pointing to them
+  struct SharedChunks {
+    SlotAllocator alloc_;
+    Slot* chunks_ = nullptr;
+
+    explicit SharedChunks(const SlotAllocator& alloc) noexcept;
+    ~SharedChunks();
+  };
+
+  static constexpr size_type kFirstChunk = 16;
+  static constexpr size_type kMaxChunk = 4096;
+
+  // The first slot of every chunk links to the previously allocated chunk
+  // and keeps the number of slots it was allocated with.
+  SlotAllocator alloc_;
+  Slot* chunks_;
+  Slot* free_;
+  Slot* cursor_;
+  Slot* cursor_end_;
+  size_type next_chunk_;
+  std::vector<std::shared_ptr<SharedChunks>> shared_;
+
+  void allocate_chunk();
+  static void free_chunks(SlotAllocator& alloc, Slot* chunks) noexcept;
+};
+
+}  // namespace s21
+
+#include "NodePool.tpp"
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef S21_NODE_POOL_TPP
+#define S21_NODE_POOL_TPP
+
+#include <algorithm>
+
+#include "NodePool.h"
+
+namespace s21 {
+
+template <typename Node, typename Allocator>
+NodePool<Node, Allocator>::NodePool() noexcept(noexcept(Allocator()))
+    : NodePool(Allocator()) {}
+
+template <typename Node, typename Allocator>
+NodePool<Node, Allocator>::NodePool(const Allocator& alloc) noexcept
+    : alloc_(alloc),
+      chunks_(nullptr),
+      free_(nullptr),
+      cursor_(nullptr),
+      cursor_end_(nullptr),
+      next_chunk_(kFirstChunk) {}
+
+template <typename Node, typename Allocator>
+NodePool<Node, Allocator>::NodePool(NodePool&& other) noexcept
+    : NodePool(other.get_allocator()) {
+  swap(other);
+}
+
+template <typename Node, typename Allocator>
+NodePool<Node, Allocator>& NodePool<Node, Allocator>::operator=(
+    NodePool&& other) noexcept {
+  if (this != &other) {
+    release();
+    swap(other);
+  }
+  return *this;
+}
+
+template <typename Node, typename Allocator>
+NodePool<Node, Allocator>::~NodePool() {
+  release();
+}
+
+template <typename Node, typename Allocator>
+template <typename... Args>
+Node* NodePool<Node, Allocator>::create(Args&&... args) {
+  Slot* slot = free_;
+  if (slot != nullptr) {
+    free_ = slot->next_;
+  } else {
+    if (cursor_ == cursor_end_) {
+      allocate_chunk();
+    }
+    slot = cursor_++;
+  }
+
+  try {
+    return new (slot->storage_) Node(std::forward<Args>(args)...);
+  } catch (...) {
+    slot->next_ = free_;
+    free_ = slot;
+    throw;
+  }
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::destroy(Node* node) noexcept {
+  if (node == nullptr) return;
+  node->~Node();
+  Slot* slot = reinterpret_cast<Slot*>(node);
+  slot->next_ = free_;
+  free_ = slot;
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::release() noexcept {
+  free_chunks(alloc_, chunks_);
+  chunks_ = nullptr;
+  shared_.clear();
+  free_ = nullptr;
+  cursor_ = nullptr;
+  cursor_end_ = nullptr;
+  next_chunk_ = kFirstChunk;
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::swap(NodePool& other) noexcept {
+  std::swap(alloc_, other.alloc_);
+  std::swap(chunks_, other.chunks_);
+  std::swap(free_, other.free_);
+  std::swap(cursor_, other.cursor_);
+  std::swap(cursor_end_, other.cursor_end_);
+  std::swap(next_chunk_, other.next_chunk_);
+  shared_.swap(other.shared_);
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::splice(NodePool& other) {
+  if (this == &other) {
+    return;
+  }
+  shared_.insert(shared_.end(), other.shared_.begin(), other.shared_.end());
+
+  // The unused tail of other's current chunk is not lost
+  while (other.cursor_ != other.cursor_end_) {
+    Slot* slot = other.cursor_++;
+    slot->next_ = other.free_;
+    other.free_ = slot;
+  }
+
+  if (other.free_ != nullptr) {
+    Slot* tail = other.free_;
+    while (tail->next_ != nullptr) {
+      tail = tail->next_;
+    }
+    tail->next_ = free_;
+    free_ = other.free_;
+  }
+
+  if (other.chunks_ != nullptr) {
+    Slot* tail = other.chunks_;
+    while (tail->chunk_.next_ != nullptr) {
+      tail = tail->chunk_.next_;
+    }
+    tail->chunk_.next_ = chunks_;
+    chunks_ = other.chunks_;
+  }
+
+  if (other.next_chunk_ > next_chunk_) {
+    next_chunk_ = other.next_chunk_;
+  }
+
+  other.chunks_ = nullptr;
+  other.release();
+}
+
+// other keeps its freelist and the unused tail of its current chunk, both
+// in chunks it still owns. Groups this pool already holds from an earlier
+// share() are not added again, so merging from the same pool over and over
+// adds at most one group per call.
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::share(NodePool& other) {
+  if (this == &other) {
+    return;
+  }
+
+  other.shared_.reserve(other.shared_.size() + 1);
+  shared_.reserve(shared_.size() + other.shared_.size() + 1);
+  if (other.chunks_ != nullptr) {
+    std::shared_ptr<SharedChunks> chunks =
+        std::allocate_shared<SharedChunks>(other.alloc_, other.alloc_);
+    chunks->chunks_ = other.chunks_;
+    other.chunks_ = nullptr;
+    other.shared_.push_back(std::move(chunks));
+  }
+  size_type held = shared_.size();
+  for (const auto& chunks : other.shared_) {
+    auto first = shared_.begin();
+    auto last = first + held;
+    if (std::find(first, last, chunks) == last) {
+      shared_.push_back(chunks);
+    }
+  }
+}
+
+template <typename Node, typename Allocator>
+typename NodePool<Node, Allocator>::size_type
+NodePool<Node, Allocator>::shared_count() const noexcept {
+  return shared_.size();
+}
+
+template <typename Node, typename Allocator>
+typename NodePool<Node, Allocator>::allocator_type
+NodePool<Node, Allocator>::get_allocator() const noexcept {
+  return allocator_type(alloc_);
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::allocate_chunk() {
+  Slot* chunk = SlotTraits::allocate(alloc_, next_chunk_ + 1);
+  chunk->chunk_.next_ = chunks_;
+  chunk->chunk_.size_ = next_chunk_ + 1;
+  chunks_ = chunk;
+
+  cursor_ = chunk + 1;
+  cursor_end_ = cursor_ + next_chunk_;
+  if (next_chunk_ < kMaxChunk) {
+    next_chunk_ *= 2;
+  }
+}
+
+template <typename Node, typename Allocator>
+void NodePool<Node, Allocator>::free_chunks(SlotAllocator& alloc,
+                                            Slot* chunks) noexcept {
+  while (chunks != nullptr) {
+    Slot* prev = chunks->chunk_.next_;
+    SlotTraits::deallocate(alloc, chunks, chunks->chunk_.size_);
+    chunks = prev;
+  }
+}
+
+template <typename Node, typename Allocator>
+NodePool<Node, Allocator>::SharedChunks::SharedChunks(
+    const SlotAllocator& alloc) noexcept
+    : alloc_(alloc) {}
+
+template <typename Node, typename Allocator>
+NodePool<Node, Allocator>::SharedChunks::~SharedChunks() {
+  free_chunks(alloc_, chunks_);
+}
+
+}  // namespace s21
+
+#endif
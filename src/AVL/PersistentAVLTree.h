@@ -0,0 +1,176 @@
+#ifndef S21_PERSISTENT_AVL_TREE_H
+#define S21_PERSISTENT_AVL_TREE_H
+
+#include <atomic>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "NodePolicy.h"
+
+namespace s21 {
+
+// AVL tree whose nodes may be shared between trees. A copy only takes a
+// reference to the root, O(1), and a modification copies the nodes on its
+// search path that are shared, O(log n) new nodes, leaving every other tree
+// untouched. Nodes owned by this tree alone are changed in place.
+//
+// Nodes are reference counted, atomically, so trees sharing nodes may be
+// used and destroyed on different threads. A single tree is not safe for
+// concurrent modification. Nodes have no parent links, iterators keep the
+// path from the root instead; they are invalidated by any modification of
+// their tree, copies are not affected.
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+class PersistentAVLTree {
+ public:
+  using key_type = Key;
+  using value_type = typename Policy::value_type;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+ protected:
+  // A node owned by one tree alone has refs == 1 and may be changed
+  struct Node {
+    Node* left;
+    Node* right;
+    std::atomic<size_type> refs;
+    signed char height;
+    value_type value;
+
+    template <typename... Args>
+    explicit Node(Args&&... args);
+    const Key& key() const;
+  };
+
+  using NodeAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+  Node* root_ = nullptr;
+  size_type size_ = 0;
+  NodeAllocator alloc_;
+  Compare comp_;
+
+ public:
+  // Only const iteration, values may be shared with other trees
+  class ConstIterator {
+    friend class PersistentAVLTree;
+
+   protected:
+    Node* root_;
+    // From the root down to the current node, empty for end()
+    std::vector<Node*> path_;
+
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename PersistentAVLTree::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    ConstIterator() noexcept;
+    explicit ConstIterator(Node* root) noexcept;
+
+    bool operator==(const ConstIterator& other) const;
+    bool operator!=(const ConstIterator& other) const;
+    const_reference operator*() const;
+    const value_type* operator->() const;
+    ConstIterator& operator++();
+    ConstIterator operator++(int);
+    ConstIterator& operator--();
+    ConstIterator operator--(int);
+  };
+
+  using iterator = ConstIterator;
+  using const_iterator = ConstIterator;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const;
+  const_iterator cend() const;
+
+  // Constructors. Copies share all nodes.
+  PersistentAVLTree();
+  explicit PersistentAVLTree(const Compare& comp,
+                             const Allocator& alloc = Allocator());
+  PersistentAVLTree(const PersistentAVLTree& other) noexcept;
+  PersistentAVLTree(PersistentAVLTree&& other) noexcept;
+  PersistentAVLTree& operator=(const PersistentAVLTree& other) noexcept;
+  PersistentAVLTree& operator=(PersistentAVLTree&& other) noexcept;
+  ~PersistentAVLTree();
+
+ protected:
+  static int height_of(Node* node);
+  static void update_height(Node* node);
+  static int balance_factor(Node* node);
+  static void retain(Node* node);
+  void release(Node* node);
+  template <typename... Args>
+  Node* create_node(Args&&... args);
+  // Returns node itself if this tree owns it alone, otherwise a private copy
+  // sharing its children. Takes over the caller's reference to node.
+  Node* own(Node* node);
+
+  // The functions below take over a reference to the subtree they get and
+  // return one to the subtree that replaces it
+  Node* left_rotate(Node* node);
+  Node* right_rotate(Node* node);
+  Node* balance_node(Node* node);
+  Node* insert_node(Node* node, Node* created);
+  // key must be present
+  template <typename K>
+  Node* erase_node(Node* node, const K& key);
+  Node* erase_min(Node* node, Node*& min);
+  // Owns every node from the root down to key, which must be present, and
+  // returns the owned node holding it
+  template <typename K>
+  Node* own_path(const K& key);
+
+  template <typename K>
+  Node* find_node(const K& key) const;
+  template <typename K>
+  const_iterator path_to(const K& key) const;
+  // First node whose key is not less (upper: greater) than key
+  template <typename K>
+  const_iterator lower_bound_path(const K& key) const;
+  template <typename K>
+  const_iterator upper_bound_path(const K& key) const;
+  // key is only looked up, args construct the stored value if it is missing
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> emplace_unique(const K& key, Args&&... args);
+
+ public:
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+
+  // Modifiers
+  void clear();
+  size_type erase(const Key& key);
+  void swap(PersistentAVLTree& other) noexcept;
+
+  // Lookup
+  bool contains(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const;
+  const_iterator lower_bound(const Key& key) const;
+  const_iterator upper_bound(const Key& key) const;
+  std::pair<const_iterator, const_iterator> equal_range(const Key& key) const;
+
+  // Observers
+  key_compare key_comp() const;
+  allocator_type get_allocator() const;
+};
+
+}  // namespace s21
+
+#include "PersistentAVLTree.tpp"
+
+#endif
@@ -0,0 +1,630 @@
+#ifndef S21_PERSISTENT_AVL_TREE_TPP
+#define S21_PERSISTENT_AVL_TREE_TPP
+
+#include "PersistentAVLTree.h"
+
+namespace s21 {
+
+// Node
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename... Args>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::Node::Node(Args&&... args)
+    : left(nullptr),
+      right(nullptr),
+      refs(1),
+      height(1),
+      value(std::forward<Args>(args)...) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+const Key& PersistentAVLTree<Key, Compare, Allocator, Policy>::Node::key()
+    const {
+  return Policy::key(value);
+}
+
+// ConstIterator
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::
+    ConstIterator() noexcept
+    : root_(nullptr) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::
+    ConstIterator(Node* root) noexcept
+    : root_(root) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::
+operator==(const ConstIterator& other) const {
+  return (path_.empty() ? nullptr : path_.back()) ==
+         (other.path_.empty() ? nullptr : other.path_.back());
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::
+operator!=(const ConstIterator& other) const {
+  return !(*this == other);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_reference
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator*()
+    const {
+  if (path_.empty()) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return path_.back()->value;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+const typename PersistentAVLTree<Key, Compare, Allocator, Policy>::value_type*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator->()
+    const {
+  return &**this;
+}
+
+// Down to the leftmost node of the right subtree, or up to the nearest
+// ancestor reached from its left
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator&
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::
+operator++() {
+  Node* node = path_.back();
+  if (node->right) {
+    for (node = node->right; node; node = node->left) {
+      path_.push_back(node);
+    }
+  } else {
+    path_.pop_back();
+    while (!path_.empty() && path_.back()->right == node) {
+      node = path_.back();
+      path_.pop_back();
+    }
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator++(
+    int) {
+  ConstIterator temp = *this;
+  ++*this;
+  return temp;
+}
+
+// From end() to the rightmost node
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator&
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::
+operator--() {
+  Node* node = path_.empty() ? nullptr : path_.back();
+  if (node == nullptr || node->left) {
+    for (node = node ? node->left : root_; node; node = node->right) {
+      path_.push_back(node);
+    }
+  } else {
+    path_.pop_back();
+    while (!path_.empty() && path_.back()->left == node) {
+      node = path_.back();
+      path_.pop_back();
+    }
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::ConstIterator::operator--(
+    int) {
+  ConstIterator temp = *this;
+  --*this;
+  return temp;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::begin() const {
+  const_iterator it(root_);
+  for (Node* node = root_; node; node = node->left) {
+    it.path_.push_back(node);
+  }
+  return it;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::end() const {
+  return const_iterator(root_);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::cbegin() const {
+  return begin();
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::cend() const {
+  return end();
+}
+
+// Constructors
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::PersistentAVLTree() {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::PersistentAVLTree(
+    const Compare& comp, const Allocator& alloc)
+    : alloc_(alloc), comp_(comp) {}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::PersistentAVLTree(
+    const PersistentAVLTree& other) noexcept
+    : root_(other.root_),
+      size_(other.size_),
+      alloc_(other.alloc_),
+      comp_(other.comp_) {
+  retain(root_);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::PersistentAVLTree(
+    PersistentAVLTree&& other) noexcept
+    : root_(other.root_),
+      size_(other.size_),
+      alloc_(std::move(other.alloc_)),
+      comp_(std::move(other.comp_)) {
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>&
+PersistentAVLTree<Key, Compare, Allocator, Policy>::operator=(
+    const PersistentAVLTree& other) noexcept {
+  retain(other.root_);
+  release(root_);
+  root_ = other.root_;
+  size_ = other.size_;
+  alloc_ = other.alloc_;
+  comp_ = other.comp_;
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>&
+PersistentAVLTree<Key, Compare, Allocator, Policy>::operator=(
+    PersistentAVLTree&& other) noexcept {
+  if (this != &other) {
+    release(root_);
+    root_ = other.root_;
+    size_ = other.size_;
+    alloc_ = std::move(other.alloc_);
+    comp_ = std::move(other.comp_);
+    other.root_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::~PersistentAVLTree() {
+  release(root_);
+}
+
+// Helpers
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+int PersistentAVLTree<Key, Compare, Allocator, Policy>::height_of(
+    Node* node) {
+  return node ? node->height : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void PersistentAVLTree<Key, Compare, Allocator, Policy>::update_height(
+    Node* node) {
+  node->height = static_cast<signed char>(
+      std::max(height_of(node->left), height_of(node->right)) + 1);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+int PersistentAVLTree<Key, Compare, Allocator, Policy>::balance_factor(
+    Node* node) {
+  return height_of(node->left) - height_of(node->right);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void PersistentAVLTree<Key, Compare, Allocator, Policy>::retain(Node* node) {
+  if (node) {
+    node->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+// The last reference frees the node and drops its references to the
+// children
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void PersistentAVLTree<Key, Compare, Allocator, Policy>::release(Node* node) {
+  if (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    release(node->left);
+    release(node->right);
+    NodeTraits::destroy(alloc_, node);
+    NodeTraits::deallocate(alloc_, node, 1);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename... Args>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::create_node(
+    Args&&... args) {
+  Node* node = NodeTraits::allocate(alloc_, 1);
+  try {
+    NodeTraits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    NodeTraits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+// If copying throws the caller keeps its reference. Callers store the result
+// over their link at once, so the tree is whole at every step.
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::own(Node* node) {
+  if (node->refs.load(std::memory_order_acquire) == 1) {
+    return node;
+  }
+  Node* copy = create_node(node->value);
+  copy->left = node->left;
+  copy->right = node->right;
+  copy->height = node->height;
+  retain(copy->left);
+  retain(copy->right);
+  release(node);
+  return copy;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::left_rotate(Node* node) {
+  node->right = own(node->right);
+  Node* right = node->right;
+  node->right = right->left;
+  right->left = node;
+  update_height(node);
+  update_height(right);
+  return right;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::right_rotate(Node* node) {
+  node->left = own(node->left);
+  Node* left = node->left;
+  node->left = left->right;
+  left->right = node;
+  update_height(node);
+  update_height(left);
+  return left;
+}
+
+// After an insertion the rotated nodes lie on the search path and are owned
+// already, after an erasure they may have to be copied
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::balance_node(Node* node) {
+  update_height(node);
+  int balance = balance_factor(node);
+
+  if (balance > 1) {
+    if (balance_factor(node->left) < 0) {
+      node->left = own(node->left);
+      node->left = left_rotate(node->left);
+    }
+    node = right_rotate(node);
+  } else if (balance < -1) {
+    if (balance_factor(node->right) > 0) {
+      node->right = own(node->right);
+      node->right = right_rotate(node->right);
+    }
+    node = left_rotate(node);
+  }
+
+  return node;
+}
+
+// node is owned, every node on the way down is owned before it is entered
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::insert_node(
+    Node* node, Node* created) {
+  if (comp_(created->key(), node->key())) {
+    if (node->left) {
+      node->left = own(node->left);
+      node->left = insert_node(node->left, created);
+    } else {
+      node->left = created;
+    }
+  } else {
+    if (node->right) {
+      node->right = own(node->right);
+      node->right = insert_node(node->right, created);
+    } else {
+      node->right = created;
+    }
+  }
+  return balance_node(node);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::erase_node(Node* node,
+                                                               const K& key) {
+  if (comp_(key, node->key())) {
+    node->left = own(node->left);
+    node->left = erase_node(node->left, key);
+  } else if (comp_(node->key(), key)) {
+    node->right = own(node->right);
+    node->right = erase_node(node->right, key);
+  } else {
+    // The node is owned, so releasing it frees it alone once its links are
+    // handed over. A lone child may be shared and is not touched.
+    Node* replacement = node->left ? node->left : node->right;
+    bool two_children = node->left && node->right;
+    if (two_children) {
+      node->right = own(node->right);
+      node->right = erase_min(node->right, replacement);
+      replacement->left = node->left;
+      replacement->right = node->right;
+    }
+    node->left = nullptr;
+    node->right = nullptr;
+    release(node);
+    --size_;
+    return two_children ? balance_node(replacement) : replacement;
+  }
+  return balance_node(node);
+}
+
+// Unlinks the leftmost node, which is owned, into min
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::erase_min(Node* node,
+                                                              Node*& min) {
+  if (node->left == nullptr) {
+    min = node;
+    Node* right = node->right;
+    node->right = nullptr;
+    return right;
+  }
+  node->left = own(node->left);
+  node->left = erase_min(node->left, min);
+  return balance_node(node);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::own_path(const K& key) {
+  root_ = own(root_);
+  Node* node = root_;
+  while (true) {
+    if (comp_(key, node->key())) {
+      node->left = own(node->left);
+      node = node->left;
+    } else if (comp_(node->key(), key)) {
+      node->right = own(node->right);
+      node = node->right;
+    } else {
+      return node;
+    }
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::Node*
+PersistentAVLTree<Key, Compare, Allocator, Policy>::find_node(
+    const K& key) const {
+  Node* node = root_;
+  while (node) {
+    if (comp_(key, node->key())) {
+      node = node->left;
+    } else if (comp_(node->key(), key)) {
+      node = node->right;
+    } else {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::path_to(
+    const K& key) const {
+  const_iterator it(root_);
+  Node* node = root_;
+  while (node) {
+    it.path_.push_back(node);
+    if (comp_(key, node->key())) {
+      node = node->left;
+    } else if (comp_(node->key(), key)) {
+      node = node->right;
+    } else {
+      return it;
+    }
+  }
+  return end();
+}
+
+// The path is cut back to the last node where the search went left
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::lower_bound_path(
+    const K& key) const {
+  const_iterator it(root_);
+  size_type keep = 0;
+  for (Node* node = root_; node;) {
+    it.path_.push_back(node);
+    if (comp_(node->key(), key)) {
+      node = node->right;
+    } else {
+      keep = it.path_.size();
+      node = node->left;
+    }
+  }
+  it.path_.resize(keep);
+  return it;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::upper_bound_path(
+    const K& key) const {
+  const_iterator it(root_);
+  size_type keep = 0;
+  for (Node* node = root_; node;) {
+    it.path_.push_back(node);
+    if (comp_(key, node->key())) {
+      keep = it.path_.size();
+      node = node->left;
+    } else {
+      node = node->right;
+    }
+  }
+  it.path_.resize(keep);
+  return it;
+}
+
+// The node is built first, args may refer to values of this tree. Only
+// own() may throw on the way down, and before the node is linked.
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename... Args>
+std::pair<typename PersistentAVLTree<Key, Compare, Allocator, Policy>::iterator,
+          bool>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::emplace_unique(
+    const K& key, Args&&... args) {
+  if (find_node(key)) {
+    return {path_to(key), false};
+  }
+  Node* created = create_node(std::forward<Args>(args)...);
+  if (root_ == nullptr) {
+    root_ = created;
+  } else {
+    try {
+      root_ = own(root_);
+      root_ = insert_node(root_, created);
+    } catch (...) {
+      release(created);
+      throw;
+    }
+  }
+  ++size_;
+  return {path_to(created->key()), true};
+}
+
+// Capacity
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool PersistentAVLTree<Key, Compare, Allocator, Policy>::empty() const {
+  return size_ == 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::size_type
+PersistentAVLTree<Key, Compare, Allocator, Policy>::size() const {
+  return size_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::size_type
+PersistentAVLTree<Key, Compare, Allocator, Policy>::max_size() const {
+  return NodeTraits::max_size(alloc_);
+}
+
+// Modifiers
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void PersistentAVLTree<Key, Compare, Allocator, Policy>::clear() {
+  release(root_);
+  root_ = nullptr;
+  size_ = 0;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::size_type
+PersistentAVLTree<Key, Compare, Allocator, Policy>::erase(const Key& key) {
+  if (find_node(key) == nullptr) {
+    return 0;
+  }
+  root_ = own(root_);
+  root_ = erase_node(root_, key);
+  return 1;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+void PersistentAVLTree<Key, Compare, Allocator, Policy>::swap(
+    PersistentAVLTree& other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(comp_, other.comp_);
+}
+
+// Lookup
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+bool PersistentAVLTree<Key, Compare, Allocator, Policy>::contains(
+    const Key& key) const {
+  return find_node(key) != nullptr;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+template <typename K, typename C, typename>
+bool PersistentAVLTree<Key, Compare, Allocator, Policy>::contains(
+    const K& key) const {
+  return find_node(key) != nullptr;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::lower_bound(
+    const Key& key) const {
+  return lower_bound_path(key);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator
+PersistentAVLTree<Key, Compare, Allocator, Policy>::upper_bound(
+    const Key& key) const {
+  return upper_bound_path(key);
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+std::pair<
+    typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator,
+    typename PersistentAVLTree<Key, Compare, Allocator, Policy>::const_iterator>
+PersistentAVLTree<Key, Compare, Allocator, Policy>::equal_range(
+    const Key& key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+// Observers
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::key_compare
+PersistentAVLTree<Key, Compare, Allocator, Policy>::key_comp() const {
+  return comp_;
+}
+
+template <typename Key, typename Compare, typename Allocator, typename Policy>
+typename PersistentAVLTree<Key, Compare, Allocator, Policy>::allocator_type
+PersistentAVLTree<Key, Compare, Allocator, Policy>::get_allocator() const {
+  return allocator_type(alloc_);
+}
+
+}  // namespace s21
+
+#endif
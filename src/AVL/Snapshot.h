@@ -0,0 +1,160 @@
+#ifndef S21_SNAPSHOT_H
+#define S21_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+
+// Binary snapshot of an ordered container, in native byte order:
+//
+//   SnapshotHeader     32 bytes, the record sizes and the record count
+//   count records      the values in key order, key bytes then mapped bytes
+//   checksum           8 bytes, SnapshotChecksum of the records
+//
+// Only trivially copyable keys and mapped values can be stored; their bytes
+// are written as they are, so a snapshot is only portable between builds
+// with the same layout of those types.
+struct SnapshotHeader {
+  static constexpr char kMagic[8] = "s21snap";
+  static constexpr std::uint32_t kVersion = 1;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t key_size;
+  std::uint32_t mapped_size;
+  std::uint32_t reserved;
+  std::uint64_t count;
+
+  static SnapshotHeader make(std::uint32_t key_size, std::uint32_t mapped_size,
+                             std::uint64_t count);
+  // Throws std::runtime_error unless the header belongs to a snapshot of
+  // records of these sizes
+  void check(std::uint32_t key_size, std::uint32_t mapped_size) const;
+};
+
+static_assert(sizeof(SnapshotHeader) == 32, "SnapshotHeader is padded");
+
+// Word-wise FNV-1a with an extra xorshift. Every step is a bijection of the
+// state, so a change of a single word is always detected.
+class SnapshotChecksum {
+ public:
+  explicit SnapshotChecksum(std::uint64_t seed) noexcept;
+  void update(const unsigned char* data, std::size_t size) noexcept;
+  std::uint64_t value() const noexcept;
+
+ private:
+  std::uint64_t state_;
+};
+
+// How a value is laid out as a record
+template <typename V>
+struct SnapshotRecord {
+  static constexpr bool kSupported = std::is_trivially_copyable<V>::value;
+  static constexpr std::uint32_t kKeySize = sizeof(V);
+  static constexpr std::uint32_t kMappedSize = 0;
+  static constexpr std::size_t kSize = sizeof(V);
+
+  static void store(const V& value, unsigned char* record);
+  // Returns make(value)
+  template <typename Make>
+  static auto load(const unsigned char* record, Make make);
+};
+
+template <typename K, typename T>
+struct SnapshotRecord<std::pair<const K, T>> {
+  static constexpr bool kSupported = std::is_trivially_copyable<K>::value &&
+                                     std::is_trivially_copyable<T>::value;
+  static constexpr std::uint32_t kKeySize = sizeof(K);
+  static constexpr std::uint32_t kMappedSize = sizeof(T);
+  static constexpr std::size_t kSize = sizeof(K) + sizeof(T);
+
+  static void store(const std::pair<const K, T>& value,
+                    unsigned char* record);
+  // Returns make(key, mapped)
+  template <typename Make>
+  static auto load(const unsigned char* record, Make make);
+};
+
+// Buffers what is written to out, flush() passes it on
+class SnapshotWriter {
+ public:
+  static constexpr std::size_t kBufferSize = 1 << 16;
+
+  explicit SnapshotWriter(std::ostream& out);
+  void write(const void* data, std::size_t size);
+  // Throws std::runtime_error if out has failed
+  void flush();
+
+ private:
+  std::ostream& out_;
+  std::vector<unsigned char> buffer_;
+};
+
+// The readers hand out the next size bytes of a snapshot, valid until the
+// next read. expect(size) announces that the snapshot has size bytes left.
+// Both throw std::runtime_error if the snapshot ends early.
+
+// A snapshot that is in memory already
+class SnapshotMemoryReader {
+ public:
+  SnapshotMemoryReader(const unsigned char* data, std::size_t size) noexcept;
+  const unsigned char* read(std::size_t size);
+  // Throws as well if more than size bytes are left
+  void expect(std::size_t size);
+
+ private:
+  const unsigned char* data_;
+  std::size_t size_;
+};
+
+// Reads from in in blocks, but never past the end of the snapshot
+class SnapshotStreamReader {
+ public:
+  static constexpr std::size_t kBufferSize = 1 << 16;
+
+  explicit SnapshotStreamReader(std::istream& in);
+  const unsigned char* read(std::size_t size);
+  void expect(std::size_t size);
+
+ private:
+  std::istream& in_;
+  std::vector<unsigned char> buffer_;
+  std::size_t begin_ = 0;
+  std::size_t end_ = 0;
+  // Bytes of the snapshot not yet read from in
+  std::size_t left_;
+};
+
+// A whole file as read-only memory. It is mapped where mmap is available
+// and read into a buffer elsewhere.
+class MappedFile {
+ public:
+  // Throws std::runtime_error if path can not be opened
+  explicit MappedFile(const std::string& path);
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile& operator=(const MappedFile& other) = delete;
+  ~MappedFile();
+
+  const unsigned char* data() const noexcept;
+  std::size_t size() const noexcept;
+
+ private:
+  const unsigned char* data_ = nullptr;
+  std::size_t size_ = 0;
+#if !defined(__unix__) && !defined(__APPLE__)
+  std::vector<unsigned char> buffer_;
+#endif
+};
+
+}  // namespace s21
+
+#include "Snapshot.tpp"
+
+#endif
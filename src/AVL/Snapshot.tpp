@@ -0,0 +1,232 @@
+#ifndef S21_SNAPSHOT_TPP
+#define S21_SNAPSHOT_TPP
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Snapshot.h"
+
+namespace s21 {
+
+// SnapshotHeader
+inline SnapshotHeader SnapshotHeader::make(std::uint32_t key_size,
+                                           std::uint32_t mapped_size,
+                                           std::uint64_t count) {
+  SnapshotHeader header;
+  std::memcpy(header.magic, kMagic, sizeof(header.magic));
+  header.version = kVersion;
+  header.key_size = key_size;
+  header.mapped_size = mapped_size;
+  header.reserved = 0;
+  header.count = count;
+  return header;
+}
+
+inline void SnapshotHeader::check(std::uint32_t key_size,
+                                  std::uint32_t mapped_size) const {
+  if (std::memcmp(magic, kMagic, sizeof(magic)) != 0) {
+    throw std::runtime_error("Not a snapshot");
+  }
+  if (version != kVersion) {
+    throw std::runtime_error("Unsupported snapshot version");
+  }
+  if (this->key_size != key_size || this->mapped_size != mapped_size) {
+    throw std::runtime_error("Snapshot of a different value type");
+  }
+}
+
+// SnapshotChecksum
+inline SnapshotChecksum::SnapshotChecksum(std::uint64_t seed) noexcept
+    : state_(0xcbf29ce484222325ull ^ seed) {}
+
+inline void SnapshotChecksum::update(const unsigned char* data,
+                                     std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; i += sizeof(std::uint64_t)) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, data + i, std::min(sizeof(word), size - i));
+    state_ = (state_ ^ word) * 0x100000001b3ull;
+    state_ ^= state_ >> 29;
+  }
+}
+
+inline std::uint64_t SnapshotChecksum::value() const noexcept {
+  return state_;
+}
+
+// SnapshotRecord
+template <typename V>
+void SnapshotRecord<V>::store(const V& value, unsigned char* record) {
+  std::memcpy(record, &value, sizeof(V));
+}
+
+template <typename V>
+template <typename Make>
+auto SnapshotRecord<V>::load(const unsigned char* record, Make make) {
+  alignas(V) unsigned char value[sizeof(V)];
+  std::memcpy(value, record, sizeof(V));
+  return make(*std::launder(reinterpret_cast<const V*>(value)));
+}
+
+template <typename K, typename T>
+void SnapshotRecord<std::pair<const K, T>>::store(
+    const std::pair<const K, T>& value, unsigned char* record) {
+  std::memcpy(record, &value.first, sizeof(K));
+  std::memcpy(record + sizeof(K), &value.second, sizeof(T));
+}
+
+template <typename K, typename T>
+template <typename Make>
+auto SnapshotRecord<std::pair<const K, T>>::load(const unsigned char* record,
+                                                 Make make) {
+  alignas(K) unsigned char key[sizeof(K)];
+  alignas(T) unsigned char mapped[sizeof(T)];
+  std::memcpy(key, record, sizeof(K));
+  std::memcpy(mapped, record + sizeof(K), sizeof(T));
+  return make(*std::launder(reinterpret_cast<const K*>(key)),
+              *std::launder(reinterpret_cast<const T*>(mapped)));
+}
+
+// SnapshotWriter
+inline SnapshotWriter::SnapshotWriter(std::ostream& out) : out_(out) {
+  buffer_.reserve(kBufferSize);
+}
+
+inline void SnapshotWriter::write(const void* data, std::size_t size) {
+  if (buffer_.size() + size > kBufferSize) {
+    flush();
+  }
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  buffer_.insert(buffer_.end(), bytes, bytes + size);
+}
+
+inline void SnapshotWriter::flush() {
+  out_.write(reinterpret_cast<const char*>(buffer_.data()),
+             static_cast<std::streamsize>(buffer_.size()));
+  buffer_.clear();
+  if (!out_) {
+    throw std::runtime_error("Cannot write snapshot");
+  }
+}
+
+// SnapshotMemoryReader
+inline SnapshotMemoryReader::SnapshotMemoryReader(const unsigned char* data,
+                                                  std::size_t size) noexcept
+    : data_(data), size_(size) {}
+
+inline const unsigned char* SnapshotMemoryReader::read(std::size_t size) {
+  if (size > size_) {
+    throw std::runtime_error("Snapshot is truncated");
+  }
+  const unsigned char* bytes = data_;
+  data_ += size;
+  size_ -= size;
+  return bytes;
+}
+
+inline void SnapshotMemoryReader::expect(std::size_t size) {
+  if (size < size_) {
+    throw std::runtime_error("Snapshot has trailing bytes");
+  }
+  if (size > size_) {
+    throw std::runtime_error("Snapshot is truncated");
+  }
+}
+
+// SnapshotStreamReader
+inline SnapshotStreamReader::SnapshotStreamReader(std::istream& in)
+    : in_(in), buffer_(kBufferSize), left_(sizeof(SnapshotHeader)) {}
+
+inline const unsigned char* SnapshotStreamReader::read(std::size_t size) {
+  if (end_ - begin_ < size) {
+    std::size_t kept = end_ - begin_;
+    std::memmove(buffer_.data(), buffer_.data() + begin_, kept);
+    if (buffer_.size() < size) {
+      buffer_.resize(size);
+    }
+    std::size_t wanted = std::min(buffer_.size() - kept, left_);
+    in_.read(reinterpret_cast<char*>(buffer_.data() + kept),
+             static_cast<std::streamsize>(wanted));
+    std::size_t got = static_cast<std::size_t>(in_.gcount());
+    left_ -= got;
+    begin_ = 0;
+    end_ = kept + got;
+    if (end_ < size) {
+      throw std::runtime_error("Snapshot is truncated");
+    }
+  }
+  const unsigned char* bytes = buffer_.data() + begin_;
+  begin_ += size;
+  return bytes;
+}
+
+inline void SnapshotStreamReader::expect(std::size_t size) {
+  left_ = size - std::min(size, end_ - begin_);
+}
+
+// MappedFile
+#if defined(__unix__) || defined(__APPLE__)
+
+inline MappedFile::MappedFile(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || ::fstat(fd, &info) != 0) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    throw std::runtime_error("Cannot open " + path);
+  }
+  size_ = static_cast<std::size_t>(info.st_size);
+  if (size_ > 0) {
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Cannot map " + path);
+    }
+    ::madvise(address, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const unsigned char*>(address);
+  }
+  ::close(fd);
+}
+
+inline MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<unsigned char*>(data_), size_);
+  }
+}
+
+#else
+
+inline MappedFile::MappedFile(const std::string& path) {
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in) {
+    throw std::runtime_error("Cannot open " + path);
+  }
+  buffer_.resize(static_cast<std::size_t>(in.tellg()));
+  in.seekg(0);
+  in.read(reinterpret_cast<char*>(buffer_.data()),
+          static_cast<std::streamsize>(buffer_.size()));
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+}
+
+inline MappedFile::~MappedFile() {}
+
+#endif
+
+inline const unsigned char* MappedFile::data() const noexcept { return data_; }
+
+inline std::size_t MappedFile::size() const noexcept { return size_; }
+
+}  // namespace s21
+
+#endif
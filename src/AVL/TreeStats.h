@@ -0,0 +1,85 @@
+#ifndef S21_TREE_STATS_H
+#define S21_TREE_STATS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace s21 {
+
+// What a tree has done since it was created or since reset_stats()
+struct TreeStats {
+  std::uint64_t comparisons = 0;
+  std::uint64_t left_rotations = 0;
+  std::uint64_t right_rotations = 0;
+  std::uint64_t allocations = 0;
+  std::uint64_t deallocations = 0;
+  // Most nodes compared by a single descent from the root
+  std::uint64_t max_depth = 0;
+};
+
+// Counters of a tree. Parallel set algebra counts from worker threads, so
+// they are relaxed atomics. A copy starts from zero.
+class CountingTreeStats {
+ public:
+  CountingTreeStats() noexcept = default;
+  CountingTreeStats(const CountingTreeStats& other) noexcept;
+  CountingTreeStats& operator=(const CountingTreeStats& other) noexcept;
+
+  void count_comparison() noexcept;
+  void count_left_rotation() noexcept;
+  void count_right_rotation() noexcept;
+  void count_allocations(std::uint64_t n = 1) noexcept;
+  void count_deallocations(std::uint64_t n = 1) noexcept;
+  void record_depth(std::uint64_t depth) noexcept;
+  TreeStats get() const noexcept;
+  void reset() noexcept;
+
+ private:
+  std::atomic<std::uint64_t> comparisons_{0};
+  std::atomic<std::uint64_t> left_rotations_{0};
+  std::atomic<std::uint64_t> right_rotations_{0};
+  std::atomic<std::uint64_t> allocations_{0};
+  std::atomic<std::uint64_t> deallocations_{0};
+  std::atomic<std::uint64_t> max_depth_{0};
+};
+
+// Same interface, counts nothing. Being empty it only takes a byte, which
+// fits in the padding after the tree's comparator.
+class NullTreeStats {
+ public:
+  void count_comparison() noexcept {}
+  void count_left_rotation() noexcept {}
+  void count_right_rotation() noexcept {}
+  void count_allocations(std::uint64_t = 1) noexcept {}
+  void count_deallocations(std::uint64_t = 1) noexcept {}
+  void record_depth(std::uint64_t) noexcept {}
+  TreeStats get() const noexcept { return TreeStats(); }
+  void reset() noexcept {}
+};
+
+// Counting is opt-in, without S21_CONTAINERS_STATS stats() reports zeros.
+// The trees and the containers built on them are declared in between
+// S21_STATS_NAMESPACE_BEGIN and END. With the macro that is an inline
+// namespace, so a counting set<int> is a different type from a plain one
+// and translation units built with and without it can be linked together.
+#if defined(S21_CONTAINERS_STATS)
+#define S21_STATS_NAMESPACE_BEGIN inline namespace counted {
+#define S21_STATS_NAMESPACE_END }
+#else
+#define S21_STATS_NAMESPACE_BEGIN
+#define S21_STATS_NAMESPACE_END
+#endif
+
+S21_STATS_NAMESPACE_BEGIN
+#if defined(S21_CONTAINERS_STATS)
+using TreeStatsCounters = CountingTreeStats;
+#else
+using TreeStatsCounters = NullTreeStats;
+#endif
+S21_STATS_NAMESPACE_END
+
+}  // namespace s21
+
+#include "TreeStats.tpp"
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef S21_TREE_STATS_TPP
+#define S21_TREE_STATS_TPP
+
+#include "TreeStats.h"
+
+namespace s21 {
+
+inline CountingTreeStats::CountingTreeStats(
+    const CountingTreeStats&) noexcept {}
+
+inline CountingTreeStats& CountingTreeStats::operator=(
+    const CountingTreeStats&) noexcept {
+  return *this;
+}
+
+inline void CountingTreeStats::count_comparison() noexcept {
+  comparisons_.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CountingTreeStats::count_left_rotation() noexcept {
+  left_rotations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CountingTreeStats::count_right_rotation() noexcept {
+  right_rotations_.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void CountingTreeStats::count_allocations(std::uint64_t n) noexcept {
+  allocations_.fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void CountingTreeStats::count_deallocations(std::uint64_t n) noexcept {
+  deallocations_.fetch_add(n, std::memory_order_relaxed);
+}
+
+inline void CountingTreeStats::record_depth(std::uint64_t depth) noexcept {
+  std::uint64_t max = max_depth_.load(std::memory_order_relaxed);
+  while (depth > max && !max_depth_.compare_exchange_weak(
+                            max, depth, std::memory_order_relaxed)) {
+  }
+}
+
+inline TreeStats CountingTreeStats::get() const noexcept {
+  TreeStats stats;
+  stats.comparisons = comparisons_.load(std::memory_order_relaxed);
+  stats.left_rotations = left_rotations_.load(std::memory_order_relaxed);
+  stats.right_rotations = right_rotations_.load(std::memory_order_relaxed);
+  stats.allocations = allocations_.load(std::memory_order_relaxed);
+  stats.deallocations = deallocations_.load(std::memory_order_relaxed);
+  stats.max_depth = max_depth_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+inline void CountingTreeStats::reset() noexcept {
+  comparisons_.store(0, std::memory_order_relaxed);
+  left_rotations_.store(0, std::memory_order_relaxed);
+  right_rotations_.store(0, std::memory_order_relaxed);
+  allocations_.store(0, std::memory_order_relaxed);
+  deallocations_.store(0, std::memory_order_relaxed);
+  max_depth_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace s21
+
+#endif
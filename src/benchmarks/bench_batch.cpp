@@ -0,0 +1,98 @@
+// Sequential contains()/find() against contains_batch()/find_batch() on
+// set<uint64_t> and map<uint64_t, uint64_t> with random keys, half of them
+// present, in ns per lookup. Sizes from 10^4 up to 10^max_exponent; with
+// 40-byte nodes 10^7 keys are well beyond a 100 MiB last-level cache.
+//   make bench
+//   ./benchmarks/bench_batch 7
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../s21_containers.h"
+
+namespace {
+
+using Key = std::uint64_t;
+
+constexpr std::size_t kLookups = 1000000;
+
+std::vector<Key> random_keys(std::size_t count, Key state) {
+  std::vector<Key> keys(count);
+  for (Key& key : keys) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    key = state >> 1;
+  }
+  return keys;
+}
+
+template <typename F>
+double ns_per_lookup(F&& run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         kLookups;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int max_exponent = argc > 1 ? std::atoi(argv[1]) : 6;
+  std::printf("ns per lookup, %zu lookups\n", kLookups);
+  std::size_t size = 10000;
+  for (int exponent = 4; exponent <= max_exponent; ++exponent) {
+    auto stored = random_keys(size, 42);
+    // Every other lookup hits
+    auto lookups = random_keys(kLookups, 7);
+    for (std::size_t i = 0; i < lookups.size(); i += 2) {
+      lookups[i] = stored[lookups[i] % size];
+    }
+
+    s21::set<Key> s;
+    s21::map<Key, Key> m;
+    for (Key key : stored) {
+      s.insert(key);
+      m.insert(key, key);
+    }
+
+    std::size_t found = 0;
+    double sequential = ns_per_lookup([&] {
+      for (Key key : lookups) {
+        found += s.contains(key);
+      }
+    });
+    std::vector<bool> contained(kLookups);
+    double batched = ns_per_lookup([&] {
+      s.contains_batch(lookups.begin(), lookups.end(), contained.begin());
+    });
+    for (bool hit : contained) {
+      found += hit;
+    }
+    std::printf("10^%d\n", exponent);
+    std::printf("  set contains  %7.1f  batch %7.1f  x%.2f\n", sequential,
+                batched, sequential / batched);
+
+    std::vector<s21::map<Key, Key>::iterator> iterators(kLookups);
+    sequential = ns_per_lookup([&] {
+      for (std::size_t i = 0; i < kLookups; ++i) {
+        iterators[i] = m.find(lookups[i]);
+      }
+    });
+    for (auto it : iterators) {
+      found += it != m.end();
+    }
+    batched = ns_per_lookup([&] {
+      m.find_batch(lookups.begin(), lookups.end(), iterators.begin());
+    });
+    for (auto it : iterators) {
+      found += it != m.end();
+    }
+    std::printf("  map find      %7.1f  batch %7.1f  x%.2f  (%zu)\n",
+                sequential, batched, sequential / batched, found);
+    size *= 10;
+  }
+  return 0;
+}
@@ -0,0 +1,83 @@
+// map against btree_map with uint64_t keys from 10^3 elements up: random
+// inserts, random lookups and a full scan, in ns per element. The largest
+// size is 10^max_exponent; 10^8 needs about 5 GiB for map.
+//   make bench
+//   ./benchmarks/bench_btree 8
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+using Key = std::uint64_t;
+
+std::vector<Key> random_keys(std::size_t count, Key state) {
+  std::vector<Key> keys(count);
+  for (Key& key : keys) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    key = state >> 1;
+  }
+  return keys;
+}
+
+template <typename F>
+double ns_per_element(std::size_t count, F&& run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         count;
+}
+
+template <typename Map>
+void run(const char* name, const std::vector<Key>& keys,
+         const std::vector<Key>& probes) {
+  Map m;
+  double insert = ns_per_element(keys.size(), [&] {
+    for (Key key : keys) {
+      m.insert(key, key);
+    }
+  });
+  Key found = 0;
+  double lookup = ns_per_element(probes.size(), [&] {
+    for (Key key : probes) {
+      found += m.contains(key);
+    }
+  });
+  Key sum = 0;
+  double scan = ns_per_element(m.size(), [&] {
+    for (const auto& item : m) {
+      sum += item.second;
+    }
+  });
+  std::printf("  %-16s insert %7.1f  lookup %7.1f  scan %6.1f  (%llu)\n",
+              name, insert, lookup, scan,
+              static_cast<unsigned long long>(found + (sum & 1)));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int max_exponent = argc > 1 ? std::atoi(argv[1]) : 6;
+  std::printf("ns per element\n");
+  std::size_t size = 1000;
+  for (int exponent = 3; exponent <= max_exponent; ++exponent) {
+    auto keys = random_keys(size, 42);
+    // Half of the probes hit
+    auto probes = random_keys(size, 7);
+    for (std::size_t i = 0; i < size; i += 2) {
+      probes[i] = keys[i];
+    }
+    std::printf("10^%d\n", exponent);
+    run<s21::map<Key, Key>>("s21::map", keys, probes);
+    run<s21::btree_map<Key, Key>>("s21::btree_map", keys, probes);
+    size *= 10;
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+// map against compact_map with 1M uint64_t keys: resident growth, measured
+// in a forked child per container, and random lookups. Linux only.
+//   make bench
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+constexpr int kSize = 1000000;
+constexpr int kLookups = 1000000;
+
+long resident_bytes() {
+  long total = 0;
+  long resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> total >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+std::vector<std::uint64_t> number_keys(int count, std::uint64_t state) {
+  std::vector<std::uint64_t> keys(count);
+  for (auto& key : keys) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    key = state % (4ull * kSize);
+  }
+  return keys;
+}
+
+template <typename Map>
+void run(const char* name, const std::vector<std::uint64_t>& keys,
+         const std::vector<std::uint64_t>& probes) {
+  std::fflush(stdout);
+  pid_t child = fork();
+  if (child == 0) {
+    long before = resident_bytes();
+    Map m;
+    for (std::uint64_t key : keys) {
+      m[key] = key;
+    }
+    long grown = resident_bytes() - before;
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t found = 0;
+    for (std::uint64_t key : probes) {
+      found += m.contains(key);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+
+    std::printf("%-28s %5.1f bytes per key  %7.1f ms lookups (%llu hits)\n",
+                name, static_cast<double>(grown) / m.size(), ms,
+                static_cast<unsigned long long>(found));
+    std::fflush(stdout);
+    _exit(0);
+  }
+  waitpid(child, nullptr, 0);
+}
+
+}  // namespace
+
+int main() {
+  auto keys = number_keys(kSize, 42);
+  auto probes = number_keys(kLookups, 7);
+  std::printf("%d inserts, %d lookups\n", kSize, kLookups);
+  using Key = std::uint64_t;
+  run<s21::map<Key, Key>>("s21::map<uint64_t>", keys, probes);
+  run<s21::compact_map<Key, Key>>("s21::compact_map<uint64_t>", keys, probes);
+  return 0;
+}
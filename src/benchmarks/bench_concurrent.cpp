@@ -0,0 +1,115 @@
+// Throughput of concurrent_map against s21::map behind a std::mutex, with
+// 1 up to max_threads threads on 10^5 uint64_t keys. Each thread runs for
+// ms milliseconds; reads are contains(), writes an insert or an erase.
+// Read shares of 90%, 50% and 10%.
+//   make bench
+//   ./benchmarks/bench_concurrent 64 100
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+using Key = std::uint64_t;
+
+constexpr Key kKeys = 100000;
+
+// Keeps the lookups from being optimized away
+std::atomic<std::uint64_t> hits{0};
+
+struct LockedMap {
+  std::mutex mutex;
+  s21::map<Key, Key> map;
+
+  bool contains(Key key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return map.contains(key);
+  }
+  void insert(Key key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    map.insert(key, key);
+  }
+  void erase(Key key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    map.erase(key);
+  }
+};
+
+struct ConcurrentMap {
+  s21::concurrent_map<Key, Key> map;
+
+  bool contains(Key key) { return map.contains(key); }
+  void insert(Key key) { map.insert(key, key); }
+  void erase(Key key) { map.erase(key); }
+};
+
+// Million operations per second over all threads
+template <typename M>
+double run(int threads, unsigned read_percent, int ms) {
+  M m;
+  for (Key key = 0; key < kKeys; key += 2) {
+    m.insert(key);
+  }
+  std::atomic<bool> stop{false};
+  std::atomic<std::uint64_t> total{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&m, &stop, &total, read_percent, t] {
+      Key state = 0x9e3779b97f4a7c15ull * (t + 1);
+      std::uint64_t ops = 0;
+      std::uint64_t found = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < 64; ++i) {
+          state = state * 6364136223846793005ull + 1442695040888963407ull;
+          Key key = (state >> 33) % kKeys;
+          unsigned roll = (state >> 20) % 100;
+          if (roll < read_percent) {
+            found += m.contains(key);
+          } else if (roll % 2 == 0) {
+            m.insert(key);
+          } else {
+            m.erase(key);
+          }
+        }
+        ops += 64;
+      }
+      total += ops;
+      hits += found;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  stop = true;
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+  return total.load() / (ms * 1000.0);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int max_threads = argc > 1 ? std::atoi(argv[1]) : 64;
+  int ms = argc > 2 ? std::atoi(argv[2]) : 100;
+  std::printf("Mops/s, %u hardware threads\n",
+              std::thread::hardware_concurrency());
+  for (unsigned read_percent : {90u, 50u, 10u}) {
+    std::printf("%u%% reads\n", read_percent);
+    std::printf("  %7s %16s %16s\n", "threads", "mutex + map",
+                "concurrent_map");
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+      double locked = run<LockedMap>(threads, read_percent, ms);
+      double concurrent = run<ConcurrentMap>(threads, read_percent, ms);
+      std::printf("  %7d %16.2f %16.2f\n", threads, locked, concurrent);
+    }
+  }
+  return 0;
+}
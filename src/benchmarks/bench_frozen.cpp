@@ -0,0 +1,85 @@
+// set against its frozen_set snapshot with uint64_t keys from 10^3 elements
+// up: lookups that hit and lookups that miss, in ns per lookup. The largest
+// size is 10^max_exponent.
+//   make bench
+//   ./benchmarks/bench_frozen 7
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+using Key = std::uint64_t;
+
+// Odd keys are stored, even keys miss
+std::vector<Key> random_keys(std::size_t count, Key state, Key parity) {
+  std::vector<Key> keys(count);
+  for (Key& key : keys) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    key = (state >> 1) | 1;
+    key ^= parity;
+  }
+  return keys;
+}
+
+template <typename F>
+double ns_per_element(std::size_t count, F&& run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         count;
+}
+
+template <typename Set>
+void run(const char* name, Set& s, const std::vector<Key>& hits,
+         const std::vector<Key>& misses) {
+  Key found = 0;
+  double hit = ns_per_element(hits.size(), [&] {
+    for (Key key : hits) {
+      found += s.contains(key);
+    }
+  });
+  double miss = ns_per_element(misses.size(), [&] {
+    for (Key key : misses) {
+      found += s.contains(key);
+    }
+  });
+  std::printf("  %-18s hit %7.1f  miss %7.1f  (%llu)\n", name, hit, miss,
+              static_cast<unsigned long long>(found));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int max_exponent = argc > 1 ? std::atoi(argv[1]) : 6;
+  std::printf("ns per lookup\n");
+  std::size_t size = 1000;
+  for (int exponent = 3; exponent <= max_exponent; ++exponent) {
+    auto keys = random_keys(size, 42, 0);
+    // The stored keys in another order, and keys next to them
+    auto hits = random_keys(size, 42, 0);
+    for (std::size_t i = 0; i + 1 < size; i += 2) {
+      std::swap(hits[i], hits[size - 1 - i]);
+    }
+    auto misses = random_keys(size, 42, 1);
+
+    s21::set<Key> s;
+    for (Key key : keys) {
+      s.insert(key);
+    }
+    s21::frozen_set<Key> frozen = s.freeze();
+    std::printf("10^%d\n", exponent);
+    run("s21::set", s, hits, misses);
+    run("s21::frozen_set", frozen, hits, misses);
+    size *= 10;
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Hinted vs plain insertion into s21::map for sorted and nearly sorted
+// streams of timestamps.
+//   make bench
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../s21_containers.h"
+
+namespace {
+
+constexpr int kSize = 1000000;
+
+// Best of three runs
+template <typename F>
+double measure_ms(F&& run) {
+  double best = 0;
+  for (int i = 0; i < 3; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto stop = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    if (i == 0 || ms < best) {
+      best = ms;
+    }
+  }
+  return best;
+}
+
+std::vector<long> sorted_stream() {
+  std::vector<long> keys(kSize);
+  for (int i = 0; i < kSize; ++i) {
+    keys[i] = 1000L * i;
+  }
+  return keys;
+}
+
+// Every 16th pair of neighbours arrives swapped
+std::vector<long> nearly_sorted_stream() {
+  std::vector<long> keys = sorted_stream();
+  unsigned state = 42;
+  for (int i = 0; i + 1 < kSize; ++i) {
+    state = state * 1103515245u + 12345u;
+    if ((state >> 8) % 16 == 0) {
+      std::swap(keys[i], keys[i + 1]);
+    }
+  }
+  return keys;
+}
+
+// Timestamps with a common prefix, so every comparison scans a few bytes
+std::vector<std::string> string_stream() {
+  std::vector<std::string> keys;
+  keys.reserve(kSize);
+  for (long key : nearly_sorted_stream()) {
+    std::string digits = std::to_string(key);
+    keys.push_back("2026-10-17T" + std::string(12 - digits.size(), '0') +
+                   digits);
+  }
+  return keys;
+}
+
+template <typename Key>
+void run(const char* name, const std::vector<Key>& keys) {
+  double plain = measure_ms([&] {
+    s21::map<Key, int> m;
+    for (const Key& key : keys) {
+      m.insert(key, 0);
+    }
+  });
+  double hinted = measure_ms([&] {
+    s21::map<Key, int> m;
+    auto hint = m.end();
+    for (const Key& key : keys) {
+      hint = m.insert(hint, {key, 0});
+    }
+  });
+  double std_hinted = measure_ms([&] {
+    std::map<Key, int> m;
+    auto hint = m.end();
+    for (const Key& key : keys) {
+      hint = m.insert(hint, {key, 0});
+    }
+  });
+
+  std::printf("%-14s plain %7.1f ms  hinted %7.1f ms (x%.2f)  std %7.1f ms\n",
+              name, plain, hinted, plain / hinted, std_hinted);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%d inserts\n", kSize);
+  run("sorted", sorted_stream());
+  run("nearly sorted", nearly_sorted_stream());
+  run("string keys", string_stream());
+  return 0;
+}
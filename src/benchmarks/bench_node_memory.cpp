@@ -0,0 +1,80 @@
+// Resident memory of a set of 1M keys, measured from /proc/self/statm in a
+// forked child per container so that freed memory of one run does not hide
+// the growth of the next. Linux only.
+//   make bench
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+
+namespace {
+
+constexpr int kSize = 1000000;
+
+long resident_bytes() {
+  long total = 0;
+  long resident = 0;
+  std::ifstream statm("/proc/self/statm");
+  statm >> total >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+std::vector<std::uint64_t> number_keys() {
+  std::vector<std::uint64_t> keys(kSize);
+  std::uint64_t state = 42;
+  for (auto& key : keys) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    key = state;
+  }
+  return keys;
+}
+
+// Short enough for the small string buffer, so only nodes are allocated
+std::vector<std::string> string_keys() {
+  std::vector<std::string> keys;
+  keys.reserve(kSize);
+  for (std::uint64_t key : number_keys()) {
+    keys.push_back(std::to_string(key % 100000000000000ull));
+  }
+  return keys;
+}
+
+template <typename Set, typename Key>
+void run(const char* name, const std::vector<Key>& keys) {
+  std::fflush(stdout);
+  pid_t child = fork();
+  if (child == 0) {
+    long before = resident_bytes();
+    Set s;
+    for (const Key& key : keys) {
+      s.insert(key);
+    }
+    long grown = resident_bytes() - before;
+    std::printf("%-24s %7.1f MiB  %5.1f bytes per key\n", name,
+                grown / 1048576.0, static_cast<double>(grown) / s.size());
+    std::fflush(stdout);
+    _exit(0);
+  }
+  waitpid(child, nullptr, 0);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%d keys, resident growth\n", kSize);
+  auto numbers = number_keys();
+  run<s21::set<std::uint64_t>>("s21::set<uint64_t>", numbers);
+  run<std::set<std::uint64_t>>("std::set<uint64_t>", numbers);
+  auto strings = string_keys();
+  run<s21::set<std::string>>("s21::set<std::string>", strings);
+  run<std::set<std::string>>("std::set<std::string>", strings);
+  return 0;
+}
@@ -0,0 +1,88 @@
+// Taking a point-in-time copy of a map with uint64_t keys: the deep copy of
+// s21::map against persistent_map::snapshot(), and the price persistence
+// adds to inserts while a snapshot is alive. Sizes from 10^3 up to
+// 10^max_exponent.
+//   make bench
+//   ./benchmarks/bench_persistent 6
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+using Key = std::uint64_t;
+
+std::vector<Key> random_keys(std::size_t count, Key state) {
+  std::vector<Key> keys(count);
+  for (Key& key : keys) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    key = state >> 1;
+  }
+  return keys;
+}
+
+template <typename F>
+double ns_per_element(std::size_t count, F&& run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         count;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int max_exponent = argc > 1 ? std::atoi(argv[1]) : 6;
+  std::printf("copy in ns per copy, insert in ns per element\n");
+  std::size_t size = 1000;
+  for (int exponent = 3; exponent <= max_exponent; ++exponent) {
+    auto keys = random_keys(size, 42);
+    auto more = random_keys(size, 7);
+    std::printf("10^%d\n", exponent);
+
+    s21::map<Key, Key> m;
+    double insert = ns_per_element(size, [&] {
+      for (Key key : keys) {
+        m.insert(key, key);
+      }
+    });
+    std::size_t copies = 0;
+    double copy = ns_per_element(1, [&] {
+      s21::map<Key, Key> copied(m);
+      copies += copied.size();
+    });
+    std::printf("  %-22s insert %7.1f  copy %12.1f  (%zu)\n", "s21::map",
+                insert, copy, copies);
+
+    s21::persistent_map<Key, Key> p;
+    insert = ns_per_element(size, [&] {
+      for (Key key : keys) {
+        p.insert(key, key);
+      }
+    });
+    auto snapshot = p.snapshot();
+    copy = ns_per_element(1, [&] {
+      auto copied = p.snapshot();
+      copies += copied.size();
+    });
+    // Every insert now copies its path away from the snapshot
+    double shared = ns_per_element(size, [&] {
+      for (Key key : more) {
+        p.insert(key, key);
+        snapshot = p.snapshot();
+      }
+    });
+    std::printf("  %-22s insert %7.1f  copy %12.1f  (%zu)\n",
+                "s21::persistent_map", insert, copy, copies);
+    std::printf("  %-22s insert %7.1f\n", "  snapshot per insert", shared);
+    size *= 10;
+  }
+  return 0;
+}
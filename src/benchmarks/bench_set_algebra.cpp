@@ -0,0 +1,85 @@
+// Scaling of set_union, set_intersection and set_difference on two
+// set<uint64_t> of n random keys each, about half of them shared, with
+// 1 up to max_threads threads and grain sizes from 1024 to 65536. Times are
+// ms per operation, the best of rounds runs, each on a fresh copy of a.
+//   make bench
+//   ./benchmarks/bench_set_algebra 1000000 16 5
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "../s21_containers.h"
+
+namespace {
+
+using Key = std::uint64_t;
+using Set = s21::set<Key>;
+
+enum class Operation { kUnion, kIntersection, kDifference };
+
+Set random_set(std::size_t count, Key range, Key state) {
+  Set s;
+  while (s.size() < count) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    s.insert((state >> 16) % range);
+  }
+  return s;
+}
+
+double run(const Set& a, const Set& b, Operation operation,
+           std::size_t grain_size, s21::ForkJoinPool& workers, int rounds) {
+  double best = 1e300;
+  for (int round = 0; round < rounds; ++round) {
+    Set s(a);
+    auto start = std::chrono::steady_clock::now();
+    switch (operation) {
+      case Operation::kUnion:
+        s.set_union(b, grain_size, workers);
+        break;
+      case Operation::kIntersection:
+        s.set_intersection(b, grain_size, workers);
+        break;
+      case Operation::kDifference:
+        s.set_difference(b, grain_size, workers);
+        break;
+    }
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::size_t max_threads = argc > 2 ? std::atoi(argv[2]) : 16;
+  int rounds = argc > 3 ? std::atoi(argv[3]) : 5;
+  Set a = random_set(n, 2 * n, 1);
+  Set b = random_set(n, 2 * n, 2);
+
+  std::printf("ms per operation, n = %zu, %u hardware threads\n", n,
+              std::thread::hardware_concurrency());
+  const char* names[] = {"union", "intersection", "difference"};
+  for (Operation operation : {Operation::kUnion, Operation::kIntersection,
+                              Operation::kDifference}) {
+    std::printf("%s\n", names[static_cast<int>(operation)]);
+    std::printf("  %7s %10s %10s %10s %10s\n", "threads", "grain 1K",
+                "grain 4K", "grain 16K", "grain 64K");
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+      s21::ForkJoinPool workers(threads);
+      std::printf("  %7zu", threads);
+      for (std::size_t grain_size : {1024, 4096, 16384, 65536}) {
+        std::printf(" %10.2f",
+                    run(a, b, operation, grain_size, workers, rounds));
+      }
+      std::printf("\n");
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,80 @@
+// Rebuilding map<uint64_t, uint64_t> of random keys by inserting them one by
+// one against load() of a snapshot, from a mapped file and from a stream,
+// plus the time of save(), in ns per element. Sizes from 10^4 up to
+// 10^max_exponent. The snapshot file is written to /tmp and removed.
+//   make bench
+//   ./benchmarks/bench_snapshot 7
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+
+namespace {
+
+using Key = std::uint64_t;
+
+std::vector<Key> random_keys(std::size_t count, Key state) {
+  std::vector<Key> keys(count);
+  for (Key& key : keys) {
+    state = state * 6364136223846793005ull + 1442695040888963407ull;
+    key = state >> 1;
+  }
+  return keys;
+}
+
+template <typename F>
+double ns_per_element(std::size_t count, F&& run) {
+  auto start = std::chrono::steady_clock::now();
+  run();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         count;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int max_exponent = argc > 1 ? std::atoi(argv[1]) : 6;
+  const std::string path = "/tmp/s21_bench_snapshot";
+  std::printf("ns per element\n");
+  std::size_t size = 10000;
+  for (int exponent = 4; exponent <= max_exponent; ++exponent) {
+    auto keys = random_keys(size, 42);
+
+    s21::map<Key, Key> inserted;
+    double insert = ns_per_element(size, [&] {
+      for (Key key : keys) {
+        inserted.insert(key, key);
+      }
+    });
+    double save = ns_per_element(size, [&] { inserted.save(path); });
+
+    s21::map<Key, Key> mapped;
+    double load_mapped = ns_per_element(size, [&] { mapped.load(path); });
+    s21::map<Key, Key> streamed;
+    double load_stream = ns_per_element(size, [&] {
+      std::ifstream in(path, std::ios::binary);
+      streamed.load(in);
+    });
+    if (mapped.size() != inserted.size() ||
+        streamed.size() != inserted.size()) {
+      std::printf("size mismatch\n");
+      return 1;
+    }
+
+    std::printf("10^%d\n", exponent);
+    std::printf("  insert %7.1f  save %6.1f\n", insert, save);
+    std::printf("  load mmap %6.1f  x%.1f   load stream %6.1f  x%.1f\n",
+                load_mapped, insert / load_mapped, load_stream,
+                insert / load_stream);
+    size *= 10;
+  }
+  std::remove(path.c_str());
+  return 0;
+}
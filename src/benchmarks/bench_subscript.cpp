@@ -0,0 +1,60 @@
+// Counter aggregation with m[key]++, about half of the keys are new.
+//   make bench
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "../s21_containers.h"
+
+namespace {
+
+constexpr int kStream = 2000000;
+constexpr int kDistinct = 1000000;
+
+// Best of three runs
+template <typename F>
+double measure_ms(F&& run) {
+  double best = 0;
+  for (int i = 0; i < 3; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto stop = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    if (i == 0 || ms < best) {
+      best = ms;
+    }
+  }
+  return best;
+}
+
+std::vector<long> key_stream() {
+  std::vector<long> keys(kStream);
+  unsigned state = 7;
+  for (long& key : keys) {
+    state = state * 1103515245u + 12345u;
+    key = (state >> 4) % kDistinct * 7919L;
+  }
+  return keys;
+}
+
+template <typename Map>
+double count_keys(const std::vector<long>& keys) {
+  return measure_ms([&] {
+    Map m;
+    for (long key : keys) {
+      m[key]++;
+    }
+  });
+}
+
+}  // namespace
+
+int main() {
+  auto keys = key_stream();
+  std::printf("%d increments over %d keys\n", kStream, kDistinct);
+  std::printf("s21::map %7.1f ms\n", count_keys<s21::map<long, int>>(keys));
+  std::printf("std::map %7.1f ms\n", count_keys<std::map<long, int>>(keys));
+  return 0;
+}
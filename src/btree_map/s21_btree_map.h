@@ -0,0 +1,102 @@
+#ifndef S21_BTREE_MAP_H
+#define S21_BTREE_MAP_H
+
+#include <iterator>
+#include <memory>
+#include <tuple>
+
+#include "../AVL/BTree.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+
+// map on a B-tree, for large maps where a lookup in the binary tree misses
+// the cache on most levels. Same interface as map without the order
+// statistics and set algebra; every insert and erase invalidates iterators,
+// see BTree.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class btree_map
+    : public BTree<Key, Compare, Allocator, MapNodePolicy<Key, T>> {
+  using tree_type = BTree<Key, Compare, Allocator, MapNodePolicy<Key, T>>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Member functions
+  btree_map() : tree_type() {}
+  explicit btree_map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  btree_map(std::initializer_list<value_type> const& items);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_map(InputIt first, InputIt last);
+  btree_map(const btree_map& m) : tree_type(m) {}
+  btree_map(btree_map&& m) noexcept : tree_type(std::move(m)) {}
+  btree_map& operator=(btree_map&& m) noexcept;
+
+  // Element access. The templated overload needs a transparent Compare.
+  T& at(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  T& at(const K& key);
+  T& operator[](const Key& key);
+  T& operator[](Key&& key);
+
+  // Capacity - from BTree
+  // bool empty(); size_type size(); size_type max_size();
+
+  // Modifiers
+  // void clear(); - from BTree
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  std::pair<iterator, bool> insert(const Key& key, const T& obj);
+  iterator insert(const_iterator hint, const value_type& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj);
+  // iterator erase(iterator pos); - from BTree
+  // iterator erase(iterator first, iterator last); - from BTree
+  // size_type erase(const Key& key); - from BTree
+  // void swap(btree_map& other); - from BTree
+  // void merge(btree_map& other); - from BTree
+
+  // Lookup
+  iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  size_type count(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key);
+  // bool contains(const Key& key); - from BTree
+  // lower_bound, upper_bound, equal_range - from BTree
+
+  template <typename... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+};
+
+}  // namespace s21
+
+#include "s21_btree_map.tpp"
+
+#endif
@@ -0,0 +1,192 @@
+#ifndef S21_BTREE_MAP_TPP
+#define S21_BTREE_MAP_TPP
+
+#include "s21_btree_map.h"
+
+namespace s21 {
+
+// Member functions
+template <typename Key, typename T, typename Compare, typename Allocator>
+btree_map<Key, T, Compare, Allocator>::btree_map(
+    std::initializer_list<value_type> const& items) {
+  for (const value_type& item : items) {
+    insert(this->end(), item);
+  }
+}
+
+// Sorted input is appended at the end through the hint
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+btree_map<Key, T, Compare, Allocator>::btree_map(InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    insert(this->end(), *first);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+btree_map<Key, T, Compare, Allocator>&
+btree_map<Key, T, Compare, Allocator>::operator=(btree_map&& m) noexcept {
+  tree_type::operator=(std::move(m));
+  return *this;
+}
+
+// Element access
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::mapped_type&
+btree_map<Key, T, Compare, Allocator>::at(const Key& key) {
+  auto it = this->find_position(key);
+  if (it == this->end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename btree_map<Key, T, Compare, Allocator>::mapped_type&
+btree_map<Key, T, Compare, Allocator>::at(const K& key) {
+  auto it = this->find_position(key);
+  if (it == this->end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::mapped_type&
+btree_map<Key, T, Compare, Allocator>::operator[](const Key& key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::mapped_type&
+btree_map<Key, T, Compare, Allocator>::operator[](Key&& key) {
+  return try_emplace(std::move(key)).first->second;
+}
+
+// Lookup
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::find(const Key& key) {
+  return this->find_position(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::find(const K& key) {
+  return this->find_position(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::size_type
+btree_map<Key, T, Compare, Allocator>::count(const Key& key) {
+  return this->contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename btree_map<Key, T, Compare, Allocator>::size_type
+btree_map<Key, T, Compare, Allocator>::count(const K& key) {
+  return this->contains(key) ? 1 : 0;
+}
+
+// Modifiers
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert(const value_type& value) {
+  return this->emplace_unique(value.first, value);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert(value_type&& value) {
+  return this->emplace_unique(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert(const Key& key, const T& obj) {
+  return this->emplace_unique(key, key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::insert(const_iterator hint,
+                                              const value_type& value) {
+  return this->insert_hint_unique(hint, value.first, value).first;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::emplace(Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return this->emplace_unique(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+typename btree_map<Key, T, Compare, Allocator>::iterator
+btree_map<Key, T, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                    Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return this->insert_hint_unique(hint, value.first, std::move(value)).first;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::try_emplace(const Key& key,
+                                                   Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::try_emplace(Key&& key, Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert_or_assign(const Key& key,
+                                                        M&& obj) {
+  auto result = try_emplace(key, std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>
+btree_map<Key, T, Compare, Allocator>::insert_or_assign(Key&& key, M&& obj) {
+  auto result = try_emplace(std::move(key), std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+vector<
+    std::pair<typename btree_map<Key, T, Compare, Allocator>::iterator, bool>>
+btree_map<Key, T, Compare, Allocator>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> v;
+  (v.push_back(emplace(std::forward<Args>(args))), ...);
+
+  return v;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef S21_BTREE_SET_H
+#define S21_BTREE_SET_H
+
+#include <iterator>
+#include <memory>
+
+#include "../AVL/BTree.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+
+// set on a B-tree, see btree_map
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class btree_set : public BTree<Key, Compare, Allocator, SetNodePolicy<Key>> {
+  using tree_type = BTree<Key, Compare, Allocator, SetNodePolicy<Key>>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  btree_set() : tree_type() {}
+  explicit btree_set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  btree_set(std::initializer_list<value_type> const& items);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  btree_set(InputIt first, InputIt last);
+  btree_set(const btree_set& s) : tree_type(s) {}
+  btree_set(btree_set&& s) noexcept : tree_type(std::move(s)) {}
+  btree_set& operator=(btree_set&& s) noexcept;
+
+  // Modifiers
+  // void clear(); - from BTree
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  iterator insert(const_iterator hint, const value_type& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
+  // iterator erase(iterator pos); - from BTree
+  // iterator erase(iterator first, iterator last); - from BTree
+  // size_type erase(const Key& key); - from BTree
+  // void swap(btree_set& other); - from BTree
+  // void merge(btree_set& other); - from BTree
+
+  // Lookup
+  iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  size_type count(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key);
+  // bool contains(const Key& key); - from BTree
+  // lower_bound, upper_bound, equal_range - from BTree
+
+  template <typename... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+};
+
+}  // namespace s21
+
+#include "s21_btree_set.tpp"
+
+#endif
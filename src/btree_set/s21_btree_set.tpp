@@ -0,0 +1,106 @@
+#ifndef S21_BTREE_SET_TPP
+#define S21_BTREE_SET_TPP
+
+#include "s21_btree_set.h"
+
+namespace s21 {
+
+template <typename Key, typename Compare, typename Allocator>
+btree_set<Key, Compare, Allocator>::btree_set(
+    std::initializer_list<value_type> const& items) {
+  for (const value_type& item : items) {
+    insert(this->end(), item);
+  }
+}
+
+// Sorted input is appended at the end through the hint
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+btree_set<Key, Compare, Allocator>::btree_set(InputIt first, InputIt last) {
+  for (; first != last; ++first) {
+    insert(this->end(), *first);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator>
+btree_set<Key, Compare, Allocator>&
+btree_set<Key, Compare, Allocator>::operator=(btree_set&& s) noexcept {
+  tree_type::operator=(std::move(s));
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>
+btree_set<Key, Compare, Allocator>::insert(const value_type& value) {
+  return this->emplace_unique(value, value);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>
+btree_set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return this->emplace_unique(value, std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>
+btree_set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  Key value(std::forward<Args>(args)...);
+  return this->emplace_unique(value, std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::insert(const_iterator hint,
+                                           const value_type& value) {
+  return this->insert_hint_unique(hint, value, value).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                 Args&&... args) {
+  Key value(std::forward<Args>(args)...);
+  return this->insert_hint_unique(hint, value, std::move(value)).first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::find(const Key& key) {
+  return this->find_position(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename btree_set<Key, Compare, Allocator>::iterator
+btree_set<Key, Compare, Allocator>::find(const K& key) {
+  return this->find_position(key);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename btree_set<Key, Compare, Allocator>::size_type
+btree_set<Key, Compare, Allocator>::count(const Key& key) {
+  return this->contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename btree_set<Key, Compare, Allocator>::size_type
+btree_set<Key, Compare, Allocator>::count(const K& key) {
+  return this->contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+vector<std::pair<typename btree_set<Key, Compare, Allocator>::iterator, bool>>
+btree_set<Key, Compare, Allocator>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> v;
+  (v.push_back(emplace(std::forward<Args>(args))), ...);
+
+  return v;
+}
+
+}  // namespace s21
+
+#endif
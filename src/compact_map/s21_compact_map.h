@@ -0,0 +1,92 @@
+#ifndef S21_COMPACT_MAP_H
+#define S21_COMPACT_MAP_H
+
+#include <memory>
+#include <tuple>
+
+#include "../AVL/CompactAVLTree.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+
+// map on the index-based tree: same interface without the order statistics,
+// about half the per-node overhead. Pointers and references to elements are
+// invalidated when the tree grows, iterators are not.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class compact_map : public CompactAVLTree<Key, Compare, Allocator,
+                                          MapNodePolicy<Key, T>> {
+  using tree_type =
+      CompactAVLTree<Key, Compare, Allocator, MapNodePolicy<Key, T>>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Member functions
+  compact_map() : tree_type() {}
+  explicit compact_map(const Compare& comp,
+                       const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  compact_map(std::initializer_list<value_type> const& items);
+  compact_map(const compact_map& m) : tree_type(m) {}
+  compact_map(compact_map&& m) noexcept : tree_type(std::move(m)) {}
+  compact_map& operator=(compact_map&& m) noexcept;
+
+  // Element access. The templated overload needs a transparent Compare.
+  T& at(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  T& at(const K& key);
+  T& operator[](const Key& key);
+  T& operator[](Key&& key);
+
+  // Capacity - from CompactAVLTree
+  // bool empty(); size_type size(); size_type max_size();
+  // size_type capacity(); void reserve(size_type count);
+
+  // Modifiers
+  // void clear(); - from CompactAVLTree
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  std::pair<iterator, bool> insert(const Key& key, const T& obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj);
+  // void erase(iterator pos); - from CompactAVLTree
+  // size_type erase(const Key& key); - from CompactAVLTree
+  // void swap(compact_map& other); - from CompactAVLTree
+
+  // Lookup
+  iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  size_type count(const Key& key);
+  // bool contains(const Key& key); - from CompactAVLTree
+  // lower_bound, upper_bound, equal_range - from CompactAVLTree
+
+  template <typename... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+};
+
+}  // namespace s21
+
+#include "s21_compact_map.tpp"
+
+#endif
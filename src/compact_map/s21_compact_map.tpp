@@ -0,0 +1,164 @@
+#ifndef S21_COMPACT_MAP_TPP
+#define S21_COMPACT_MAP_TPP
+
+#include "s21_compact_map.h"
+
+namespace s21 {
+
+// Member functions
+template <typename Key, typename T, typename Compare, typename Allocator>
+compact_map<Key, T, Compare, Allocator>::compact_map(
+    std::initializer_list<value_type> const& items) {
+  this->reserve(items.size());
+  for (const value_type& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+compact_map<Key, T, Compare, Allocator>&
+compact_map<Key, T, Compare, Allocator>::operator=(compact_map&& m) noexcept {
+  tree_type::operator=(std::move(m));
+  return *this;
+}
+
+// Element access
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::mapped_type&
+compact_map<Key, T, Compare, Allocator>::at(const Key& key) {
+  auto node = this->find_index(key);
+  if (node == tree_type::kNull) {
+    throw std::out_of_range("Key not found");
+  }
+  return this->values_[node].second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename compact_map<Key, T, Compare, Allocator>::mapped_type&
+compact_map<Key, T, Compare, Allocator>::at(const K& key) {
+  auto node = this->find_index(key);
+  if (node == tree_type::kNull) {
+    throw std::out_of_range("Key not found");
+  }
+  return this->values_[node].second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::mapped_type&
+compact_map<Key, T, Compare, Allocator>::operator[](const Key& key) {
+  return try_emplace(key).first->second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::mapped_type&
+compact_map<Key, T, Compare, Allocator>::operator[](Key&& key) {
+  return try_emplace(std::move(key)).first->second;
+}
+
+// Lookup
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::find(const Key& key) {
+  return iterator(this, this->find_index(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename compact_map<Key, T, Compare, Allocator>::iterator
+compact_map<Key, T, Compare, Allocator>::find(const K& key) {
+  return iterator(this, this->find_index(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename compact_map<Key, T, Compare, Allocator>::size_type
+compact_map<Key, T, Compare, Allocator>::count(const Key& key) {
+  return this->contains(key) ? 1 : 0;
+}
+
+// Modifiers
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert(const value_type& value) {
+  return this->emplace_unique(value.first, value);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert(value_type&& value) {
+  return this->emplace_unique(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert(const Key& key,
+                                                const T& obj) {
+  return this->emplace_unique(key, key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::emplace(Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return this->emplace_unique(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::try_emplace(const Key& key,
+                                                     Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::try_emplace(Key&& key,
+                                                     Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert_or_assign(const Key& key,
+                                                          M&& obj) {
+  auto result = try_emplace(key, std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>
+compact_map<Key, T, Compare, Allocator>::insert_or_assign(Key&& key,
+                                                          M&& obj) {
+  auto result = try_emplace(std::move(key), std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+vector<
+    std::pair<typename compact_map<Key, T, Compare, Allocator>::iterator, bool>>
+compact_map<Key, T, Compare, Allocator>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> v;
+  (v.push_back(emplace(std::forward<Args>(args))), ...);
+
+  return v;
+}
+
+}  // namespace s21
+
+#endif
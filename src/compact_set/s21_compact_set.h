@@ -0,0 +1,65 @@
+#ifndef S21_COMPACT_SET_H
+#define S21_COMPACT_SET_H
+
+#include <memory>
+
+#include "../AVL/CompactAVLTree.h"
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+
+// set on the index-based tree, see compact_map
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class compact_set
+    : public CompactAVLTree<Key, Compare, Allocator, SetNodePolicy<Key>> {
+  using tree_type = CompactAVLTree<Key, Compare, Allocator, SetNodePolicy<Key>>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  compact_set() : tree_type() {}
+  explicit compact_set(const Compare& comp,
+                       const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  compact_set(std::initializer_list<value_type> const& items);
+  compact_set(const compact_set& s) : tree_type(s) {}
+  compact_set(compact_set&& s) noexcept : tree_type(std::move(s)) {}
+  compact_set& operator=(compact_set&& s) noexcept;
+
+  // Modifiers
+  // void clear(); - from CompactAVLTree
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // void erase(iterator pos); - from CompactAVLTree
+  // size_type erase(const Key& key); - from CompactAVLTree
+  // void swap(compact_set& other); - from CompactAVLTree
+
+  // Lookup
+  iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  size_type count(const Key& key);
+  // bool contains(const Key& key); - from CompactAVLTree
+  // lower_bound, upper_bound, equal_range - from CompactAVLTree
+
+  template <typename... Args>
+  vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+};
+
+}  // namespace s21
+
+#include "s21_compact_set.tpp"
+
+#endif
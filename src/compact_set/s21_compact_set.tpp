@@ -0,0 +1,75 @@
+#ifndef S21_COMPACT_SET_TPP
+#define S21_COMPACT_SET_TPP
+
+#include "s21_compact_set.h"
+
+namespace s21 {
+
+template <typename Key, typename Compare, typename Allocator>
+compact_set<Key, Compare, Allocator>::compact_set(
+    std::initializer_list<value_type> const& items) {
+  this->reserve(items.size());
+  for (const value_type& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename Compare, typename Allocator>
+compact_set<Key, Compare, Allocator>&
+compact_set<Key, Compare, Allocator>::operator=(compact_set&& s) noexcept {
+  tree_type::operator=(std::move(s));
+  return *this;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename compact_set<Key, Compare, Allocator>::iterator, bool>
+compact_set<Key, Compare, Allocator>::insert(const value_type& value) {
+  return this->emplace_unique(value, value);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename compact_set<Key, Compare, Allocator>::iterator, bool>
+compact_set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return this->emplace_unique(value, std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename compact_set<Key, Compare, Allocator>::iterator, bool>
+compact_set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  Key value(std::forward<Args>(args)...);
+  return this->emplace_unique(value, std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::find(const Key& key) {
+  return iterator(this, this->find_index(key));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename compact_set<Key, Compare, Allocator>::iterator
+compact_set<Key, Compare, Allocator>::find(const K& key) {
+  return iterator(this, this->find_index(key));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename compact_set<Key, Compare, Allocator>::size_type
+compact_set<Key, Compare, Allocator>::count(const Key& key) {
+  return this->contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+vector<std::pair<typename compact_set<Key, Compare, Allocator>::iterator, bool>>
+compact_set<Key, Compare, Allocator>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> v;
+  (v.push_back(emplace(std::forward<Args>(args))), ...);
+
+  return v;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef S21_CONCURRENT_MAP_H
+#define S21_CONCURRENT_MAP_H
+
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "../AVL/ConcurrentAVLTree.h"
+
+namespace s21 {
+
+// Thread-safe map, see ConcurrentAVLTree. Every member but clear() and the
+// destructor may be called from any number of threads at once.
+//
+// find() and contains() take no locks. Since another thread may replace or
+// erase a value at any time there are no iterators and no references into
+// the map: find() returns a copy of the value, and modifiers report only
+// whether they inserted or erased. T must be copy constructible.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class concurrent_map : public ConcurrentAVLTree<Key, T, Compare, Allocator> {
+  using tree_type = ConcurrentAVLTree<Key, T, Compare, Allocator>;
+  using Guard = typename tree_type::Guard;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Member functions
+  concurrent_map() : tree_type() {}
+  explicit concurrent_map(const Compare& comp,
+                          const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  concurrent_map(std::initializer_list<value_type> const& items);
+
+  // Modifiers. insert and try_emplace leave a present value alone,
+  // insert_or_assign replaces it; each returns true if key was new.
+  // void clear(); - from ConcurrentAVLTree
+  bool insert(const value_type& value);
+  bool insert(const Key& key, const T& obj);
+  template <typename... Args>
+  bool try_emplace(const Key& key, Args&&... args);
+  template <typename M>
+  bool insert_or_assign(const Key& key, M&& obj);
+  size_type erase(const Key& key);
+
+  // Lookup. The templated overloads need a transparent Compare.
+  std::optional<T> find(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  std::optional<T> find(const K& key) const;
+  bool contains(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key) const;
+  size_type count(const Key& key) const;
+};
+
+}  // namespace s21
+
+#include "s21_concurrent_map.tpp"
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef S21_CONCURRENT_MAP_TPP
+#define S21_CONCURRENT_MAP_TPP
+
+#include "s21_concurrent_map.h"
+
+namespace s21 {
+
+// Member functions
+template <typename Key, typename T, typename Compare, typename Allocator>
+concurrent_map<Key, T, Compare, Allocator>::concurrent_map(
+    std::initializer_list<value_type> const& items) {
+  for (const value_type& item : items) {
+    insert(item);
+  }
+}
+
+// Modifiers
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool concurrent_map<Key, T, Compare, Allocator>::insert(
+    const value_type& value) {
+  return try_emplace(value.first, value.second);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool concurrent_map<Key, T, Compare, Allocator>::insert(const Key& key,
+                                                        const T& obj) {
+  return try_emplace(key, obj);
+}
+
+// The box is built only for a key that looked missing, and dropped again if
+// another thread got there first
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+bool concurrent_map<Key, T, Compare, Allocator>::try_emplace(
+    const Key& key, Args&&... args) {
+  Guard guard(this->reclaimer_);
+  if (this->find_value(key, guard)) {
+    return false;
+  }
+  T* value = this->create_value(std::forward<Args>(args)...);
+  if (this->put(key, value, false, guard)) {
+    this->destroy_value(value);
+    return false;
+  }
+  return true;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+bool concurrent_map<Key, T, Compare, Allocator>::insert_or_assign(
+    const Key& key, M&& obj) {
+  Guard guard(this->reclaimer_);
+  T* value = this->create_value(std::forward<M>(obj));
+  T* previous = this->put(key, value, true, guard);
+  if (previous) {
+    this->retire_value(guard, previous);
+    return false;
+  }
+  return true;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_map<Key, T, Compare, Allocator>::size_type
+concurrent_map<Key, T, Compare, Allocator>::erase(const Key& key) {
+  Guard guard(this->reclaimer_);
+  T* previous = this->remove(key, guard);
+  if (!previous) {
+    return 0;
+  }
+  this->retire_value(guard, previous);
+  return 1;
+}
+
+// Lookup
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::optional<T> concurrent_map<Key, T, Compare, Allocator>::find(
+    const Key& key) const {
+  Guard guard(this->reclaimer_);
+  T* value = this->find_value(key, guard);
+  return value ? std::optional<T>(*value) : std::nullopt;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::optional<T> concurrent_map<Key, T, Compare, Allocator>::find(
+    const K& key) const {
+  Guard guard(this->reclaimer_);
+  T* value = this->find_value(key, guard);
+  return value ? std::optional<T>(*value) : std::nullopt;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+bool concurrent_map<Key, T, Compare, Allocator>::contains(
+    const Key& key) const {
+  Guard guard(this->reclaimer_);
+  return this->find_value(key, guard) != nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool concurrent_map<Key, T, Compare, Allocator>::contains(
+    const K& key) const {
+  Guard guard(this->reclaimer_);
+  return this->find_value(key, guard) != nullptr;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename concurrent_map<Key, T, Compare, Allocator>::size_type
+concurrent_map<Key, T, Compare, Allocator>::count(const Key& key) const {
+  return contains(key) ? 1 : 0;
+}
+
+}  // namespace s21
+
+#endif
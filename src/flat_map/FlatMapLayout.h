@@ -0,0 +1,128 @@
+#ifndef S21_FLAT_MAP_LAYOUT_H
+#define S21_FLAT_MAP_LAYOUT_H
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+
+// How flat_map lays out its sorted elements in s21::vector. Both layouts
+// keep element i at index i and have the same operations; the map does the
+// searching and the ordering.
+
+// Each key next to its value: a hit reads both from the same cache line
+template <typename Key, typename T>
+class PairLayout {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = size_t;
+
+  size_type size() const { return items_.size(); }
+  size_type capacity() const { return items_.capacity(); }
+  size_type max_size() const { return items_.max_size(); }
+  void reserve(size_type count) { items_.reserve(count); }
+  void shrink_to_fit() { items_.shrink_to_fit(); }
+  void clear() { items_.clear(); }
+  void swap(PairLayout& other) noexcept { items_.swap(other.items_); }
+
+  const Key& key(size_type i) { return items_.data()[i].first; }
+  T& mapped(size_type i) { return items_.data()[i].second; }
+
+  template <typename K, typename... Args>
+  void emplace_back(K&& key, Args&&... args) {
+    items_.emplace_back(std::piecewise_construct,
+                        std::forward_as_tuple(std::forward<K>(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  // Moves element i of other to the end
+  void append_from(PairLayout& other, size_type i) {
+    items_.push_back(std::move(other.items_.data()[i]));
+  }
+  // Moves the last element to i, shifting the ones after it
+  void move_back_to(size_type i) {
+    std::rotate(items_.begin() + i, items_.end() - 1, items_.end());
+  }
+  void erase(size_type first, size_type last) {
+    std::move(items_.begin() + last, items_.end(), items_.begin() + first);
+    for (size_type i = first; i < last; ++i) {
+      items_.pop_back();
+    }
+  }
+
+ private:
+  vector<std::pair<Key, T>> items_;
+};
+
+// Keys and values in two arrays: the binary search touches only keys, which
+// pack more per cache line, and iterating over either is dense
+template <typename Key, typename T>
+class SplitLayout {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using size_type = size_t;
+
+  size_type size() const { return keys_.size(); }
+  size_type capacity() const { return keys_.capacity(); }
+  size_type max_size() const {
+    return std::min(keys_.max_size(), values_.max_size());
+  }
+  void reserve(size_type count) {
+    keys_.reserve(count);
+    values_.reserve(count);
+  }
+  void shrink_to_fit() {
+    keys_.shrink_to_fit();
+    values_.shrink_to_fit();
+  }
+  void clear() {
+    keys_.clear();
+    values_.clear();
+  }
+  void swap(SplitLayout& other) noexcept {
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+  }
+
+  const Key& key(size_type i) { return keys_.data()[i]; }
+  T& mapped(size_type i) { return values_.data()[i]; }
+
+  template <typename K, typename... Args>
+  void emplace_back(K&& key, Args&&... args) {
+    keys_.emplace_back(std::forward<K>(key));
+    try {
+      values_.emplace_back(std::forward<Args>(args)...);
+    } catch (...) {
+      keys_.pop_back();
+      throw;
+    }
+  }
+  void append_from(SplitLayout& other, size_type i) {
+    emplace_back(std::move(other.keys_.data()[i]),
+                 std::move(other.values_.data()[i]));
+  }
+  void move_back_to(size_type i) {
+    std::rotate(keys_.begin() + i, keys_.end() - 1, keys_.end());
+    std::rotate(values_.begin() + i, values_.end() - 1, values_.end());
+  }
+  void erase(size_type first, size_type last) {
+    std::move(keys_.begin() + last, keys_.end(), keys_.begin() + first);
+    std::move(values_.begin() + last, values_.end(), values_.begin() + first);
+    for (size_type i = first; i < last; ++i) {
+      keys_.pop_back();
+      values_.pop_back();
+    }
+  }
+
+ private:
+  vector<Key> keys_;
+  vector<T> values_;
+};
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef S21_FLAT_MAP_H
+#define S21_FLAT_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../vector/s21_vector.h"
+#include "FlatMapLayout.h"
+
+namespace s21 {
+
+// Random access iterator over a flat_map. Key and value may live in
+// different arrays, so it hands out a pair of references rather than a
+// reference to a pair.
+template <typename Layout, bool kConst>
+class FlatMapIterator {
+  template <typename, bool>
+  friend class FlatMapIterator;
+
+  using key_type = typename Layout::key_type;
+  using mapped_type = typename Layout::mapped_type;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::pair<key_type, mapped_type>;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::pair<const key_type&,
+                std::conditional_t<kConst, const mapped_type&, mapped_type&>>;
+
+  // Keeps the pair alive for it->second
+  struct pointer {
+    reference ref;
+    const reference* operator->() const { return &ref; }
+  };
+
+  FlatMapIterator() noexcept : layout_(nullptr), index_(0) {}
+  FlatMapIterator(Layout* layout, size_t index) noexcept
+      : layout_(layout), index_(index) {}
+  template <bool C = kConst, typename = std::enable_if_t<C>>
+  FlatMapIterator(const FlatMapIterator<Layout, false>& other) noexcept
+      : layout_(other.layout_), index_(other.index_) {}
+
+  reference operator*() const;
+  pointer operator->() const;
+  reference operator[](difference_type n) const;
+  FlatMapIterator& operator++();
+  FlatMapIterator operator++(int);
+  FlatMapIterator& operator--();
+  FlatMapIterator operator--(int);
+  FlatMapIterator& operator+=(difference_type n);
+  FlatMapIterator& operator-=(difference_type n);
+  FlatMapIterator operator+(difference_type n) const;
+  FlatMapIterator operator-(difference_type n) const;
+  difference_type operator-(const FlatMapIterator& other) const;
+  bool operator==(const FlatMapIterator& other) const;
+  bool operator!=(const FlatMapIterator& other) const;
+  bool operator<(const FlatMapIterator& other) const;
+  bool operator>(const FlatMapIterator& other) const;
+  bool operator<=(const FlatMapIterator& other) const;
+  bool operator>=(const FlatMapIterator& other) const;
+
+  size_t index() const;
+
+ private:
+  Layout* layout_;
+  size_t index_;
+};
+
+// Sorted map in s21::vector storage, see flat_set. Layout is PairLayout or
+// SplitLayout, see FlatMapLayout.h. Every modification invalidates
+// iterators.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Layout = PairLayout<Key, T>>
+class flat_map {
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using reference = std::pair<const Key&, T&>;
+  using const_reference = std::pair<const Key&, const T&>;
+  using iterator = FlatMapIterator<Layout, false>;
+  using const_iterator = FlatMapIterator<Layout, true>;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using layout_type = Layout;
+
+ private:
+  Layout layout_;
+  Compare comp_;
+
+  template <typename K>
+  size_type lower_index(const K& key);
+  template <typename K>
+  size_type upper_index(const K& key);
+  template <typename K>
+  bool found_at(size_type i, const K& key);
+  // key is only looked up until it turns out to be missing
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_insert(K&& key, Args&&... args);
+
+ public:
+  // Member functions
+  flat_map() = default;
+  explicit flat_map(const Compare& comp) : comp_(comp) {}
+  flat_map(std::initializer_list<value_type> const& items);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_map(InputIt first, InputIt last, const Compare& comp = Compare());
+  flat_map(const flat_map& m) = default;
+  flat_map(flat_map&& m) noexcept = default;
+  flat_map& operator=(flat_map&& m) noexcept;
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator cbegin();
+  const_iterator cend();
+
+  // Element access. The templated overload needs a transparent Compare.
+  T& at(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  T& at(const K& key);
+  T& operator[](const Key& key);
+  T& operator[](Key&& key);
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  size_type capacity() const;
+  void reserve(size_type count);
+  void shrink_to_fit();
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  std::pair<iterator, bool> insert(const Key& key, const T& obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj);
+  // Sorts the new elements and merges them in, O(n + m log m). Keys already
+  // present keep their values, among equal new keys the first wins.
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const Key& key);
+  void swap(flat_map& other) noexcept;
+
+  // Lookup
+  iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  size_type count(const Key& key);
+  bool contains(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key);
+  iterator lower_bound(const Key& key);
+  iterator upper_bound(const Key& key);
+  std::pair<iterator, iterator> equal_range(const Key& key);
+
+  // Observers
+  key_compare key_comp() const;
+};
+
+}  // namespace s21
+
+#include "s21_flat_map.tpp"
+
+#endif
@@ -0,0 +1,529 @@
+#ifndef S21_FLAT_MAP_TPP
+#define S21_FLAT_MAP_TPP
+
+#include "s21_flat_map.h"
+
+namespace s21 {
+
+// FlatMapIterator
+
+template <typename Layout, bool kConst>
+typename FlatMapIterator<Layout, kConst>::reference
+FlatMapIterator<Layout, kConst>::operator*() const {
+  if (layout_ == nullptr || index_ >= layout_->size()) {
+    throw std::out_of_range("Iterator is out of bounds[operator *]");
+  }
+  return {layout_->key(index_), layout_->mapped(index_)};
+}
+
+template <typename Layout, bool kConst>
+typename FlatMapIterator<Layout, kConst>::pointer
+FlatMapIterator<Layout, kConst>::operator->() const {
+  return {**this};
+}
+
+template <typename Layout, bool kConst>
+typename FlatMapIterator<Layout, kConst>::reference
+FlatMapIterator<Layout, kConst>::operator[](difference_type n) const {
+  return *(*this + n);
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst>& FlatMapIterator<Layout, kConst>::operator++() {
+  ++index_;
+  return *this;
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst> FlatMapIterator<Layout, kConst>::operator++(
+    int) {
+  FlatMapIterator temp = *this;
+  ++index_;
+  return temp;
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst>& FlatMapIterator<Layout, kConst>::operator--() {
+  --index_;
+  return *this;
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst> FlatMapIterator<Layout, kConst>::operator--(
+    int) {
+  FlatMapIterator temp = *this;
+  --index_;
+  return temp;
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst>& FlatMapIterator<Layout, kConst>::operator+=(
+    difference_type n) {
+  index_ += n;
+  return *this;
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst>& FlatMapIterator<Layout, kConst>::operator-=(
+    difference_type n) {
+  index_ -= n;
+  return *this;
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst> FlatMapIterator<Layout, kConst>::operator+(
+    difference_type n) const {
+  return FlatMapIterator(layout_, index_ + n);
+}
+
+template <typename Layout, bool kConst>
+FlatMapIterator<Layout, kConst> FlatMapIterator<Layout, kConst>::operator-(
+    difference_type n) const {
+  return FlatMapIterator(layout_, index_ - n);
+}
+
+template <typename Layout, bool kConst>
+typename FlatMapIterator<Layout, kConst>::difference_type
+FlatMapIterator<Layout, kConst>::operator-(
+    const FlatMapIterator& other) const {
+  return static_cast<difference_type>(index_) -
+         static_cast<difference_type>(other.index_);
+}
+
+template <typename Layout, bool kConst>
+bool FlatMapIterator<Layout, kConst>::operator==(
+    const FlatMapIterator& other) const {
+  return index_ == other.index_;
+}
+
+template <typename Layout, bool kConst>
+bool FlatMapIterator<Layout, kConst>::operator!=(
+    const FlatMapIterator& other) const {
+  return index_ != other.index_;
+}
+
+template <typename Layout, bool kConst>
+bool FlatMapIterator<Layout, kConst>::operator<(
+    const FlatMapIterator& other) const {
+  return index_ < other.index_;
+}
+
+template <typename Layout, bool kConst>
+bool FlatMapIterator<Layout, kConst>::operator>(
+    const FlatMapIterator& other) const {
+  return index_ > other.index_;
+}
+
+template <typename Layout, bool kConst>
+bool FlatMapIterator<Layout, kConst>::operator<=(
+    const FlatMapIterator& other) const {
+  return index_ <= other.index_;
+}
+
+template <typename Layout, bool kConst>
+bool FlatMapIterator<Layout, kConst>::operator>=(
+    const FlatMapIterator& other) const {
+  return index_ >= other.index_;
+}
+
+template <typename Layout, bool kConst>
+size_t FlatMapIterator<Layout, kConst>::index() const {
+  return index_;
+}
+
+// Helpers
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename K>
+typename flat_map<Key, T, Compare, Layout>::size_type
+flat_map<Key, T, Compare, Layout>::lower_index(const K& key) {
+  size_type lo = 0;
+  size_type hi = layout_.size();
+  while (lo < hi) {
+    size_type mid = (lo + hi) / 2;
+    if (comp_(layout_.key(mid), key)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename K>
+typename flat_map<Key, T, Compare, Layout>::size_type
+flat_map<Key, T, Compare, Layout>::upper_index(const K& key) {
+  size_type lo = 0;
+  size_type hi = layout_.size();
+  while (lo < hi) {
+    size_type mid = (lo + hi) / 2;
+    if (comp_(key, layout_.key(mid))) {
+      hi = mid;
+    } else {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename K>
+bool flat_map<Key, T, Compare, Layout>::found_at(size_type i, const K& key) {
+  return i < layout_.size() && !comp_(key, layout_.key(i));
+}
+
+// The value is built before the arrays may grow, args may refer into them
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename K, typename... Args>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::try_insert(K&& key, Args&&... args) {
+  size_type i = lower_index(key);
+  if (found_at(i, key)) {
+    return {iterator(&layout_, i), false};
+  }
+  T value(std::forward<Args>(args)...);
+  layout_.emplace_back(std::forward<K>(key), std::move(value));
+  layout_.move_back_to(i);
+  return {iterator(&layout_, i), true};
+}
+
+// Member functions
+
+template <typename Key, typename T, typename Compare, typename Layout>
+flat_map<Key, T, Compare, Layout>::flat_map(
+    std::initializer_list<value_type> const& items)
+    : flat_map(items.begin(), items.end()) {}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename InputIt, typename>
+flat_map<Key, T, Compare, Layout>::flat_map(InputIt first, InputIt last,
+                                            const Compare& comp)
+    : comp_(comp) {
+  insert_range(first, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+flat_map<Key, T, Compare, Layout>& flat_map<Key, T, Compare, Layout>::operator=(
+    flat_map&& m) noexcept {
+  if (this != &m) {
+    layout_.clear();
+    layout_.shrink_to_fit();
+    layout_.swap(m.layout_);
+    comp_ = std::move(m.comp_);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::begin() {
+  return iterator(&layout_, 0);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::end() {
+  return iterator(&layout_, layout_.size());
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::const_iterator
+flat_map<Key, T, Compare, Layout>::cbegin() {
+  return begin();
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::const_iterator
+flat_map<Key, T, Compare, Layout>::cend() {
+  return end();
+}
+
+// Element access
+
+template <typename Key, typename T, typename Compare, typename Layout>
+T& flat_map<Key, T, Compare, Layout>::at(const Key& key) {
+  size_type i = lower_index(key);
+  if (!found_at(i, key)) {
+    throw std::out_of_range("Key not found");
+  }
+  return layout_.mapped(i);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename K, typename C, typename>
+T& flat_map<Key, T, Compare, Layout>::at(const K& key) {
+  size_type i = lower_index(key);
+  if (!found_at(i, key)) {
+    throw std::out_of_range("Key not found");
+  }
+  return layout_.mapped(i);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+T& flat_map<Key, T, Compare, Layout>::operator[](const Key& key) {
+  return layout_.mapped(try_insert(key).first.index());
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+T& flat_map<Key, T, Compare, Layout>::operator[](Key&& key) {
+  return layout_.mapped(try_insert(std::move(key)).first.index());
+}
+
+// Capacity
+
+template <typename Key, typename T, typename Compare, typename Layout>
+bool flat_map<Key, T, Compare, Layout>::empty() const {
+  return layout_.size() == 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::size_type
+flat_map<Key, T, Compare, Layout>::size() const {
+  return layout_.size();
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::size_type
+flat_map<Key, T, Compare, Layout>::max_size() const {
+  return layout_.max_size();
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::size_type
+flat_map<Key, T, Compare, Layout>::capacity() const {
+  return layout_.capacity();
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+void flat_map<Key, T, Compare, Layout>::reserve(size_type count) {
+  layout_.reserve(count);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+void flat_map<Key, T, Compare, Layout>::shrink_to_fit() {
+  layout_.shrink_to_fit();
+}
+
+// Modifiers
+
+template <typename Key, typename T, typename Compare, typename Layout>
+void flat_map<Key, T, Compare, Layout>::clear() {
+  layout_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::insert(const value_type& value) {
+  return try_insert(value.first, value.second);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::insert(value_type&& value) {
+  return try_insert(std::move(value.first), std::move(value.second));
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::insert(const Key& key, const T& obj) {
+  return try_insert(key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::emplace(Args&&... args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::try_emplace(const Key& key,
+                                               Args&&... args) {
+  return try_insert(key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::try_emplace(Key&& key, Args&&... args) {
+  return try_insert(std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename M>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::insert_or_assign(const Key& key,
+                                                    M&& obj) {
+  auto result = try_insert(key, std::forward<M>(obj));
+  if (!result.second) {
+    layout_.mapped(result.first.index()) = std::forward<M>(obj);
+  }
+  return result;
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename M>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator, bool>
+flat_map<Key, T, Compare, Layout>::insert_or_assign(Key&& key, M&& obj) {
+  auto result = try_insert(std::move(key), std::forward<M>(obj));
+  if (!result.second) {
+    layout_.mapped(result.first.index()) = std::forward<M>(obj);
+  }
+  return result;
+}
+
+// A batch that sorts after the current elements is appended, otherwise
+// both sorted runs are merged into new arrays
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename InputIt>
+void flat_map<Key, T, Compare, Layout>::insert_range(InputIt first,
+                                                     InputIt last) {
+  vector<value_type> batch;
+  for (; first != last; ++first) {
+    batch.emplace_back(*first);
+  }
+  auto less = [this](const value_type& a, const value_type& b) {
+    return comp_(a.first, b.first);
+  };
+  auto equal = [this](const value_type& a, const value_type& b) {
+    return !comp_(a.first, b.first);
+  };
+  if (!std::is_sorted(batch.begin(), batch.end(), less)) {
+    std::stable_sort(batch.begin(), batch.end(), less);
+  }
+  size_type unique = std::unique(batch.begin(), batch.end(), equal) -
+                     batch.begin();
+  if (unique == 0) {
+    return;
+  }
+
+  value_type* in = batch.begin();
+  size_type n = layout_.size();
+  if (n == 0 || comp_(layout_.key(n - 1), in[0].first)) {
+    layout_.reserve(n + unique);
+    for (size_type j = 0; j < unique; ++j) {
+      layout_.emplace_back(std::move(in[j].first), std::move(in[j].second));
+    }
+    return;
+  }
+
+  Layout merged;
+  merged.reserve(n + unique);
+  size_type i = 0;
+  size_type j = 0;
+  while (i < n && j < unique) {
+    if (comp_(in[j].first, layout_.key(i))) {
+      merged.emplace_back(std::move(in[j].first), std::move(in[j].second));
+      ++j;
+    } else {
+      if (!comp_(layout_.key(i), in[j].first)) {
+        ++j;
+      }
+      merged.append_from(layout_, i++);
+    }
+  }
+  for (; i < n; ++i) {
+    merged.append_from(layout_, i);
+  }
+  for (; j < unique; ++j) {
+    merged.emplace_back(std::move(in[j].first), std::move(in[j].second));
+  }
+  layout_.swap(merged);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::erase(const_iterator pos) {
+  return erase(pos, pos + 1);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::erase(const_iterator first,
+                                         const_iterator last) {
+  layout_.erase(first.index(), last.index());
+  return iterator(&layout_, first.index());
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::size_type
+flat_map<Key, T, Compare, Layout>::erase(const Key& key) {
+  size_type i = lower_index(key);
+  if (!found_at(i, key)) {
+    return 0;
+  }
+  layout_.erase(i, i + 1);
+  return 1;
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+void flat_map<Key, T, Compare, Layout>::swap(flat_map& other) noexcept {
+  layout_.swap(other.layout_);
+  std::swap(comp_, other.comp_);
+}
+
+// Lookup
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::find(const Key& key) {
+  size_type i = lower_index(key);
+  return found_at(i, key) ? iterator(&layout_, i) : end();
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename K, typename C, typename>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::find(const K& key) {
+  size_type i = lower_index(key);
+  return found_at(i, key) ? iterator(&layout_, i) : end();
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::size_type
+flat_map<Key, T, Compare, Layout>::count(const Key& key) {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+bool flat_map<Key, T, Compare, Layout>::contains(const Key& key) {
+  return found_at(lower_index(key), key);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+template <typename K, typename C, typename>
+bool flat_map<Key, T, Compare, Layout>::contains(const K& key) {
+  return found_at(lower_index(key), key);
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::lower_bound(const Key& key) {
+  return iterator(&layout_, lower_index(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::iterator
+flat_map<Key, T, Compare, Layout>::upper_bound(const Key& key) {
+  return iterator(&layout_, upper_index(key));
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+std::pair<typename flat_map<Key, T, Compare, Layout>::iterator,
+          typename flat_map<Key, T, Compare, Layout>::iterator>
+flat_map<Key, T, Compare, Layout>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename T, typename Compare, typename Layout>
+typename flat_map<Key, T, Compare, Layout>::key_compare
+flat_map<Key, T, Compare, Layout>::key_comp() const {
+  return comp_;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef S21_FLAT_SET_H
+#define S21_FLAT_SET_H
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+#include "../vector/s21_vector.h"
+
+namespace s21 {
+
+// Sorted set in one s21::vector: lookups are binary searches over
+// contiguous keys and iteration is a linear scan, with no per-element
+// overhead. Inserting or erasing a single key shifts the tail, so it is
+// meant for read-mostly tables; insert_range adds a batch with one merge.
+// Every modification invalidates iterators.
+template <typename Key, typename Compare = std::less<Key>>
+class flat_set {
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using iterator = const Key*;
+  using const_iterator = const Key*;
+  using size_type = size_t;
+  using key_compare = Compare;
+
+ private:
+  vector<Key> keys_;
+  Compare comp_;
+
+  template <typename K>
+  size_type lower_index(const K& key);
+  template <typename K>
+  size_type upper_index(const K& key);
+  template <typename K>
+  bool found_at(size_type i, const K& key);
+  template <typename V>
+  std::pair<iterator, bool> insert_value(V&& value);
+  void sort_and_unique(size_type first);
+  void truncate(size_type size);
+
+ public:
+  flat_set() = default;
+  explicit flat_set(const Compare& comp) : comp_(comp) {}
+  flat_set(std::initializer_list<value_type> const& items);
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  flat_set(InputIt first, InputIt last, const Compare& comp = Compare());
+  flat_set(const flat_set& s) = default;
+  flat_set(flat_set&& s) noexcept = default;
+  flat_set& operator=(flat_set&& s) noexcept;
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator cbegin();
+  const_iterator cend();
+
+  // Capacity
+  bool empty() const;
+  size_type size() const;
+  size_type max_size() const;
+  size_type capacity() const;
+  void reserve(size_type count);
+  void shrink_to_fit();
+
+  // Modifiers
+  void clear();
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  // Sorts the new keys and merges them in, O(n + m log m). Keys already
+  // present are kept.
+  template <typename InputIt>
+  void insert_range(InputIt first, InputIt last);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const Key& key);
+  void swap(flat_set& other) noexcept;
+
+  // Lookup. The templated overloads need a transparent Compare.
+  iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  size_type count(const Key& key);
+  bool contains(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  bool contains(const K& key);
+  iterator lower_bound(const Key& key);
+  iterator upper_bound(const Key& key);
+  std::pair<iterator, iterator> equal_range(const Key& key);
+
+  // Observers
+  key_compare key_comp() const;
+};
+
+}  // namespace s21
+
+#include "s21_flat_set.tpp"
+
+#endif
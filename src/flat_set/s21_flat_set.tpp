@@ -0,0 +1,280 @@
+#ifndef S21_FLAT_SET_TPP
+#define S21_FLAT_SET_TPP
+
+#include "s21_flat_set.h"
+
+namespace s21 {
+
+// Helpers
+template <typename Key, typename Compare>
+template <typename K>
+typename flat_set<Key, Compare>::size_type
+flat_set<Key, Compare>::lower_index(const K& key) {
+  return std::lower_bound(keys_.begin(), keys_.end(), key, comp_) -
+         keys_.begin();
+}
+
+template <typename Key, typename Compare>
+template <typename K>
+typename flat_set<Key, Compare>::size_type
+flat_set<Key, Compare>::upper_index(const K& key) {
+  return std::upper_bound(keys_.begin(), keys_.end(), key, comp_) -
+         keys_.begin();
+}
+
+template <typename Key, typename Compare>
+template <typename K>
+bool flat_set<Key, Compare>::found_at(size_type i, const K& key) {
+  return i < keys_.size() && !comp_(key, keys_.data()[i]);
+}
+
+// Keys from first on are new. They are sorted and deduplicated on their
+// own, then merged with the old ones; the stable merge puts an old key
+// before an equal new one, so unique keeps the old.
+template <typename Key, typename Compare>
+void flat_set<Key, Compare>::sort_and_unique(size_type first) {
+  Key* begin = keys_.begin();
+  Key* middle = begin + first;
+  auto equal = [this](const Key& a, const Key& b) { return !comp_(a, b); };
+
+  if (!std::is_sorted(middle, keys_.end(), comp_)) {
+    std::stable_sort(middle, keys_.end(), comp_);
+  }
+  truncate(std::unique(middle, keys_.end(), equal) - begin);
+  if (first > 0 && middle != keys_.end() && !comp_(*(middle - 1), *middle)) {
+    std::inplace_merge(begin, middle, keys_.end(), comp_);
+    truncate(std::unique(begin, keys_.end(), equal) - begin);
+  }
+}
+
+// The key is appended and rotated into place, one shift of the tail
+template <typename Key, typename Compare>
+template <typename V>
+std::pair<typename flat_set<Key, Compare>::iterator, bool>
+flat_set<Key, Compare>::insert_value(V&& value) {
+  size_type i = lower_index(value);
+  if (found_at(i, value)) {
+    return {keys_.begin() + i, false};
+  }
+  keys_.emplace_back(std::forward<V>(value));
+  std::rotate(keys_.begin() + i, keys_.end() - 1, keys_.end());
+  return {keys_.begin() + i, true};
+}
+
+template <typename Key, typename Compare>
+void flat_set<Key, Compare>::truncate(size_type size) {
+  while (keys_.size() > size) {
+    keys_.pop_back();
+  }
+}
+
+// Constructors
+template <typename Key, typename Compare>
+flat_set<Key, Compare>::flat_set(
+    std::initializer_list<value_type> const& items)
+    : flat_set(items.begin(), items.end()) {}
+
+template <typename Key, typename Compare>
+template <typename InputIt, typename>
+flat_set<Key, Compare>::flat_set(InputIt first, InputIt last,
+                                 const Compare& comp)
+    : comp_(comp) {
+  insert_range(first, last);
+}
+
+template <typename Key, typename Compare>
+flat_set<Key, Compare>& flat_set<Key, Compare>::operator=(
+    flat_set&& s) noexcept {
+  keys_ = std::move(s.keys_);
+  comp_ = std::move(s.comp_);
+  return *this;
+}
+
+// Iterators
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::begin() {
+  return keys_.begin();
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::end() {
+  return keys_.end();
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::const_iterator
+flat_set<Key, Compare>::cbegin() {
+  return keys_.begin();
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::const_iterator
+flat_set<Key, Compare>::cend() {
+  return keys_.end();
+}
+
+// Capacity
+template <typename Key, typename Compare>
+bool flat_set<Key, Compare>::empty() const {
+  return keys_.empty();
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::size_type flat_set<Key, Compare>::size()
+    const {
+  return keys_.size();
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::size_type flat_set<Key, Compare>::max_size()
+    const {
+  return keys_.max_size();
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::size_type flat_set<Key, Compare>::capacity()
+    const {
+  return keys_.capacity();
+}
+
+template <typename Key, typename Compare>
+void flat_set<Key, Compare>::reserve(size_type count) {
+  keys_.reserve(count);
+}
+
+template <typename Key, typename Compare>
+void flat_set<Key, Compare>::shrink_to_fit() {
+  keys_.shrink_to_fit();
+}
+
+// Modifiers
+template <typename Key, typename Compare>
+void flat_set<Key, Compare>::clear() {
+  keys_.clear();
+}
+
+template <typename Key, typename Compare>
+std::pair<typename flat_set<Key, Compare>::iterator, bool>
+flat_set<Key, Compare>::insert(const value_type& value) {
+  return insert_value(value);
+}
+
+template <typename Key, typename Compare>
+std::pair<typename flat_set<Key, Compare>::iterator, bool>
+flat_set<Key, Compare>::insert(value_type&& value) {
+  return insert_value(std::move(value));
+}
+
+template <typename Key, typename Compare>
+template <typename... Args>
+std::pair<typename flat_set<Key, Compare>::iterator, bool>
+flat_set<Key, Compare>::emplace(Args&&... args) {
+  return insert(Key(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename Compare>
+template <typename InputIt>
+void flat_set<Key, Compare>::insert_range(InputIt first, InputIt last) {
+  size_type old_size = keys_.size();
+  for (; first != last; ++first) {
+    keys_.emplace_back(*first);
+  }
+  sort_and_unique(old_size);
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::erase(
+    const_iterator pos) {
+  return erase(pos, pos + 1);
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::erase(
+    const_iterator first, const_iterator last) {
+  Key* begin = keys_.begin();
+  Key* from = begin + (first - begin);
+  Key* to = begin + (last - begin);
+  size_type size = keys_.size() - (to - from);
+  std::move(to, keys_.end(), from);
+  truncate(size);
+  return from;
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::size_type flat_set<Key, Compare>::erase(
+    const Key& key) {
+  size_type i = lower_index(key);
+  if (!found_at(i, key)) {
+    return 0;
+  }
+  erase(keys_.begin() + i);
+  return 1;
+}
+
+template <typename Key, typename Compare>
+void flat_set<Key, Compare>::swap(flat_set& other) noexcept {
+  keys_.swap(other.keys_);
+  std::swap(comp_, other.comp_);
+}
+
+// Lookup
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::find(
+    const Key& key) {
+  size_type i = lower_index(key);
+  return found_at(i, key) ? keys_.begin() + i : keys_.end();
+}
+
+template <typename Key, typename Compare>
+template <typename K, typename C, typename>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::find(
+    const K& key) {
+  size_type i = lower_index(key);
+  return found_at(i, key) ? keys_.begin() + i : keys_.end();
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::size_type flat_set<Key, Compare>::count(
+    const Key& key) {
+  return contains(key) ? 1 : 0;
+}
+
+template <typename Key, typename Compare>
+bool flat_set<Key, Compare>::contains(const Key& key) {
+  return found_at(lower_index(key), key);
+}
+
+template <typename Key, typename Compare>
+template <typename K, typename C, typename>
+bool flat_set<Key, Compare>::contains(const K& key) {
+  return found_at(lower_index(key), key);
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::lower_bound(
+    const Key& key) {
+  return keys_.begin() + lower_index(key);
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::iterator flat_set<Key, Compare>::upper_bound(
+    const Key& key) {
+  return keys_.begin() + upper_index(key);
+}
+
+template <typename Key, typename Compare>
+std::pair<typename flat_set<Key, Compare>::iterator,
+          typename flat_set<Key, Compare>::iterator>
+flat_set<Key, Compare>::equal_range(const Key& key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+template <typename Key, typename Compare>
+typename flat_set<Key, Compare>::key_compare flat_set<Key, Compare>::key_comp()
+    const {
+  return comp_;
+}
+
+}  // namespace s21
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef S21_FROZEN_MAP_H
+#define S21_FROZEN_MAP_H
+
+#include <memory>
+#include <utility>
+
+#include "../AVL/EytzingerTree.h"
+
+namespace s21 {
+
+// Read-only snapshot of a map for lookup-heavy use, see EytzingerTree.
+// Usually made by map::freeze().
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class frozen_map
+    : public EytzingerTree<Key, Compare, Allocator, MapNodePolicy<Key, T>> {
+  using tree_type =
+      EytzingerTree<Key, Compare, Allocator, MapNodePolicy<Key, T>>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  frozen_map() : tree_type() {}
+  // first..last must be sorted by key and free of equal keys
+  template <typename ForwardIt>
+  frozen_map(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : tree_type(first, last, comp, alloc) {}
+
+  // Element access. The templated overload needs a transparent Compare.
+  const T& at(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const T& at(const K& key) const;
+
+  // Lookup - from EytzingerTree
+  // find, count, contains, lower_bound, upper_bound, equal_range
+};
+
+}  // namespace s21
+
+#include "s21_frozen_map.tpp"
+
+#endif
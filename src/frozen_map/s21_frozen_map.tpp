@@ -0,0 +1,29 @@
+#ifndef S21_FROZEN_MAP_TPP
+#define S21_FROZEN_MAP_TPP
+
+#include "s21_frozen_map.h"
+
+namespace s21 {
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+const T& frozen_map<Key, T, Compare, Allocator>::at(const Key& key) const {
+  size_type position = this->find_position(key);
+  if (position == 0) {
+    throw std::out_of_range("Key not found");
+  }
+  return this->at_position(position).second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+const T& frozen_map<Key, T, Compare, Allocator>::at(const K& key) const {
+  size_type position = this->find_position(key);
+  if (position == 0) {
+    throw std::out_of_range("Key not found");
+  }
+  return this->at_position(position).second;
+}
+
+}  // namespace s21
+
+#endif
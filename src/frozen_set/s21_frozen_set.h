@@ -0,0 +1,42 @@
+#ifndef S21_FROZEN_SET_H
+#define S21_FROZEN_SET_H
+
+#include <memory>
+
+#include "../AVL/EytzingerTree.h"
+
+namespace s21 {
+
+// Read-only snapshot of a set for lookup-heavy use, see EytzingerTree.
+// Usually made by set::freeze().
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class frozen_set
+    : public EytzingerTree<Key, Compare, Allocator, SetNodePolicy<Key>> {
+  using tree_type = EytzingerTree<Key, Compare, Allocator, SetNodePolicy<Key>>;
+
+ public:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  frozen_set() : tree_type() {}
+  // first..last must be sorted and free of equal keys
+  template <typename ForwardIt>
+  frozen_set(ForwardIt first, ForwardIt last, const Compare& comp = Compare(),
+             const Allocator& alloc = Allocator())
+      : tree_type(first, last, comp, alloc) {}
+
+  // Lookup - from EytzingerTree
+  // find, count, contains, lower_bound, upper_bound, equal_range
+};
+
+}  // namespace s21
+
+#endif
@@ -6,74 +6,58 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <tuple>
 #include <vector>
 
 #include "../AVL/AVLTree.h"
+#include "../frozen_map/s21_frozen_map.h"
 #include "../vector/s21_vector.h"
 
 namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
+
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class map : public AVLTree<Key, T, Compare, Allocator> {
+  using tree_type = AVLTree<Key, T, Compare, Allocator>;
 
-template <typename Key, typename T>
-class map : public AVLTree<Key, T> {
  public:
   using key_type = Key;
   using mapped_type = T;
   using value_type = std::pair<const key_type, mapped_type>;
   using reference = value_type&;
   using const_reference = const value_type&;
-
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
  private:
-  using AVLTree<Key, T>::root_;
-  using AVLTree<Key, T>::size_;
+  using tree_type::root;
+  using tree_type::size_;
 
  public:
   // Member functions
-  map() : AVLTree<Key, T>() {}
+  map() : tree_type() {}
+  explicit map(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
   map(std::initializer_list<value_type> const& items);
-  map(const map& m) : AVLTree<Key, T>(m) {}
-  map(map&& m) : AVLTree<Key, T>(std::move(m)){};
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  map(InputIt first, InputIt last);
+  map(const map& m) : tree_type(m) {}
+  map(map&& m) : tree_type(std::move(m)){};
   ~map();
-  map<Key, T>& operator=(map&& m) noexcept;
-
- private:
-  class MapIterator : public AVLTree<Key, T>::Iterator {
-   private:
-    mutable value_type current_value_;
-
-   public:
-    using base_iterator = typename AVLTree<Key, T>::Iterator;
-
-    MapIterator() noexcept : base_iterator() {}
-    MapIterator(typename AVLTree<Key, T>::Node* node, AVLTree<Key, T>* tree)
-        : base_iterator(node, tree) {
-      update_value();
-    }
-    MapIterator(typename AVLTree<Key, T>::Node* node) : base_iterator(node) {
-      update_value();
-    }
-
-    void refresh();
-    void update_value();
-    MapIterator& operator++();
-    MapIterator operator++(int);
-    MapIterator& operator--();
-    MapIterator operator--(int);
-    value_type operator*() const;
-    value_type* operator->() const;
-  };
-
-  using iterator = MapIterator;
-  using const_iterator = MapIterator;
+  map& operator=(map&& m) noexcept;
 
- public:
-  iterator begin();
-  iterator end();
-
-  // Element access
+  // Element access. The templated overloads need a transparent Compare.
   T& at(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  T& at(const K& key);
   T& operator[](const Key& key);
+  T& operator[](Key&& key);
 
   // Capacity - from AVL full
   // bool empty();
@@ -83,19 +67,65 @@ class map : public AVLTree<Key, T> {
   // Modifiers
   // void clear(); - from AVL
   std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
   std::pair<iterator, bool> insert(const Key& key, const T& obj);
-  std::pair<iterator, bool> insert_or_assign(const Key& key, const T& obj);
+  iterator insert(const_iterator hint, const value_type& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(Key&& key, M&& obj);
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
   // void erase(iterator pos); - from AVL
+  // iterator erase(iterator first, iterator last); - from AVL
+  // size_type erase(const Key& key); - from AVL
   // void swap(map& other); - from AVL
   // void merge(map& other); - from AVL
 
   // Loockup
+  iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  // Writes find() of every key in [first, last) to out. The searches run
+  // in lockstep batches, see AVLTree::find_nodes.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out);
+  size_type count(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key);
   // bool contains(const Key& key); - from AVL
+  // OutputIt contains_batch(first, last, out); - from AVL
+  // lower_bound, upper_bound, equal_range - from AVL
+
+  // Order statistics
+  // iterator select(size_type k); - from AVL
+  // size_type rank(const Key& key); - from AVL
+  // size_type count_range(const Key& lo, const Key& hi); - from AVL
 
   template <typename... Args>
   vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  // Snapshots - from AVL
+  // void save(const std::string& path) const;
+  // void save(std::ostream& out) const;
+  // void load(const std::string& path);
+  // void load(std::istream& in);
+
+  // Read-only copy with faster lookups, see frozen_map
+  frozen_map<Key, T, Compare, Allocator> freeze();
 };
 
+S21_STATS_NAMESPACE_END
 }  // namespace s21
 
 #include "s21_map.tpp"
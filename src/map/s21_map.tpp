@@ -4,167 +4,225 @@
 #include "s21_map.h"
 
 namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
 
 // Member functions
-template <typename Key, typename T>
-map<Key, T>::map(std::initializer_list<value_type> const& items) {
-  this->root_ = nullptr;
-  this->size_ = 0;
-  for (const auto& item : items) {
-    insert(item);
-  }
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>::map(
+    std::initializer_list<value_type> const& items) {
+  assign_sorted(items.begin(), items.end());
 }
 
-template <typename Key, typename T>
-map<Key, T>& map<Key, T>::operator=(map&& m) noexcept {
-  if (this != &m) {
-    root_ = m.root_;
-    size_ = m.size_;
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+map<Key, T, Compare, Allocator>::map(InputIt first, InputIt last) {
+  assign_sorted(first, last);
+}
 
-    m.root_ = nullptr;
-    m.size_ = 0;
-  }
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>&
+map<Key, T, Compare, Allocator>::operator=(map&& m) noexcept {
+  tree_type::operator=(std::move(m));
   return *this;
 }
 
-template <typename Key, typename T>
-map<Key, T>::~map() {
-  AVLTree<Key, T>::clear();
+template <typename Key, typename T, typename Compare, typename Allocator>
+map<Key, T, Compare, Allocator>::~map() {
+  tree_type::clear();
 }
 
 // Element access
-template <typename Key, typename T>
-typename map<Key, T>::mapped_type& map<Key, T>::at(const Key& key) {
-  auto node = this->find_node(this->root_, key);
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::mapped_type&
+map<Key, T, Compare, Allocator>::at(const Key& key) {
+  auto node = this->find_node(root(), key);
   if (!node) {
     throw std::out_of_range("Key not found");
   }
-  return node->value_;
+  return node->data_.second;
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::mapped_type& map<Key, T>::operator[](const Key& key) {
-  auto node = this->find_node(this->root_, key);
-  if (node) {
-    return node->value_;
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::mapped_type&
+map<Key, T, Compare, Allocator>::at(const K& key) {
+  auto node = this->find_node(root(), key);
+  if (!node) {
+    throw std::out_of_range("Key not found");
   }
-  mapped_type default_value = mapped_type();
-  insert(std::make_pair(key, default_value));
-  node = this->find_node(this->root_, key);
+  return node->data_.second;
+}
 
-  return node->value_;
+// A missing key gets a value-initialized T, found or inserted in one descent
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::mapped_type&
+map<Key, T, Compare, Allocator>::operator[](const Key& key) {
+  return try_emplace(key).first->second;
 }
 
-// Iterator
-template <typename Key, typename T>
-typename map<Key, T>::value_type map<Key, T>::MapIterator::operator*() const {
-  return current_value_;
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::mapped_type&
+map<Key, T, Compare, Allocator>::operator[](Key&& key) {
+  return try_emplace(std::move(key)).first->second;
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::value_type* map<Key, T>::MapIterator::operator->() const {
-  return &current_value_;
+// Lookup
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::find(const Key& key) {
+  auto node = this->find_node(root(), key);
+  return node != nullptr ? iterator(node) : this->end();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::MapIterator& map<Key, T>::MapIterator::operator++() {
-  base_iterator::operator++();
-  update_value();
-  return *this;
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::find(const K& key) {
+  auto node = this->find_node(root(), key);
+  return node != nullptr ? iterator(node) : this->end();
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::MapIterator map<Key, T>::MapIterator::operator++(int) {
-  MapIterator temp = *this;
-  ++(*this);
-  return temp;
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt map<Key, T, Compare, Allocator>::find_batch(ForwardIt first,
+                                                     ForwardIt last,
+                                                     OutputIt out) {
+  this->find_nodes(first, last, [this, &out](auto* node) {
+    *out++ = node != nullptr ? iterator(node) : this->end();
+  });
+  return out;
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::MapIterator& map<Key, T>::MapIterator::operator--() {
-  base_iterator::operator--();
-  update_value();
-  return *this;
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::size_type
+map<Key, T, Compare, Allocator>::count(const Key& key) {
+  return this->find_node(root(), key) != nullptr ? 1 : 0;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename map<Key, T, Compare, Allocator>::size_type
+map<Key, T, Compare, Allocator>::count(const K& key) {
+  return this->find_node(root(), key) != nullptr ? 1 : 0;
+}
+
+// Modifiers
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(const value_type& value) {
+  return tree_type::insert(value.first, value.second);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(value_type&& value) {
+  return this->emplace_unique(value.first, std::move(value));
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::MapIterator map<Key, T>::MapIterator::operator--(int) {
-  MapIterator temp = *this;
-  --(*this);
-  return temp;
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert(const Key& key, const T& obj) {
+  return tree_type::insert(key, obj);
 }
 
-template <typename Key, typename T>
-void map<Key, T>::MapIterator::update_value() {
-  const auto* node = this->get_node();
-  if (node) {
-    new (&current_value_) value_type{node->key_, node->value_};
+// obj is either moved into a new node or assigned to the present value
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert_or_assign(const Key& key, M&& obj) {
+  auto result = try_emplace(key, std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
   }
+  return result;
 }
 
-template <typename Key, typename T>
-void map<Key, T>::MapIterator::refresh() {
-  const auto* node = this->get_node();
-  if (node) {
-    new (&current_value_) value_type{node->key_, node->value_};
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::insert_or_assign(Key&& key, M&& obj) {
+  auto result = try_emplace(std::move(key), std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
   }
+  return result;
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::iterator map<Key, T>::begin() {
-  return iterator(this->find_min_node(this->root_), this);
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::insert(const_iterator hint,
+                                        const value_type& value) {
+  return tree_type::insert(hint, value.first, value.second);
 }
 
-template <typename Key, typename T>
-typename map<Key, T>::iterator map<Key, T>::end() {
-  return iterator(nullptr, this);
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+typename map<Key, T, Compare, Allocator>::iterator
+map<Key, T, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                              Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return this
+      ->insert_hint_unique(this->hint_position(hint), value.first,
+                           std::move(value))
+      .first;
+}
+
+// The pair is built once from args, then moved into the node
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::emplace(Args&&... args) {
+  std::pair<Key, T> value(std::forward<Args>(args)...);
+  return this->emplace_unique(value.first, std::move(value));
 }
 
-// Modifiers
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
-    const value_type& value) {
-  auto result = AVLTree<Key, T>::insert(value.first, value.second);
-  iterator map_iter(result.first.get_node(), this);
-  return {map_iter, result.second};
-}
-
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert(
-    const Key& key, const T& obj) {
-  auto result = AVLTree<Key, T>::insert(key, obj);
-  MapIterator map_iter(result.first.get_node(), this);
-  return {map_iter, result.second};
-}
-
-template <typename Key, typename T>
-std::pair<typename map<Key, T>::iterator, bool> map<Key, T>::insert_or_assign(
-    const Key& key, const T& obj) {
-  auto result = AVLTree<Key, T>::insert(key, obj);
-
-  MapIterator map_iter(result.first.get_node(), this);
-
-  if (result.second) {
-    return {map_iter, true};
-  } else {
-    result.first.get_node()->value_ = obj;
-    map_iter.refresh();
-    return {map_iter, false};
-  }
+// The value is constructed from args in place, and only if key is missing
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::try_emplace(const Key& key, Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
-template <typename Key, typename T>
+template <typename Key, typename T, typename Compare, typename Allocator>
 template <typename... Args>
-vector<std::pair<typename map<Key, T>::iterator, bool>>
-map<Key, T>::insert_many(Args&&... args) {
-  vector<std::pair<map<Key, T>::iterator, bool>> v;
-  for (auto& arg : {args...}) {
-    v.push_back(insert(arg));
-  }
+std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>
+map<Key, T, Compare, Allocator>::try_emplace(Key&& key, Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+// Sorted forward ranges (duplicate keys keep the first value) are built
+// bottom-up in O(n), unsorted or single-pass input falls back to one insert
+// per element
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename InputIt>
+void map<Key, T, Compare, Allocator>::assign_sorted(InputIt first,
+                                                    InputIt last) {
+  this->assign_range(first, last);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+vector<std::pair<typename map<Key, T, Compare, Allocator>::iterator, bool>>
+map<Key, T, Compare, Allocator>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> v;
+  (v.push_back(emplace(std::forward<Args>(args))), ...);
 
   return v;
 }
 
+template <typename Key, typename T, typename Compare, typename Allocator>
+frozen_map<Key, T, Compare, Allocator>
+map<Key, T, Compare, Allocator>::freeze() {
+  return frozen_map<Key, T, Compare, Allocator>(
+      this->begin(), this->end(), this->comp_, this->get_allocator());
+}
+
+S21_STATS_NAMESPACE_END
 }  // namespace s21
 
 #endif
\ No newline at end of file
@@ -5,93 +5,97 @@
 #include <vector>
 
 #include "../AVL/AVLTree.h"
-#include "../set/s21_set.h"
 #include "../vector/s21_vector.h"
 
 namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
 
-template <typename T>
-struct Wrapper {
-  std::vector<T> items;
+// Equal keys are stored as separate nodes, so the subtree counts of the
+// tree count every element and the order statistics work as for set.
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class multiset
+    : public AVLTree<Key, Key, Compare, Allocator, SetNodePolicy<Key>> {
+  using tree_type = AVLTree<Key, Key, Compare, Allocator, SetNodePolicy<Key>>;
 
-  Wrapper(const T& value);
-
-  bool operator==(const Wrapper<T>& other) const;
-  bool operator<(const Wrapper<T>& other) const;
-  bool operator>(const Wrapper<T>& other) const;
-  bool operator<=(const Wrapper<T>& other) const;
-  bool operator>=(const Wrapper<T>& other) const;
-};
-
-template <typename Key>
-class multiset {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
   // Конструкторы и деструктор
   multiset();
+  explicit multiset(const Compare& comp,
+                    const Allocator& alloc = Allocator());
   multiset(std::initializer_list<value_type> const& items);
   multiset(const multiset& ms);
   multiset(multiset&& ms);
   ~multiset();
   multiset& operator=(multiset&& ms);
 
-  class Iterator {
-   public:
-    typename s21::set<Wrapper<Key>>::Iterator set_iter;
-    size_type index;
-
-    Iterator(typename s21::set<Wrapper<Key>>::Iterator set_iter,
-             size_type index)
-        : set_iter(set_iter), index(index) {}
-
-    bool operator==(const Iterator& other) const;
-    bool operator!=(const Iterator& other) const;
-    Iterator& operator++();
-    Iterator operator++(int);
-    Iterator& operator--();
-    Iterator operator--(int);
-    // Iterator operator--(int);
-    value_type operator*();
-  };
-
-  using iterator = Iterator;
-
-  iterator begin();
-  iterator end();
-
   // Модификаторы
   iterator insert(const value_type& value);
+  iterator insert(value_type&& value);
+  iterator insert(const_iterator hint, const value_type& value);
+  template <typename... Args>
+  iterator emplace(Args&&... args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
+  using tree_type::erase;
   void erase(iterator pos);
-  void swap(multiset& other);
+  // iterator erase(iterator first, iterator last); - from AVL
+  // size_type erase(const Key& key); - from AVL, removes all copies
   void merge(multiset& other);
-  void clear();
+  // void swap(multiset& other); - from AVL
+  // void clear(); - from AVL
 
-  // Поиск
+  // Поиск. Шаблонные перегрузки требуют прозрачного Compare.
   iterator find(const value_type& value);
-  std::pair<iterator, iterator> equal_range(const Key& key);
-  iterator lower_bound(const Key& key);
-  iterator upper_bound(const Key& key);
-  bool contains(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
   size_type count(const Key& key);
-
-  // Capacity
-  bool empty();
-  size_type size();
-  size_type max_size();
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key);
+  // bool contains(const Key& key); - from AVL
+  // iterator lower_bound(const Key& key); - from AVL
+  // iterator upper_bound(const Key& key); - from AVL
+  // std::pair<iterator, iterator> equal_range(const Key& key); - from AVL
+
+  // Capacity - from AVL
+  // bool empty();
+  // size_type size();
+  // size_type max_size();
+
+  // Order statistics - from AVL
+  // iterator select(size_type k);
+  // size_type rank(const Key& key);
+  // size_type count_range(const Key& lo, const Key& hi);
+
+  // Snapshots - from AVL, copies of a key are kept
+  // void save(const std::string& path) const;
+  // void save(std::ostream& out) const;
+  // void load(const std::string& path);
+  // void load(std::istream& in);
 
   template <typename... Args>
   vector<std::pair<iterator, bool>> insert_many(Args&&... args);
 
  private:
-  s21::set<Wrapper<Key>> _set;
-  size_type _size;
+  // The join-based set algebra assumes unique keys
+  using tree_type::set_union;
+  using tree_type::set_intersection;
+  using tree_type::set_difference;
 };
 
+S21_STATS_NAMESPACE_END
 }  // namespace s21
 
 #include "s21_multiset.tpp"
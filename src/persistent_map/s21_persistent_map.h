@@ -0,0 +1,89 @@
+#ifndef S21_PERSISTENT_MAP_H
+#define S21_PERSISTENT_MAP_H
+
+#include <initializer_list>
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "../AVL/PersistentAVLTree.h"
+
+namespace s21 {
+
+// map with O(1) snapshots, see PersistentAVLTree. A snapshot is an
+// independent map that shares all nodes with its source; either may be
+// changed afterwards without affecting the other, and readers may keep
+// using a snapshot on other threads while the source is modified.
+//
+// Values are read only through iterators, insert_or_assign replaces one.
+// Key and T must be copyable, shared nodes are copied before a change.
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class persistent_map : public PersistentAVLTree<Key, Compare, Allocator,
+                                                MapNodePolicy<Key, T>> {
+  using tree_type =
+      PersistentAVLTree<Key, Compare, Allocator, MapNodePolicy<Key, T>>;
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  // Member functions
+  persistent_map() : tree_type() {}
+  explicit persistent_map(const Compare& comp,
+                          const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
+  persistent_map(std::initializer_list<value_type> const& items);
+  persistent_map(const persistent_map& m) noexcept : tree_type(m) {}
+  persistent_map(persistent_map&& m) noexcept : tree_type(std::move(m)) {}
+  persistent_map& operator=(const persistent_map& m) noexcept;
+  persistent_map& operator=(persistent_map&& m) noexcept;
+
+  // The current contents as a map of their own, O(1)
+  persistent_map snapshot() const;
+
+  // Element access. The templated overload needs a transparent Compare.
+  const T& at(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const T& at(const K& key) const;
+
+  // Modifiers. Each copies the shared nodes on one search path.
+  // void clear(); - from PersistentAVLTree
+  std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  std::pair<iterator, bool> insert(const Key& key, const T& obj);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj);
+  // size_type erase(const Key& key); - from PersistentAVLTree
+  // void swap(persistent_map& other); - from PersistentAVLTree
+
+  // Lookup
+  const_iterator find(const Key& key) const;
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  const_iterator find(const K& key) const;
+  size_type count(const Key& key) const;
+  // bool contains(const Key& key); - from PersistentAVLTree
+  // lower_bound, upper_bound, equal_range - from PersistentAVLTree
+};
+
+}  // namespace s21
+
+#include "s21_persistent_map.tpp"
+
+#endif
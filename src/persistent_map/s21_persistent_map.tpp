@@ -0,0 +1,142 @@
+#ifndef S21_PERSISTENT_MAP_TPP
+#define S21_PERSISTENT_MAP_TPP
+
+#include "s21_persistent_map.h"
+
+namespace s21 {
+
+// Member functions
+template <typename Key, typename T, typename Compare, typename Allocator>
+persistent_map<Key, T, Compare, Allocator>::persistent_map(
+    std::initializer_list<value_type> const& items) {
+  for (const value_type& item : items) {
+    insert(item);
+  }
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+persistent_map<Key, T, Compare, Allocator>&
+persistent_map<Key, T, Compare, Allocator>::operator=(
+    const persistent_map& m) noexcept {
+  tree_type::operator=(m);
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+persistent_map<Key, T, Compare, Allocator>&
+persistent_map<Key, T, Compare, Allocator>::operator=(
+    persistent_map&& m) noexcept {
+  tree_type::operator=(std::move(m));
+  return *this;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+persistent_map<Key, T, Compare, Allocator>
+persistent_map<Key, T, Compare, Allocator>::snapshot() const {
+  return *this;
+}
+
+// Element access
+template <typename Key, typename T, typename Compare, typename Allocator>
+const T& persistent_map<Key, T, Compare, Allocator>::at(const Key& key) const {
+  auto node = this->find_node(key);
+  if (!node) {
+    throw std::out_of_range("Key not found");
+  }
+  return node->value.second;
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+const T& persistent_map<Key, T, Compare, Allocator>::at(const K& key) const {
+  auto node = this->find_node(key);
+  if (!node) {
+    throw std::out_of_range("Key not found");
+  }
+  return node->value.second;
+}
+
+// Modifiers
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::insert(const value_type& value) {
+  return this->emplace_unique(value.first, value);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::insert(value_type&& value) {
+  return this->emplace_unique(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::insert(const Key& key,
+                                                   const T& obj) {
+  return this->emplace_unique(key, key, obj);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::emplace(Args&&... args) {
+  value_type value(std::forward<Args>(args)...);
+  return this->emplace_unique(value.first, std::move(value));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::try_emplace(const Key& key,
+                                                        Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::try_emplace(Key&& key,
+                                                        Args&&... args) {
+  return this->emplace_unique(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+// An existing value is replaced in a private copy of its node
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename persistent_map<Key, T, Compare, Allocator>::iterator, bool>
+persistent_map<Key, T, Compare, Allocator>::insert_or_assign(const Key& key,
+                                                             M&& obj) {
+  if (!this->contains(key)) {
+    return try_emplace(key, std::forward<M>(obj));
+  }
+  this->own_path(key)->value.second = std::forward<M>(obj);
+  return {this->path_to(key), false};
+}
+
+// Lookup
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::const_iterator
+persistent_map<Key, T, Compare, Allocator>::find(const Key& key) const {
+  return this->path_to(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename persistent_map<Key, T, Compare, Allocator>::const_iterator
+persistent_map<Key, T, Compare, Allocator>::find(const K& key) const {
+  return this->path_to(key);
+}
+
+template <typename Key, typename T, typename Compare, typename Allocator>
+typename persistent_map<Key, T, Compare, Allocator>::size_type
+persistent_map<Key, T, Compare, Allocator>::count(const Key& key) const {
+  return this->contains(key) ? 1 : 0;
+}
+
+}  // namespace s21
+
+#endif
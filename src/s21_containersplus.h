@@ -2,6 +2,17 @@
 #define S21_CONTAINERSPLUS_H
 
 #include "array/s21_array.h"
+#include "btree_map/s21_btree_map.h"
+#include "btree_set/s21_btree_set.h"
+#include "compact_map/s21_compact_map.h"
+#include "compact_set/s21_compact_set.h"
+#include "concurrent_map/s21_concurrent_map.h"
+#include "flat_map/s21_flat_map.h"
+#include "flat_set/s21_flat_set.h"
+#include "frozen_map/s21_frozen_map.h"
+#include "frozen_set/s21_frozen_set.h"
 #include "multiset/s21_multiset.h"
+#include "persistent_map/s21_persistent_map.h"
+#include "sharded_map/s21_sharded_map.h"
 
 #endif
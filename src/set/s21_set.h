@@ -2,30 +2,43 @@
 #define S21_SET_H
 
 #include "../AVL/AVLTree.h"
+#include "../frozen_set/s21_frozen_set.h"
 #include "../vector/s21_vector.h"
 
 namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class set
+    : public AVLTree<Key, Key, Compare, Allocator, SetNodePolicy<Key>> {
+  using tree_type = AVLTree<Key, Key, Compare, Allocator, SetNodePolicy<Key>>;
 
-template <typename Key>
-class set : public AVLTree<Key, Key> {
  public:
   using key_type = Key;
   using value_type = Key;
   using reference = value_type&;
   using const_reference = const value_type&;
-  using iterator = typename AVLTree<Key, Key>::iterator;
-  using const_iterator = typename AVLTree<Key, Key>::const_iterator;
+  using iterator = typename tree_type::iterator;
+  using const_iterator = typename tree_type::const_iterator;
   using size_type = size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
  private:
-  using AVLTree<Key, Key>::root_;
-  using AVLTree<Key, Key>::size_;
+  using tree_type::root;
+  using tree_type::size_;
 
  public:
-  set() : AVLTree<Key, Key>() {}
+  set() : tree_type() {}
+  explicit set(const Compare& comp, const Allocator& alloc = Allocator())
+      : tree_type(comp, alloc) {}
   set(std::initializer_list<value_type> const& items);
-  set(const set& s) : AVLTree<Key, Key>(s) {}
-  set(set&& s) : AVLTree<Key, Key>(std::move(s)){};
+  template <typename InputIt, typename = typename std::iterator_traits<
+                                  InputIt>::iterator_category>
+  set(InputIt first, InputIt last);
+  set(const set& s) : tree_type(s) {}
+  set(set&& s) : tree_type(std::move(s)){};
   ~set();
   set& operator=(set&& s) noexcept;
 
@@ -37,18 +50,53 @@ class set : public AVLTree<Key, Key> {
   // Modifiers
   // void clear(); - from AVL
   std::pair<iterator, bool> insert(const value_type& value);
+  std::pair<iterator, bool> insert(value_type&& value);
+  iterator insert(const_iterator hint, const value_type& value);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args&&... args);
+  template <typename InputIt>
+  void assign_sorted(InputIt first, InputIt last);
   // void erase(iterator pos); - from AVL
+  // iterator erase(iterator first, iterator last); - from AVL
+  // size_type erase(const Key& key); - from AVL
   // void swap(set& other); - from AVL
   // void merge(set& other); - from AVL
 
-  // Lookup
+  // Lookup. The templated overloads need a transparent Compare.
   iterator find(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  iterator find(const K& key);
+  // Writes find() of every key in [first, last) to out. The searches run
+  // in lockstep batches, see AVLTree::find_nodes.
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_batch(ForwardIt first, ForwardIt last, OutputIt out);
+  size_type count(const Key& key);
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type count(const K& key);
   // bool contains(const Key& key); - from AVL
+  // OutputIt contains_batch(first, last, out); - from AVL
+  // iterator lower_bound(const Key& key); - from AVL
+  // iterator upper_bound(const Key& key); - from AVL
+  // std::pair<iterator, iterator> equal_range(const Key& key); - from AVL
 
   template <typename... Args>
   vector<std::pair<iterator, bool>> insert_many(Args&&... args);
+
+  // Snapshots - from AVL
+  // void save(const std::string& path) const;
+  // void save(std::ostream& out) const;
+  // void load(const std::string& path);
+  // void load(std::istream& in);
+
+  // Read-only copy with faster lookups, see frozen_set
+  frozen_set<Key, Compare, Allocator> freeze();
 };
 
+S21_STATS_NAMESPACE_END
 }  // namespace s21
 
 #include "s21_set.tpp"
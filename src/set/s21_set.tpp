@@ -6,60 +6,138 @@
 #include "s21_set.h"
 
 namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
 
 // CONSTRUCTORS
-template <typename Key>
-set<Key>::set(std::initializer_list<value_type> const& items) {
-  this->root_ = nullptr;
-  this->size_ = 0;
-  for (const auto& item : items) {
-    insert(item);
-  }
-}
-
-template <typename Key>
-set<Key>& set<Key>::operator=(set&& s) noexcept {
-  if (this != &s) {
-    root_ = s.root_;
-    size_ = s.size_;
-
-    s.root_ = nullptr;
-    s.size_ = 0;
-  }
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::set(
+    std::initializer_list<value_type> const& items) {
+  assign_sorted(items.begin(), items.end());
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+set<Key, Compare, Allocator>::set(InputIt first, InputIt last) {
+  assign_sorted(first, last);
+}
+
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>& set<Key, Compare, Allocator>::operator=(
+    set&& s) noexcept {
+  tree_type::operator=(std::move(s));
   return *this;
 }
 
-template <typename Key>
-set<Key>::~set() {
-  AVLTree<Key, Key>::clear();
+template <typename Key, typename Compare, typename Allocator>
+set<Key, Compare, Allocator>::~set() {
+  tree_type::clear();
 }
 
 // Modifiers
-template <typename Key>
-std::pair<typename set<Key>::iterator, bool> set<Key>::insert(
-    const typename set<Key>::value_type& value) {
-  return AVLTree<Key, Key>::insert(value, value);
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::insert(const value_type& value) {
+  return this->emplace_unique(value, value);
+}
+
+// The node takes over value
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::insert(value_type&& value) {
+  return this->emplace_unique(value, std::move(value));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename set<Key, Compare, Allocator>::iterator, bool>
+set<Key, Compare, Allocator>::emplace(Args&&... args) {
+  return insert(value_type(std::forward<Args>(args)...));
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::insert(const_iterator hint,
+                                     const value_type& value) {
+  return this->insert_hint_unique(this->hint_position(hint), value, value)
+      .first;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                           Args&&... args) {
+  value_type value(std::forward<Args>(args)...);
+  return this
+      ->insert_hint_unique(this->hint_position(hint), value, std::move(value))
+      .first;
+}
+
+// Sorted forward ranges (duplicates allowed) are built bottom-up in O(n),
+// unsorted or single-pass input falls back to one insert per element
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt>
+void set<Key, Compare, Allocator>::assign_sorted(InputIt first, InputIt last) {
+  this->assign_range(first, last);
 }
 
 // Lookup
-template <typename Key>
-typename set<Key>::iterator set<Key>::find(const Key& key) {
-  return iterator(this->find_node(root_, key), this);
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::find(const Key& key) {
+  auto node = this->find_node(root(), key);
+  return node != nullptr ? iterator(node) : this->end();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::iterator
+set<Key, Compare, Allocator>::find(const K& key) {
+  auto node = this->find_node(root(), key);
+  return node != nullptr ? iterator(node) : this->end();
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt set<Key, Compare, Allocator>::find_batch(ForwardIt first,
+                                                  ForwardIt last,
+                                                  OutputIt out) {
+  this->find_nodes(first, last, [this, &out](auto* node) {
+    *out++ = node != nullptr ? iterator(node) : this->end();
+  });
+  return out;
 }
 
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
+typename set<Key, Compare, Allocator>::size_type
+set<Key, Compare, Allocator>::count(const Key& key) {
+  return this->find_node(root(), key) != nullptr ? 1 : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename set<Key, Compare, Allocator>::size_type
+set<Key, Compare, Allocator>::count(const K& key) {
+  return this->find_node(root(), key) != nullptr ? 1 : 0;
+}
+
+template <typename Key, typename Compare, typename Allocator>
 template <typename... Args>
-vector<std::pair<typename set<Key>::iterator, bool>> set<Key>::insert_many(
-    Args&&... args) {
-  vector<std::pair<set<Key>::iterator, bool>> v;
-  for (auto& arg : {args...}) {
-    // v.push_back(std::make_pair(insert(arg), true));
-    v.push_back(insert(arg));
-  }
+vector<std::pair<typename set<Key, Compare, Allocator>::iterator, bool>>
+set<Key, Compare, Allocator>::insert_many(Args&&... args) {
+  vector<std::pair<iterator, bool>> v;
+  (v.push_back(emplace(std::forward<Args>(args))), ...);
 
   return v;
 }
 
+template <typename Key, typename Compare, typename Allocator>
+frozen_set<Key, Compare, Allocator> set<Key, Compare, Allocator>::freeze() {
+  return frozen_set<Key, Compare, Allocator>(
+      this->begin(), this->end(), this->comp_, this->get_allocator());
+}
+
+S21_STATS_NAMESPACE_END
 }  // namespace s21
 
 #endif
\ No newline at end of file
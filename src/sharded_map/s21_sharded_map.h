@@ -0,0 +1,184 @@
+#ifndef S21_SHARDED_MAP_H
+#define S21_SHARDED_MAP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../map/s21_map.h"
+
+namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
+
+// Thread-safe map made of Shards independent s21::maps. Keys go to a shard
+// by hash, and every shard has its own reader-writer lock, so operations on
+// different shards never wait for each other. Single-key operations lock
+// one shard; multi_insert and multi_find sort their keys by shard and take
+// each lock once.
+//
+// Ordered access goes through a ReadView, which holds the shared locks of
+// all shards and merges them by key. A thread must not modify the map
+// while it holds a view of it. Lookups return copies, T must be copy
+// constructible.
+template <typename Key, typename T, std::size_t Shards = 16,
+          typename Compare = std::less<Key>, typename Hash = std::hash<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, T>>>
+class sharded_map {
+  static_assert(Shards > 0, "sharded_map needs at least one shard");
+
+ public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using const_reference = const value_type&;
+  using size_type = size_t;
+  using key_compare = Compare;
+  using hasher = Hash;
+  using allocator_type = Allocator;
+  using map_type = map<Key, T, Compare, Allocator>;
+
+  static constexpr size_type kShards = Shards;
+
+ private:
+  // Lookups of s21::map are not const but only read, so shared lock holders
+  // may call them
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    mutable map_type map;
+  };
+
+  std::unique_ptr<Shard[]> shards_;
+  Compare comp_;
+  Hash hash_;
+
+  size_type shard_of(const Key& key) const;
+  // Indices into items grouped by shard; starts[s] to starts[s + 1] are
+  // those of shard s
+  template <typename ForwardIt, typename KeyOf>
+  void group_by_shard(const std::vector<ForwardIt>& items, KeyOf key_of,
+                      std::vector<size_type>& order,
+                      std::array<size_type, Shards + 1>& starts) const;
+
+ public:
+  // Forward iterator over all shards in key order, a k-way merge with a
+  // binary heap of shards ordered by their current keys
+  class MergeIterator {
+    friend class sharded_map;
+
+   protected:
+    using shard_iterator = typename map_type::const_iterator;
+
+    std::array<shard_iterator, Shards> current_;
+    std::array<shard_iterator, Shards> end_;
+    // Shards not yet exhausted, the one with the smallest key first
+    std::array<size_type, Shards> heap_;
+    size_type heap_size_ = 0;
+    Compare comp_;
+
+    bool heap_less(size_type a, size_type b) const;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename sharded_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    MergeIterator() = default;
+
+    bool operator==(const MergeIterator& other) const;
+    bool operator!=(const MergeIterator& other) const;
+    const_reference operator*() const;
+    const value_type* operator->() const;
+    MergeIterator& operator++();
+    MergeIterator operator++(int);
+  };
+
+  // Shared locks on all shards, taken in shard order. Iterators are valid
+  // while the view lives.
+  class ReadView {
+    friend class sharded_map;
+
+    const sharded_map* map_;
+    std::array<std::shared_lock<std::shared_mutex>, Shards> locks_;
+
+    explicit ReadView(const sharded_map& m);
+    template <typename Bound>
+    MergeIterator merge(Bound bound) const;
+
+   public:
+    using const_iterator = MergeIterator;
+    using iterator = MergeIterator;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const_iterator lower_bound(const Key& key) const;
+    const_iterator upper_bound(const Key& key) const;
+    bool empty() const;
+    size_type size() const;
+  };
+
+  // Member functions. The map is shared between threads, not copied.
+  sharded_map();
+  explicit sharded_map(const Compare& comp, const Hash& hash = Hash(),
+                       const Allocator& alloc = Allocator());
+  sharded_map(std::initializer_list<value_type> const& items);
+  sharded_map(const sharded_map& other) = delete;
+  sharded_map& operator=(const sharded_map& other) = delete;
+
+  // A view of all shards at one point in time
+  ReadView read() const;
+
+  // Capacity. Shards are counted one after another, so size() may be off
+  // while other threads are modifying the map.
+  bool empty() const;
+  size_type size() const;
+
+  // Modifiers. Each returns whether key was new.
+  void clear();
+  bool insert(const value_type& value);
+  bool insert(const Key& key, const T& obj);
+  template <typename... Args>
+  bool try_emplace(const Key& key, Args&&... args);
+  template <typename M>
+  bool insert_or_assign(const Key& key, M&& obj);
+  size_type erase(const Key& key);
+
+  // Batches. multi_insert returns how many keys were new, multi_find the
+  // values in the order of the keys.
+  template <typename ForwardIt>
+  size_type multi_insert(ForwardIt first, ForwardIt last);
+  size_type multi_insert(std::initializer_list<value_type> const& items);
+  template <typename ForwardIt>
+  std::vector<std::optional<T>> multi_find(ForwardIt first,
+                                           ForwardIt last) const;
+  std::vector<std::optional<T>> multi_find(
+      std::initializer_list<Key> const& keys) const;
+
+  // Lookup
+  std::optional<T> find(const Key& key) const;
+  T at(const Key& key) const;
+  bool contains(const Key& key) const;
+  size_type count(const Key& key) const;
+
+  // Observers
+  key_compare key_comp() const;
+  hasher hash_function() const;
+};
+
+S21_STATS_NAMESPACE_END
+}  // namespace s21
+
+#include "s21_sharded_map.tpp"
+
+#endif
@@ -0,0 +1,445 @@
+#ifndef S21_SHARDED_MAP_TPP
+#define S21_SHARDED_MAP_TPP
+
+#include "s21_sharded_map.h"
+
+namespace s21 {
+S21_STATS_NAMESPACE_BEGIN
+
+// Member functions
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::sharded_map()
+    : shards_(new Shard[Shards]) {}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::sharded_map(
+    const Compare& comp, const Hash& hash, const Allocator& alloc)
+    : shards_(new Shard[Shards]), comp_(comp), hash_(hash) {
+  for (size_type i = 0; i < Shards; ++i) {
+    shards_[i].map = map_type(comp, alloc);
+  }
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::sharded_map(
+    std::initializer_list<value_type> const& items)
+    : sharded_map() {
+  multi_insert(items);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::read() const {
+  return ReadView(*this);
+}
+
+// Fibonacci hashing spreads hashes that are the identity, like those of
+// std::hash<int>, over the shards
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size_type
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::shard_of(
+    const Key& key) const {
+  std::uint64_t mixed =
+      static_cast<std::uint64_t>(hash_(key)) * 0x9e3779b97f4a7c15ull;
+  return static_cast<size_type>((mixed >> 32) % Shards);
+}
+
+// Counting sort by shard
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+template <typename ForwardIt, typename KeyOf>
+void sharded_map<Key, T, Shards, Compare, Hash, Allocator>::group_by_shard(
+    const std::vector<ForwardIt>& items, KeyOf key_of,
+    std::vector<size_type>& order,
+    std::array<size_type, Shards + 1>& starts) const {
+  std::vector<size_type> shard(items.size());
+  starts.fill(0);
+  for (size_type i = 0; i < items.size(); ++i) {
+    shard[i] = shard_of(key_of(*items[i]));
+    ++starts[shard[i] + 1];
+  }
+  for (size_type s = 0; s < Shards; ++s) {
+    starts[s + 1] += starts[s];
+  }
+  std::array<size_type, Shards> next;
+  std::copy(starts.begin(), starts.end() - 1, next.begin());
+  order.resize(items.size());
+  for (size_type i = 0; i < items.size(); ++i) {
+    order[next[shard[i]]++] = i;
+  }
+}
+
+// Capacity
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::empty() const {
+  return size() == 0;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size_type
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size() const {
+  size_type total = 0;
+  for (size_type i = 0; i < Shards; ++i) {
+    std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+    total += shards_[i].map.size();
+  }
+  return total;
+}
+
+// Modifiers
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+void sharded_map<Key, T, Shards, Compare, Hash, Allocator>::clear() {
+  for (size_type i = 0; i < Shards; ++i) {
+    std::unique_lock<std::shared_mutex> lock(shards_[i].mutex);
+    shards_[i].map.clear();
+  }
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::insert(
+    const value_type& value) {
+  return try_emplace(value.first, value.second);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::insert(
+    const Key& key, const T& obj) {
+  return try_emplace(key, obj);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+template <typename... Args>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::try_emplace(
+    const Key& key, Args&&... args) {
+  Shard& shard = shards_[shard_of(key)];
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+template <typename M>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::insert_or_assign(
+    const Key& key, M&& obj) {
+  Shard& shard = shards_[shard_of(key)];
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.map.insert_or_assign(key, std::forward<M>(obj)).second;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size_type
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::erase(const Key& key) {
+  Shard& shard = shards_[shard_of(key)];
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.map.erase(key);
+}
+
+// Batches
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+template <typename ForwardIt>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size_type
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::multi_insert(
+    ForwardIt first, ForwardIt last) {
+  std::vector<ForwardIt> items;
+  for (; first != last; ++first) {
+    items.push_back(first);
+  }
+  std::vector<size_type> order;
+  std::array<size_type, Shards + 1> starts;
+  group_by_shard(
+      items, [](const auto& item) -> const Key& { return item.first; }, order,
+      starts);
+  size_type inserted = 0;
+  for (size_type s = 0; s < Shards; ++s) {
+    if (starts[s] == starts[s + 1]) {
+      continue;
+    }
+    std::unique_lock<std::shared_mutex> lock(shards_[s].mutex);
+    for (size_type i = starts[s]; i < starts[s + 1]; ++i) {
+      const auto& item = *items[order[i]];
+      inserted += shards_[s].map.try_emplace(item.first, item.second).second;
+    }
+  }
+  return inserted;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size_type
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::multi_insert(
+    std::initializer_list<value_type> const& items) {
+  return multi_insert(items.begin(), items.end());
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+template <typename ForwardIt>
+std::vector<std::optional<T>>
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::multi_find(
+    ForwardIt first, ForwardIt last) const {
+  std::vector<ForwardIt> keys;
+  for (; first != last; ++first) {
+    keys.push_back(first);
+  }
+  std::vector<size_type> order;
+  std::array<size_type, Shards + 1> starts;
+  group_by_shard(
+      keys, [](const Key& key) -> const Key& { return key; }, order, starts);
+  std::vector<std::optional<T>> found(keys.size());
+  for (size_type s = 0; s < Shards; ++s) {
+    if (starts[s] == starts[s + 1]) {
+      continue;
+    }
+    std::shared_lock<std::shared_mutex> lock(shards_[s].mutex);
+    map_type& shard = shards_[s].map;
+    for (size_type i = starts[s]; i < starts[s + 1]; ++i) {
+      auto it = shard.find(*keys[order[i]]);
+      if (it != shard.end()) {
+        found[order[i]] = it->second;
+      }
+    }
+  }
+  return found;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+std::vector<std::optional<T>>
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::multi_find(
+    std::initializer_list<Key> const& keys) const {
+  return multi_find(keys.begin(), keys.end());
+}
+
+// Lookup
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+std::optional<T> sharded_map<Key, T, Shards, Compare, Hash, Allocator>::find(
+    const Key& key) const {
+  const Shard& shard = shards_[shard_of(key)];
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+T sharded_map<Key, T, Shards, Compare, Hash, Allocator>::at(
+    const Key& key) const {
+  const Shard& shard = shards_[shard_of(key)];
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.map.at(key);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::contains(
+    const Key& key) const {
+  const Shard& shard = shards_[shard_of(key)];
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.map.contains(key);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size_type
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::count(
+    const Key& key) const {
+  return contains(key) ? 1 : 0;
+}
+
+// Observers
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::key_compare
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::key_comp() const {
+  return comp_;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::hasher
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::hash_function() const {
+  return hash_;
+}
+
+// ReadView
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::ReadView(
+    const sharded_map& m)
+    : map_(&m) {
+  for (size_type i = 0; i < Shards; ++i) {
+    locks_[i] = std::shared_lock<std::shared_mutex>(m.shards_[i].mutex);
+  }
+}
+
+// bound(shard map) gives where the merge starts in that shard
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+template <typename Bound>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::merge(
+    Bound bound) const {
+  MergeIterator it;
+  it.comp_ = map_->comp_;
+  for (size_type i = 0; i < Shards; ++i) {
+    map_type& shard = map_->shards_[i].map;
+    it.current_[i] = bound(shard);
+    it.end_[i] = shard.cend();
+    if (it.current_[i] != it.end_[i]) {
+      it.heap_[it.heap_size_++] = i;
+    }
+  }
+  auto greater = [&it](size_type a, size_type b) {
+    return it.heap_less(b, a);
+  };
+  std::make_heap(it.heap_.begin(), it.heap_.begin() + it.heap_size_,
+                 greater);
+  return it;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::begin()
+    const {
+  return merge([](map_type& shard) { return shard.cbegin(); });
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::end() const {
+  return MergeIterator();
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::lower_bound(
+    const Key& key) const {
+  return merge([&key](map_type& shard) { return shard.lower_bound(key); });
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::upper_bound(
+    const Key& key) const {
+  return merge([&key](map_type& shard) { return shard.upper_bound(key); });
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::empty()
+    const {
+  return size() == 0;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::size_type
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::ReadView::size() const {
+  size_type total = 0;
+  for (size_type i = 0; i < Shards; ++i) {
+    total += map_->shards_[i].map.size();
+  }
+  return total;
+}
+
+// MergeIterator
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator::
+    heap_less(size_type a, size_type b) const {
+  return comp_(current_[a]->first, current_[b]->first);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator::
+operator==(const MergeIterator& other) const {
+  if (heap_size_ == 0 || other.heap_size_ == 0) {
+    return heap_size_ == other.heap_size_;
+  }
+  return current_[heap_[0]] == other.current_[other.heap_[0]];
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+bool sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator::
+operator!=(const MergeIterator& other) const {
+  return !(*this == other);
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::const_reference
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator::
+operator*() const {
+  if (heap_size_ == 0) {
+    throw std::out_of_range("Iterator is out of range");
+  }
+  return *current_[heap_[0]];
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+const typename sharded_map<Key, T, Shards, Compare, Hash,
+                           Allocator>::value_type*
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator::
+operator->() const {
+  return &**this;
+}
+
+// The top shard leaves the heap, advances and goes back in unless it is
+// exhausted
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator&
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator::
+operator++() {
+  if (heap_size_ == 0) {
+    return *this;
+  }
+  auto greater = [this](size_type a, size_type b) { return heap_less(b, a); };
+  std::pop_heap(heap_.begin(), heap_.begin() + heap_size_, greater);
+  size_type shard = heap_[heap_size_ - 1];
+  if (++current_[shard] == end_[shard]) {
+    --heap_size_;
+  } else {
+    std::push_heap(heap_.begin(), heap_.begin() + heap_size_, greater);
+  }
+  return *this;
+}
+
+template <typename Key, typename T, std::size_t Shards, typename Compare,
+          typename Hash, typename Allocator>
+typename sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator
+sharded_map<Key, T, Shards, Compare, Hash, Allocator>::MergeIterator::
+operator++(int) {
+  MergeIterator copy = *this;
+  ++*this;
+  return copy;
+}
+
+S21_STATS_NAMESPACE_END
+}  // namespace s21
+
+#endif
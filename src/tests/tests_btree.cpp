@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+// Large enough that a node holds only 3 values, which makes deep trees out
+// of a few hundred elements
+struct Wide {
+  int key;
+  char payload[100];
+
+  Wide(int k = 0) : key(k), payload() {}
+  bool operator<(const Wide& other) const { return key < other.key; }
+};
+
+// Exposes the nodes of a btree_set to check the B-tree invariants
+template <typename Key>
+class CheckedBTreeSet : public s21::btree_set<Key> {
+  using Base = s21::btree_set<Key>;
+  using Node = typename Base::Node;
+
+ public:
+  using Base::Base;
+
+  bool is_valid() {
+    if (this->root_ == nullptr) {
+      return this->size() == 0;
+    }
+    size_t count = 0;
+    int leaf_depth = -1;
+    return this->root_->parent == nullptr &&
+           check(this->root_, nullptr, nullptr, 0, leaf_depth, count) &&
+           count == this->size();
+  }
+
+  static constexpr size_t slots() { return Base::kSlots; }
+
+ private:
+  bool check(Node* node, const Key* lo, const Key* hi, int depth,
+             int& leaf_depth, size_t& count) {
+    if (node->count > Base::kSlots ||
+        (node != this->root_ && node->count < Base::kMinSlots) ||
+        node->count == 0) {
+      return false;
+    }
+    for (size_t i = 0; i < node->count; ++i) {
+      const Key& key = node->key(i);
+      if ((i > 0 && !(node->key(i - 1) < key)) || (lo && !(*lo < key)) ||
+          (hi && !(key < *hi))) {
+        return false;
+      }
+    }
+    count += node->count;
+    if (node->leaf) {
+      if (leaf_depth == -1) {
+        leaf_depth = depth;
+      }
+      return leaf_depth == depth;
+    }
+    for (size_t i = 0; i <= node->count; ++i) {
+      Node* child = Base::child(node, i);
+      if (child->parent != node || child->position != i ||
+          !check(child, i > 0 ? &node->key(i - 1) : lo,
+                 i < node->count ? &node->key(i) : hi, depth + 1, leaf_depth,
+                 count)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+TEST(TestsBTree, MapBasics) {
+  s21::btree_map<int, std::string> m = {{3, "three"}, {1, "one"}};
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_TRUE(m.insert(2, "two").second);
+  EXPECT_FALSE(m.insert({2, "deux"}).second);
+  EXPECT_EQ(m.at(2), "two");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+
+  m[4] = "four";
+  m[4] += "!";
+  EXPECT_EQ(m.at(4), "four!");
+  EXPECT_FALSE(m.insert_or_assign(1, "uno").second);
+  EXPECT_EQ(m.at(1), "uno");
+  EXPECT_TRUE(m.try_emplace(5, 3, 'x').second);
+  EXPECT_EQ(m.at(5), "xxx");
+  EXPECT_EQ(m.emplace_hint(m.end(), 6, "six")->second, "six");
+
+  std::vector<int> keys;
+  for (const auto& item : m) {
+    keys.push_back(item.first);
+  }
+  EXPECT_EQ(keys, std::vector<int>({1, 2, 3, 4, 5, 6}));
+
+  EXPECT_EQ(m.find(7), m.end());
+  EXPECT_EQ(m.find(3)->second, "three");
+  EXPECT_EQ(m.lower_bound(0)->first, 1);
+  EXPECT_EQ(m.upper_bound(6), m.end());
+  EXPECT_EQ(m.equal_range(4).first->first, 4);
+  EXPECT_EQ(m.count(3), 1);
+  EXPECT_EQ(m.erase(3), 1);
+  EXPECT_EQ(m.erase(3), 0);
+  EXPECT_FALSE(m.contains(3));
+  EXPECT_EQ((--m.end())->first, 6);
+}
+
+TEST(TestsBTree, SetBasics) {
+  s21::btree_set<std::string> s = {"pear", "apple", "fig", "apple"};
+  EXPECT_EQ(s.size(), 3);
+  EXPECT_EQ(*s.begin(), "apple");
+  EXPECT_TRUE(s.emplace(4, 'z').second);
+  EXPECT_EQ(s.count("zzzz"), 1);
+  auto results = s.insert_many("fig", "kiwi");
+  EXPECT_FALSE(results[0].second);
+  EXPECT_TRUE(results[1].second);
+
+  EXPECT_EQ(*s.erase(s.find("apple")), "fig");
+  std::vector<std::string> items;
+  for (const std::string& item : s) {
+    items.push_back(item);
+  }
+  EXPECT_EQ(items, std::vector<std::string>({"fig", "kiwi", "pear", "zzzz"}));
+}
+
+TEST(TestsBTree, MatchesStdSet) {
+  CheckedBTreeSet<Wide> narrow;
+  CheckedBTreeSet<int> wide;
+  std::set<int> expected;
+  EXPECT_EQ(narrow.slots(), 3);
+
+  unsigned state = 99;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int key = static_cast<int>((state >> 8) % 3000);
+    if ((state >> 4) % 5 < 2) {
+      size_t erased = expected.erase(key);
+      ASSERT_EQ(narrow.erase(key), erased);
+      ASSERT_EQ(wide.erase(key), erased);
+    } else {
+      bool inserted = expected.insert(key).second;
+      ASSERT_EQ(narrow.insert(key).second, inserted);
+      ASSERT_EQ(wide.insert(key).second, inserted);
+    }
+    if (i % 250 == 0) {
+      ASSERT_TRUE(narrow.is_valid());
+      ASSERT_TRUE(wide.is_valid());
+    }
+  }
+
+  ASSERT_TRUE(narrow.is_valid());
+  ASSERT_TRUE(wide.is_valid());
+  ASSERT_EQ(narrow.size(), expected.size());
+  ASSERT_EQ(wide.size(), expected.size());
+  auto n = narrow.begin();
+  auto w = wide.begin();
+  for (int key : expected) {
+    ASSERT_EQ(n->key, key);
+    ASSERT_EQ(*w, key);
+    ++n;
+    ++w;
+  }
+  EXPECT_EQ(n, narrow.end());
+  EXPECT_EQ(w, wide.end());
+
+  // And back from end()
+  auto r = expected.rbegin();
+  for (auto it = narrow.end(); it != narrow.begin();) {
+    --it;
+    ASSERT_EQ(it->key, *r++);
+  }
+}
+
+TEST(TestsBTree, EraseReturnsNext) {
+  std::vector<int> values(3000);
+  for (int i = 0; i < 3000; ++i) {
+    values[i] = i;
+  }
+  CheckedBTreeSet<Wide> s(values.begin(), values.end());
+  std::set<int> expected(values.begin(), values.end());
+  ASSERT_TRUE(s.is_valid());
+
+  unsigned state = 4242;
+  while (!expected.empty()) {
+    state = state * 1103515245u + 12345u;
+    int lo = static_cast<int>((state >> 8) % 3000);
+    int hi = lo + static_cast<int>((state >> 4) % 100);
+    auto last = s.erase(s.lower_bound(lo), s.lower_bound(hi));
+    expected.erase(expected.lower_bound(lo), expected.lower_bound(hi));
+
+    ASSERT_TRUE(s.is_valid());
+    ASSERT_EQ(s.size(), expected.size());
+    auto expected_last = expected.lower_bound(hi);
+    if (expected_last == expected.end()) {
+      ASSERT_EQ(last, s.end());
+    } else {
+      ASSERT_EQ(last->key, *expected_last);
+    }
+
+    // Single erasures walking forward, every other element
+    auto it = s.lower_bound(hi);
+    for (int i = 0; i < 20 && it != s.end(); ++i) {
+      int key = it->key;
+      expected.erase(key);
+      it = s.erase(it);
+      if (it != s.end()) {
+        ASSERT_EQ(it->key, *expected.upper_bound(key));
+        ++it;
+      }
+    }
+    ASSERT_TRUE(s.is_valid());
+  }
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.begin(), s.end());
+}
+
+TEST(TestsBTree, HintedInsert) {
+  CheckedBTreeSet<int> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(s.end(), 2 * i);
+  }
+  ASSERT_TRUE(s.is_valid());
+
+  // Right hints, wrong hints and duplicates
+  EXPECT_EQ(*s.insert(s.find(10), 9), 9);
+  EXPECT_EQ(*s.insert(s.begin(), 501), 501);
+  EXPECT_EQ(*s.insert(s.end(), -1), -1);
+  EXPECT_EQ(*s.insert(s.find(100), 100), 100);
+  EXPECT_EQ(s.size(), 1003);
+  EXPECT_TRUE(s.is_valid());
+  EXPECT_EQ(*s.begin(), -1);
+}
+
+TEST(TestsBTree, Merge) {
+  s21::btree_map<int, std::string> a = {{1, "a1"}, {3, "a3"}};
+  s21::btree_map<int, std::string> b = {{2, "b2"}, {3, "b3"}, {4, "b4"}};
+  a.merge(b);
+  EXPECT_EQ(a.size(), 4);
+  EXPECT_EQ(a.at(3), "a3");
+  EXPECT_EQ(a.at(4), "b4");
+  ASSERT_EQ(b.size(), 1);
+  EXPECT_EQ(b.begin()->second, "b3");
+
+  CheckedBTreeSet<Wide> x;
+  CheckedBTreeSet<Wide> y;
+  for (int i = 0; i < 500; ++i) {
+    x.insert(3 * i);
+    y.insert(2 * i);
+  }
+  x.merge(y);
+  EXPECT_TRUE(x.is_valid());
+  EXPECT_TRUE(y.is_valid());
+  EXPECT_EQ(x.size() + y.size(), 1000);
+  EXPECT_EQ(y.size(), 167);
+}
+
+TEST(TestsBTree, InsertFromOwnElement) {
+  s21::btree_map<int, std::string> m;
+  for (int i = 0; i < 1000; ++i) {
+    m[i] = std::string(40, static_cast<char>('a' + i % 26));
+  }
+  // Every node on the way is split or shifted before the copy is stored
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_TRUE(m.try_emplace(-i - 1, m.at(i)).second);
+    ASSERT_EQ(m.at(-i - 1), m.at(i));
+  }
+}
+
+// Slots are moved by reconstructing them, which copies the const key and
+// moves the mapped value
+TEST(TestsBTree, MapMovesSlotsWithConstKeys) {
+  s21::btree_map<std::string, std::unique_ptr<int>> m;
+  for (int i = 0; i < 500; ++i) {
+    m.try_emplace(std::to_string(i), std::make_unique<int>(i));
+  }
+  for (int i = 0; i < 500; i += 3) {
+    EXPECT_EQ(m.erase(std::to_string(i)), 1);
+  }
+
+  std::map<std::string, int> expected;
+  for (int i = 0; i < 500; ++i) {
+    if (i % 3 != 0) {
+      expected[std::to_string(i)] = i;
+    }
+  }
+  ASSERT_EQ(m.size(), expected.size());
+  auto it = expected.begin();
+  for (const auto& item : m) {
+    EXPECT_EQ(item.first, it->first);
+    EXPECT_EQ(*item.second, it->second);
+    ++it;
+  }
+}
+
+TEST(TestsBTree, CopyAndMove) {
+  CheckedBTreeSet<Wide> s;
+  for (int i = 0; i < 300; ++i) {
+    s.insert(i);
+  }
+
+  CheckedBTreeSet<Wide> copy(s);
+  EXPECT_TRUE(copy.is_valid());
+  copy.erase(5);
+  EXPECT_TRUE(s.contains(5));
+  EXPECT_EQ(copy.size(), 299);
+
+  CheckedBTreeSet<Wide> moved(std::move(copy));
+  EXPECT_TRUE(moved.is_valid());
+  EXPECT_EQ(moved.size(), 299);
+  EXPECT_TRUE(copy.empty());
+
+  s = std::move(moved);
+  EXPECT_EQ(s.size(), 299);
+  EXPECT_FALSE(s.contains(5));
+  EXPECT_TRUE(s.is_valid());
+
+  s21::btree_map<int, int> a = {{1, 1}, {2, 2}};
+  s21::btree_map<int, int> b = {{3, 3}};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_EQ(b.begin()->second, 1);
+  a.clear();
+  EXPECT_EQ(a.begin(), a.end());
+}
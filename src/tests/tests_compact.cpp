@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+// Exposes the index arrays of a compact_map to check the AVL invariants
+class CheckedCompactMap : public s21::compact_map<int, std::string> {
+ public:
+  using s21::compact_map<int, std::string>::compact_map;
+
+  bool is_valid() const {
+    if (root_ == kNull) {
+      return size() == 0;
+    }
+    int height = 0;
+    size_t count = 0;
+    return links_[root_].parent == kNull && check(root_, height, count) &&
+           count == size() && free_slots() + size() == links_.size();
+  }
+
+  size_t slots() const { return links_.size(); }
+
+ private:
+  size_t free_slots() const {
+    size_t count = 0;
+    for (index_type slot = free_; slot != kNull; slot = links_[slot].left) {
+      if (links_[slot].height != 0) {
+        return links_.size();
+      }
+      count++;
+    }
+    return count;
+  }
+
+  bool check(index_type node, int& height, size_t& count) const {
+    if (node == kNull) {
+      height = 0;
+      count = 0;
+      return true;
+    }
+    const Links& links = links_[node];
+    int left_height, right_height;
+    size_t left_count, right_count;
+    if (!check(links.left, left_height, left_count) ||
+        !check(links.right, right_height, right_count)) {
+      return false;
+    }
+    int key = values_[node].first;
+    if ((links.left != kNull && (links_[links.left].parent != node ||
+                                 values_[links.left].first >= key)) ||
+        (links.right != kNull && (links_[links.right].parent != node ||
+                                  values_[links.right].first <= key))) {
+      return false;
+    }
+    height = std::max(left_height, right_height) + 1;
+    count = left_count + right_count + 1;
+    return links.height == height && std::abs(left_height - right_height) <= 1;
+  }
+};
+
+TEST(TestsCompact, MapBasics) {
+  s21::compact_map<int, std::string> m = {{3, "three"}, {1, "one"}};
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_TRUE(m.insert(2, "two").second);
+  EXPECT_FALSE(m.insert({2, "deux"}).second);
+  EXPECT_EQ(m.at(2), "two");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+
+  m[4] = "four";
+  m[4] += "!";
+  EXPECT_EQ(m.at(4), "four!");
+  EXPECT_FALSE(m.insert_or_assign(1, "uno").second);
+  EXPECT_EQ(m.at(1), "uno");
+  EXPECT_TRUE(m.try_emplace(5, 3, 'x').second);
+  EXPECT_EQ(m.at(5), "xxx");
+
+  std::vector<int> keys;
+  for (const auto& item : m) {
+    keys.push_back(item.first);
+  }
+  EXPECT_EQ(keys, std::vector<int>({1, 2, 3, 4, 5}));
+
+  EXPECT_EQ(m.find(6), m.end());
+  EXPECT_EQ(m.find(3)->second, "three");
+  EXPECT_EQ(m.lower_bound(0)->first, 1);
+  EXPECT_EQ(m.upper_bound(5), m.end());
+  EXPECT_EQ(m.count(3), 1);
+  EXPECT_EQ(m.erase(3), 1);
+  EXPECT_EQ(m.erase(3), 0);
+  EXPECT_FALSE(m.contains(3));
+  EXPECT_EQ((--m.end())->first, 5);
+}
+
+TEST(TestsCompact, SetBasics) {
+  s21::compact_set<std::string> s = {"pear", "apple", "fig", "apple"};
+  EXPECT_EQ(s.size(), 3);
+  EXPECT_EQ(*s.begin(), "apple");
+  EXPECT_TRUE(s.emplace(4, 'z').second);
+  EXPECT_EQ(s.count("zzzz"), 1);
+  auto results = s.insert_many("fig", "kiwi");
+  EXPECT_FALSE(results[0].second);
+  EXPECT_TRUE(results[1].second);
+
+  s.erase(s.find("apple"));
+  std::vector<std::string> items;
+  for (const std::string& item : s) {
+    items.push_back(item);
+  }
+  EXPECT_EQ(items, std::vector<std::string>({"fig", "kiwi", "pear", "zzzz"}));
+}
+
+TEST(TestsCompact, MatchesStdMap) {
+  CheckedCompactMap m;
+  std::map<int, std::string> expected;
+
+  unsigned state = 2024;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int key = static_cast<int>((state >> 8) % 2000);
+    if ((state >> 4) % 3 == 0) {
+      EXPECT_EQ(m.erase(key), expected.erase(key));
+    } else {
+      m[key] = std::to_string(i);
+      expected[key] = std::to_string(i);
+    }
+    if (i % 500 == 0) {
+      ASSERT_TRUE(m.is_valid());
+    }
+  }
+
+  ASSERT_TRUE(m.is_valid());
+  ASSERT_EQ(m.size(), expected.size());
+  auto it = m.begin();
+  for (const auto& item : expected) {
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+  EXPECT_EQ(it, m.end());
+}
+
+TEST(TestsCompact, ErasedSlotsAreReused) {
+  CheckedCompactMap m;
+  for (int i = 0; i < 100; ++i) {
+    m[i] = "value";
+  }
+  size_t slots = m.slots();
+  for (int i = 0; i < 100; i += 2) {
+    m.erase(i);
+  }
+  ASSERT_TRUE(m.is_valid());
+  for (int i = 100; i < 150; ++i) {
+    m[i] = "again";
+  }
+  EXPECT_EQ(m.slots(), slots);
+  EXPECT_EQ(m.size(), 100);
+  EXPECT_TRUE(m.is_valid());
+
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_EQ(m.begin(), m.end());
+  EXPECT_TRUE(m.is_valid());
+}
+
+TEST(TestsCompact, IteratorsSurviveGrowth) {
+  s21::compact_map<int, std::string> m;
+  auto first = m.insert(500, "middle").first;
+  for (int i = 0; i < 1000; ++i) {
+    m[i] = std::to_string(i);
+  }
+  EXPECT_GE(m.capacity(), 1000);
+  EXPECT_EQ(first->first, 500);
+  EXPECT_EQ(first->second, "500");
+  EXPECT_EQ((++first)->first, 501);
+}
+
+TEST(TestsCompact, InsertFromOwnElementWhileGrowing) {
+  s21::compact_map<int, std::string> m;
+  m[0] = std::string(64, 'a');
+  while (m.size() < m.capacity()) {
+    m[static_cast<int>(m.size())] = "filler";
+  }
+
+  // The argument lives in the array that this insertion reallocates
+  size_t capacity = m.capacity();
+  EXPECT_TRUE(m.try_emplace(-1, m.at(0)).second);
+  EXPECT_GT(m.capacity(), capacity);
+  EXPECT_EQ(m.at(-1), std::string(64, 'a'));
+}
+
+TEST(TestsCompact, ReserveAvoidsRegrowth) {
+  s21::compact_set<int> s;
+  s.reserve(1000);
+  EXPECT_EQ(s.capacity(), 1000);
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i);
+  }
+  EXPECT_EQ(s.capacity(), 1000);
+  EXPECT_THROW(s.reserve(s.max_size() + 1), std::length_error);
+}
+
+TEST(TestsCompact, CopyAndMove) {
+  CheckedCompactMap m;
+  for (int i = 0; i < 50; ++i) {
+    m[i] = std::to_string(i);
+  }
+  m.erase(10);
+  m.erase(20);
+
+  CheckedCompactMap copy(m);
+  EXPECT_TRUE(copy.is_valid());
+  EXPECT_EQ(copy.size(), 48);
+  copy[10] = "ten";
+  EXPECT_FALSE(m.contains(10));
+  EXPECT_EQ(copy.at(49), "49");
+
+  CheckedCompactMap moved(std::move(copy));
+  EXPECT_TRUE(moved.is_valid());
+  EXPECT_EQ(moved.size(), 49);
+  EXPECT_TRUE(copy.empty());
+
+  m = std::move(moved);
+  EXPECT_EQ(m.size(), 49);
+  EXPECT_EQ(m.at(10), "ten");
+
+  s21::compact_set<int> a = {1, 2};
+  s21::compact_set<int> b = {3};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_EQ(*b.begin(), 1);
+}
@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+// Checks the tree of a concurrent_map once no thread is using it
+class CheckedConcurrentMap : public s21::concurrent_map<int, int> {
+ public:
+  // Search order, parent links, heights and balance, no routing node left
+  // with fewer than two children, and size()
+  bool is_valid() const {
+    size_t count = 0;
+    Node* root = holder_.right.load();
+    return (root == nullptr || root->parent.load() == &holder_) &&
+           check(root, nullptr, nullptr, count) >= 0 && count == size();
+  }
+
+ private:
+  static int check(Node* node, const int* lo, const int* hi, size_t& count) {
+    if (node == nullptr) {
+      return 0;
+    }
+    Node* left = node->left.load();
+    Node* right = node->right.load();
+    if ((lo && !(*lo < node->key)) || (hi && !(node->key < *hi)) ||
+        (left && left->parent.load() != node) ||
+        (right && right->parent.load() != node) ||
+        is_unlinked(node->version.load())) {
+      return -1;
+    }
+    if (node->value.load()) {
+      ++count;
+    } else if (!left || !right) {
+      return -1;
+    }
+    int left_height = check(left, lo, &node->key, count);
+    int right_height = check(right, &node->key, hi, count);
+    if (left_height < 0 || right_height < 0 ||
+        left_height - right_height > 1 || right_height - left_height > 1 ||
+        node->height.load() != std::max(left_height, right_height) + 1) {
+      return -1;
+    }
+    return node->height.load();
+  }
+};
+
+TEST(TestsConcurrent, MapBasics) {
+  s21::concurrent_map<int, std::string> m = {{3, "three"}, {1, "one"}};
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_TRUE(m.insert(2, "two"));
+  EXPECT_FALSE(m.insert({2, "deux"}));
+  EXPECT_EQ(m.find(2), "two");
+  EXPECT_FALSE(m.find(4).has_value());
+  EXPECT_TRUE(m.try_emplace(4, 3, 'x'));
+  EXPECT_EQ(m.find(4), "xxx");
+  EXPECT_FALSE(m.insert_or_assign(1, "uno"));
+  EXPECT_TRUE(m.insert_or_assign(5, "five"));
+  EXPECT_EQ(m.find(1), "uno");
+  EXPECT_EQ(m.size(), 5);
+  EXPECT_EQ(m.count(3), 1);
+  EXPECT_EQ(m.erase(3), 1);
+  EXPECT_EQ(m.erase(3), 0);
+  EXPECT_FALSE(m.contains(3));
+  EXPECT_EQ(m.size(), 4);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  EXPECT_TRUE(m.insert(3, "trois"));
+  EXPECT_EQ(m.find(3), "trois");
+}
+
+namespace {
+
+// Fails once allocations_left runs out, live counts what is not freed yet
+struct AllocationBudget {
+  int allocations_left = 1 << 30;
+  int live = 0;
+};
+
+template <typename T>
+struct FailingAllocator {
+  using value_type = T;
+
+  AllocationBudget* budget;
+
+  explicit FailingAllocator(AllocationBudget* b) : budget(b) {}
+  template <typename U>
+  FailingAllocator(const FailingAllocator<U>& other) : budget(other.budget) {}
+
+  T* allocate(size_t n) {
+    if (budget->allocations_left-- <= 0) {
+      throw std::bad_alloc();
+    }
+    ++budget->live;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, size_t n) {
+    --budget->live;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const FailingAllocator<U>& other) const {
+    return budget == other.budget;
+  }
+  template <typename U>
+  bool operator!=(const FailingAllocator<U>& other) const {
+    return budget != other.budget;
+  }
+};
+
+}  // namespace
+
+TEST(TestsConcurrent, FailedNodeAllocationFreesValue) {
+  using Allocator = FailingAllocator<std::pair<const int, std::string>>;
+  AllocationBudget budget;
+  {
+    s21::concurrent_map<int, std::string, std::less<int>, Allocator> m{
+        std::less<int>(), Allocator(&budget)};
+    EXPECT_TRUE(m.insert(1, "one"));
+    int live = budget.live;
+
+    // The value box is allocated, the node for it is not
+    budget.allocations_left = 1;
+    EXPECT_THROW(m.try_emplace(2, "two"), std::bad_alloc);
+    EXPECT_EQ(budget.live, live);
+    budget.allocations_left = 1;
+    EXPECT_THROW(m.insert_or_assign(3, "three"), std::bad_alloc);
+    EXPECT_EQ(budget.live, live);
+
+    budget.allocations_left = 1 << 30;
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_TRUE(m.insert_or_assign(3, "three"));
+    EXPECT_EQ(m.find(3), "three");
+  }
+  EXPECT_EQ(budget.live, 0);
+}
+
+TEST(TestsConcurrent, MatchesStdMap) {
+  CheckedConcurrentMap m;
+  std::map<int, int> expected;
+  unsigned state = 77;
+  for (int i = 0; i < 30000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int key = static_cast<int>((state >> 8) % 2000);
+    unsigned op = (state >> 4) % 5;
+    if (op < 2) {
+      ASSERT_EQ(m.erase(key), expected.erase(key));
+    } else if (op < 4) {
+      ASSERT_EQ(m.insert(key, i), expected.insert({key, i}).second);
+    } else {
+      ASSERT_EQ(m.insert_or_assign(key, i), expected.count(key) == 0);
+      expected[key] = i;
+    }
+    if (i % 5000 == 0) {
+      ASSERT_TRUE(m.is_valid());
+    }
+  }
+  ASSERT_TRUE(m.is_valid());
+  for (int key = 0; key < 2000; ++key) {
+    auto it = expected.find(key);
+    ASSERT_EQ(m.find(key), it == expected.end()
+                               ? std::optional<int>()
+                               : std::optional<int>(it->second));
+  }
+  for (int key = 0; key < 2000; ++key) {
+    m.erase(key);
+  }
+  EXPECT_TRUE(m.is_valid());
+  EXPECT_TRUE(m.empty());
+}
+
+// Writers on disjoint keys can each predict their own part of the map
+TEST(TestsConcurrent, DisjointWriters) {
+  constexpr int kThreads = 4;
+  CheckedConcurrentMap m;
+  std::vector<std::map<int, int>> expected(kThreads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&m, &expected, t] {
+      unsigned state = 1000 + t;
+      for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245u + 12345u;
+        int key = static_cast<int>((state >> 8) % 1000) * kThreads + t;
+        if ((state >> 4) % 3 == 0) {
+          m.erase(key);
+          expected[t].erase(key);
+        } else {
+          m.insert_or_assign(key, i);
+          expected[t][key] = i;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  ASSERT_TRUE(m.is_valid());
+  size_t total = 0;
+  for (int t = 0; t < kThreads; ++t) {
+    total += expected[t].size();
+    for (int key = t; key < 1000 * kThreads; key += kThreads) {
+      auto it = expected[t].find(key);
+      ASSERT_EQ(m.find(key), it == expected[t].end()
+                                 ? std::optional<int>()
+                                 : std::optional<int>(it->second));
+    }
+  }
+  EXPECT_EQ(m.size(), total);
+}
+
+// Writers fight over the same keys while readers look for keys that are
+// never erased and must see them through every rotation
+TEST(TestsConcurrent, OverlappingWritersAndReaders) {
+  constexpr int kWriters = 4;
+  constexpr int kReaders = 2;
+  CheckedConcurrentMap m;
+  for (int key = 0; key < 512; key += 8) {
+    m.insert(key, key * 16);
+  }
+  std::atomic<bool> done{false};
+  std::atomic<int> failures{0};
+  std::vector<std::thread> writers;
+  std::vector<std::thread> readers;
+  for (int t = 0; t < kReaders; ++t) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        for (int key = 0; key < 512; ++key) {
+          std::optional<int> value = m.find(key);
+          if ((key % 8 == 0 && !value) || (value && *value / 16 != key)) {
+            ++failures;
+          }
+        }
+      }
+    });
+  }
+  for (int t = 0; t < kWriters; ++t) {
+    writers.emplace_back([&m, t] {
+      unsigned state = 2000 + t;
+      for (int i = 0; i < 20000; ++i) {
+        state = state * 1103515245u + 12345u;
+        int key = static_cast<int>((state >> 8) % 512);
+        unsigned op = (state >> 4) % 3;
+        if (key % 8 == 0) {
+          m.insert_or_assign(key, key * 16 + t);
+        } else if (op == 0) {
+          m.erase(key);
+        } else if (op == 1) {
+          m.insert(key, key * 16 + t);
+        } else {
+          m.insert_or_assign(key, key * 16 + t);
+        }
+      }
+    });
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(failures.load(), 0);
+  ASSERT_TRUE(m.is_valid());
+  size_t count = 0;
+  for (int key = 0; key < 512; ++key) {
+    count += m.contains(key);
+  }
+  EXPECT_EQ(m.size(), count);
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+using SplitMap =
+    s21::flat_map<int, std::string, std::less<int>,
+                  s21::SplitLayout<int, std::string>>;
+
+TEST(TestsFlat, SetBulkConstruction) {
+  std::vector<int> values = {5, 3, 9, 3, 1, 5, 7, 1};
+  s21::flat_set<int> s(values.begin(), values.end());
+  EXPECT_EQ(s.size(), 5);
+  EXPECT_EQ(std::vector<int>(s.begin(), s.end()),
+            std::vector<int>({1, 3, 5, 7, 9}));
+
+  s.insert_range(values.begin(), values.end());
+  EXPECT_EQ(s.size(), 5);
+  std::vector<int> more = {10, 0, 4, 12, 4};
+  s.insert_range(more.begin(), more.end());
+  EXPECT_EQ(std::vector<int>(s.begin(), s.end()),
+            std::vector<int>({0, 1, 3, 4, 5, 7, 9, 10, 12}));
+}
+
+TEST(TestsFlat, SetBasics) {
+  s21::flat_set<std::string> s = {"pear", "apple", "fig"};
+  EXPECT_TRUE(s.insert("kiwi").second);
+  EXPECT_FALSE(s.insert("fig").second);
+  EXPECT_EQ(*s.emplace(3, 'z').first, "zzz");
+  EXPECT_EQ(*s.begin(), "apple");
+
+  EXPECT_EQ(s.find("plum"), s.end());
+  EXPECT_EQ(*s.lower_bound("b"), "fig");
+  EXPECT_EQ(*s.upper_bound("fig"), "kiwi");
+  EXPECT_EQ(s.count("pear"), 1);
+  EXPECT_EQ(*s.erase(s.find("fig")), "kiwi");
+  EXPECT_EQ(s.erase("fig"), 0);
+  EXPECT_EQ(s.erase(s.begin(), s.begin() + 2), s.begin());
+  EXPECT_EQ(std::vector<std::string>(s.begin(), s.end()),
+            std::vector<std::string>({"pear", "zzz"}));
+}
+
+TEST(TestsFlat, MapBasics) {
+  s21::flat_map<int, std::string> m = {{3, "three"}, {1, "one"}, {3, "x"}};
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_EQ(m.at(3), "three");
+  EXPECT_TRUE(m.insert(2, "two").second);
+  EXPECT_FALSE(m.insert({2, "deux"}).second);
+  EXPECT_THROW(m.at(4), std::out_of_range);
+
+  m[4] = "four";
+  m[4] += "!";
+  EXPECT_EQ(m.at(4), "four!");
+  EXPECT_FALSE(m.insert_or_assign(1, "uno").second);
+  EXPECT_EQ(m.at(1), "uno");
+  EXPECT_TRUE(m.try_emplace(5, 3, 'x').second);
+  EXPECT_EQ(m.at(5), "xxx");
+
+  // Iterators hand out references into the map
+  m.begin()->second = "first";
+  (*(m.begin() + 1)).second += "?";
+  EXPECT_EQ(m.at(1), "first");
+  EXPECT_EQ(m.at(2), "two?");
+  EXPECT_EQ(m.end() - m.begin(), 5);
+  EXPECT_EQ(m.begin()[4].first, 5);
+  EXPECT_EQ((--m.end())->first, 5);
+  s21::flat_map<int, std::string>::const_iterator c = m.begin();
+  EXPECT_EQ(c->second, "first");
+
+  EXPECT_EQ(m.find(7), m.end());
+  EXPECT_EQ(m.find(3)->second, "three");
+  EXPECT_EQ(m.lower_bound(0)->first, 1);
+  EXPECT_EQ(m.upper_bound(5), m.end());
+  EXPECT_EQ(m.equal_range(4).first->first, 4);
+  EXPECT_EQ(m.erase(3), 1);
+  EXPECT_EQ(m.erase(3), 0);
+  EXPECT_EQ(m.erase(m.find(4))->first, 5);
+  EXPECT_EQ(m.size(), 3);
+}
+
+TEST(TestsFlat, MapInsertRangeKeepsExisting) {
+  SplitMap m = {{2, "old2"}, {4, "old4"}, {6, "old6"}};
+  std::vector<std::pair<int, std::string>> batch = {
+      {5, "new5"}, {4, "new4"}, {1, "new1"}, {5, "dup5"}, {7, "new7"}};
+  m.insert_range(batch.begin(), batch.end());
+
+  std::vector<std::pair<int, std::string>> items;
+  for (const auto& item : m) {
+    items.emplace_back(item.first, item.second);
+  }
+  std::vector<std::pair<int, std::string>> expected = {
+      {1, "new1"}, {2, "old2"}, {4, "old4"}, {5, "new5"},
+      {6, "old6"}, {7, "new7"}};
+  EXPECT_EQ(items, expected);
+
+  // Appending past the last key
+  std::vector<std::pair<int, std::string>> tail = {{9, "a"}, {8, "b"}};
+  m.insert_range(tail.begin(), tail.end());
+  EXPECT_EQ(m.size(), 8);
+  EXPECT_EQ((m.end() - 1)->second, "a");
+}
+
+template <typename Map>
+void match_std_map() {
+  Map m;
+  std::map<int, int> expected;
+  unsigned state = 77;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int key = static_cast<int>((state >> 8) % 2000);
+    unsigned op = (state >> 4) % 8;
+    if (op < 3) {
+      ASSERT_EQ(m.erase(key), expected.erase(key));
+    } else if (op < 7) {
+      ASSERT_EQ(m.insert(key, i).second, expected.insert({key, i}).second);
+    } else {
+      std::vector<std::pair<int, int>> batch;
+      for (int j = 0; j < 20; ++j) {
+        batch.emplace_back((key + 7 * j) % 2000, j);
+      }
+      m.insert_range(batch.begin(), batch.end());
+      expected.insert(batch.begin(), batch.end());
+    }
+  }
+  ASSERT_EQ(m.size(), expected.size());
+  auto it = m.begin();
+  for (const auto& item : expected) {
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ(it->second, item.second);
+    ++it;
+  }
+}
+
+TEST(TestsFlat, MapMatchesStdMap) {
+  match_std_map<s21::flat_map<int, int>>();
+  match_std_map<s21::flat_map<int, int, std::less<int>,
+                              s21::SplitLayout<int, int>>>();
+}
+
+TEST(TestsFlat, InsertFromOwnElement) {
+  SplitMap m;
+  for (int i = 0; i < 100; ++i) {
+    m[i] = std::string(40, static_cast<char>('a' + i % 26));
+  }
+  m.shrink_to_fit();
+  // Each insertion may reallocate both arrays
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(m.try_emplace(-i - 1, m.at(i)).second);
+    ASSERT_EQ(m.at(-i - 1), m.at(i));
+  }
+}
+
+TEST(TestsFlat, CopyAndMove) {
+  s21::flat_map<int, int> a = {{1, 1}, {2, 2}};
+  s21::flat_map<int, int> copy(a);
+  copy[3] = 3;
+  EXPECT_EQ(a.size(), 2);
+
+  s21::flat_map<int, int> moved(std::move(copy));
+  EXPECT_EQ(moved.size(), 3);
+  a = std::move(moved);
+  EXPECT_EQ(a.at(3), 3);
+
+  s21::flat_map<int, int> b = {{5, 5}};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_EQ(b.begin()->second, 1);
+  a.clear();
+  EXPECT_EQ(a.begin(), a.end());
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+TEST(TestsFrozen, SetMatchesStdSet) {
+  unsigned state = 5;
+  // Every shape of the last level up to a few full trees
+  for (int n = 0; n < 70; ++n) {
+    s21::set<int> s;
+    std::set<int> expected;
+    for (int i = 0; i < n; ++i) {
+      state = state * 1103515245u + 12345u;
+      int key = static_cast<int>((state >> 8) % 200) * 2;
+      s.insert(key);
+      expected.insert(key);
+    }
+    s21::frozen_set<int> frozen = s.freeze();
+    ASSERT_EQ(frozen.size(), expected.size());
+
+    std::vector<int> forward(frozen.begin(), frozen.end());
+    ASSERT_EQ(forward, std::vector<int>(expected.begin(), expected.end()));
+    std::vector<int> backward;
+    for (auto it = frozen.end(); it != frozen.begin();) {
+      backward.push_back(*--it);
+    }
+    ASSERT_EQ(backward, std::vector<int>(expected.rbegin(), expected.rend()));
+
+    for (int key = -1; key <= 401; ++key) {
+      ASSERT_EQ(frozen.contains(key), expected.count(key) == 1);
+      auto lower = expected.lower_bound(key);
+      auto upper = expected.upper_bound(key);
+      auto frozen_lower = frozen.lower_bound(key);
+      auto frozen_upper = frozen.upper_bound(key);
+      ASSERT_EQ(frozen_lower == frozen.end(), lower == expected.end());
+      ASSERT_EQ(frozen_upper == frozen.end(), upper == expected.end());
+      if (lower != expected.end()) {
+        ASSERT_EQ(*frozen_lower, *lower);
+      }
+      if (upper != expected.end()) {
+        ASSERT_EQ(*frozen_upper, *upper);
+      }
+    }
+  }
+}
+
+TEST(TestsFrozen, MapLookups) {
+  s21::map<std::string, int> m = {{"one", 1}, {"two", 2}, {"three", 3}};
+  s21::frozen_map<std::string, int> frozen = m.freeze();
+  m.clear();
+
+  EXPECT_EQ(frozen.size(), 3);
+  EXPECT_EQ(frozen.at("two"), 2);
+  EXPECT_THROW(frozen.at("four"), std::out_of_range);
+  EXPECT_EQ(frozen.find("three")->second, 3);
+  EXPECT_EQ(frozen.find("zero"), frozen.end());
+  EXPECT_EQ(frozen.count("one"), 1);
+  EXPECT_EQ(frozen.begin()->first, "one");
+  EXPECT_EQ(frozen.lower_bound("p")->first, "three");
+  EXPECT_EQ(frozen.equal_range("two").second, frozen.end());
+  EXPECT_THROW(*frozen.end(), std::out_of_range);
+
+  s21::frozen_map<std::string, int> empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(empty.begin(), empty.end());
+  EXPECT_FALSE(empty.contains("one"));
+}
+
+TEST(TestsFrozen, TransparentAndWide) {
+  s21::map<std::string, int, std::less<>> m;
+  for (int i = 0; i < 300; ++i) {
+    m[std::to_string(i)] = i;
+  }
+  auto frozen = m.freeze();
+  EXPECT_EQ(frozen.at(std::string("42")), 42);
+  EXPECT_TRUE(frozen.contains("299"));
+  EXPECT_FALSE(frozen.contains("300"));
+
+  // Values wider than a cache line are prefetched one by one
+  struct Wide {
+    char payload[100];
+  };
+  s21::map<int, Wide> wide;
+  for (int i = 0; i < 100; ++i) {
+    wide[i].payload[0] = static_cast<char>(i);
+  }
+  auto frozen_wide = wide.freeze();
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_EQ(frozen_wide.at(i).payload[0], static_cast<char>(i));
+  }
+}
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <map>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "../s21_containers.h"
 
@@ -414,4 +420,310 @@ TEST(TestsMap, InsertManyTest) {
     EXPECT_EQ(pair.second, expected[idx].second);
     idx++;
   }
-}
\ No newline at end of file
+}
+TEST(TestsMap, MoveAssignmentReplacesContents) {
+  s21::map<int, std::string> m1 = {{1, "one"}, {2, "two"}};
+  s21::map<int, std::string> m2 = {{3, "three"}, {4, "four"}, {5, "five"}};
+
+  m1 = std::move(m2);
+
+  EXPECT_EQ(m1.size(), 3);
+  EXPECT_FALSE(m1.contains(1));
+  EXPECT_EQ(m1.at(4), "four");
+  EXPECT_TRUE(m2.empty());
+
+  m2.insert({6, "six"});
+  EXPECT_EQ(m2.size(), 1);
+  EXPECT_EQ(m2.at(6), "six");
+}
+
+TEST(TestsMap, OrderStatistics) {
+  s21::map<int, std::string> m = {{5, "five"}, {1, "one"}, {3, "three"}};
+
+  auto it = m.select(1);
+  EXPECT_EQ(it->first, 3);
+  EXPECT_EQ(it->second, "three");
+  EXPECT_EQ(m.select(3), m.end());
+
+  EXPECT_EQ(m.rank(4), 2);
+  EXPECT_EQ(m.count_range(1, 5), 2);
+}
+
+TEST(TestsMap, AssignSorted) {
+  std::vector<std::pair<const int, std::string>> items = {
+      {1, "one"}, {2, "two"}, {2, "dup"}, {3, "three"}};
+  s21::map<int, std::string> m(items.begin(), items.end());
+
+  EXPECT_EQ(m.size(), 3);
+  EXPECT_EQ(m.at(2), "two");
+
+  m.assign_sorted(items.begin() + 2, items.end());
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_EQ(m.at(2), "dup");
+  EXPECT_FALSE(m.contains(1));
+}
+
+// Single-pass range of {key, -key} over whitespace separated keys
+class NegatedPairReader {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = std::pair<const int, int>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const value_type*;
+  using reference = value_type;
+
+  NegatedPairReader() = default;
+  explicit NegatedPairReader(std::istream& in) : it_(in) {}
+  value_type operator*() const { return {*it_, -*it_}; }
+  NegatedPairReader& operator++() {
+    ++it_;
+    return *this;
+  }
+  bool operator!=(const NegatedPairReader& other) const {
+    return it_ != other.it_;
+  }
+  bool operator==(const NegatedPairReader& other) const {
+    return it_ == other.it_;
+  }
+
+ private:
+  std::istream_iterator<int> it_;
+};
+
+TEST(TestsMap, RangeFromInputIterator) {
+  std::istringstream in("1 2 3 4 5 2");
+  s21::map<int, int> m{NegatedPairReader(in), NegatedPairReader()};
+
+  EXPECT_EQ(m.size(), 5);
+  int key = 1;
+  for (auto it = m.begin(); it != m.end(); ++it, ++key) {
+    EXPECT_EQ((*it).first, key);
+    EXPECT_EQ((*it).second, -key);
+  }
+}
+
+TEST(TestsMap, SetAlgebraKeepsOwnValues) {
+  s21::map<int, std::string> m1 = {{1, "one"}, {2, "two"}, {3, "three"}};
+  s21::map<int, std::string> m2 = {{2, "TWO"}, {3, "THREE"}, {4, "FOUR"}};
+
+  s21::map<int, std::string> united(m1);
+  united.set_union(m2);
+  EXPECT_EQ(united.size(), 4);
+  EXPECT_EQ(united.at(2), "two");
+  EXPECT_EQ(united.at(4), "FOUR");
+
+  s21::map<int, std::string> common(m1);
+  common.set_intersection(m2);
+  EXPECT_EQ(common.size(), 2);
+  EXPECT_EQ(common.at(3), "three");
+
+  m1.set_difference(m2);
+  EXPECT_EQ(m1.size(), 1);
+  EXPECT_EQ(m1.begin()->second, "one");
+  EXPECT_EQ(m2.size(), 3);
+}
+
+TEST(TestsMap, TransparentLookup) {
+  s21::map<std::string, int, std::less<>> m = {{"one", 1}, {"two", 2}};
+  std::string_view key = "two";
+
+  EXPECT_EQ(m.at(key), 2);
+  EXPECT_EQ(m.at("one"), 1);
+  EXPECT_THROW(m.at("three"), std::out_of_range);
+  EXPECT_TRUE(m.contains(key));
+  EXPECT_EQ(m.count("three"), 0);
+  EXPECT_EQ(m.find(key)->second, 2);
+  EXPECT_EQ(m.find("three"), m.end());
+}
+
+TEST(TestsMap, Bounds) {
+  s21::map<int, std::string> m = {{10, "ten"}, {20, "twenty"}, {30, "thirty"}};
+
+  EXPECT_EQ(m.lower_bound(20)->second, "twenty");
+  EXPECT_EQ(m.lower_bound(15)->second, "twenty");
+  EXPECT_EQ(m.upper_bound(20)->second, "thirty");
+  EXPECT_EQ(m.lower_bound(5)->first, 10);
+  EXPECT_EQ(m.lower_bound(31), m.end());
+  EXPECT_EQ(m.upper_bound(30), m.end());
+
+  auto range = m.equal_range(25);
+  EXPECT_EQ(range.first, range.second);
+  EXPECT_EQ(range.first->first, 30);
+
+  auto found = m.equal_range(10);
+  EXPECT_EQ(found.first->first, 10);
+  EXPECT_EQ(found.second->first, 20);
+}
+
+TEST(TestsMap, RangeErase) {
+  s21::map<int, int> m;
+  for (int i = 0; i < 1000; ++i) {
+    m.insert(i, i * i);
+  }
+
+  // Evicts everything older than 600
+  auto it = m.erase(m.begin(), m.lower_bound(600));
+  EXPECT_EQ(it->first, 600);
+  EXPECT_EQ(it->second, 360000);
+  EXPECT_EQ(m.size(), 400);
+  EXPECT_EQ(m.begin()->first, 600);
+
+  EXPECT_EQ(m.erase(700), 1);
+  EXPECT_EQ(m.erase(700), 0);
+  EXPECT_EQ(m.size(), 399);
+  EXPECT_EQ(m.rank(701), 100);
+
+  m.erase(m.begin(), m.end());
+  EXPECT_TRUE(m.empty());
+}
+
+TEST(TestsMap, HintedInsert) {
+  s21::map<int, std::string> m;
+  auto it = m.end();
+  for (int i = 0; i < 100; ++i) {
+    it = m.insert(it, {i, std::to_string(i)});
+  }
+  EXPECT_EQ(m.size(), 100);
+  EXPECT_EQ(m.at(42), "42");
+  EXPECT_EQ(m.rank(50), 50);
+
+  it = m.emplace_hint(m.begin(), -1, "minus one");
+  EXPECT_EQ(it->second, "minus one");
+  EXPECT_EQ(m.begin()->first, -1);
+
+  it = m.insert(m.end(), {5, "five"});
+  EXPECT_EQ(it->second, "5");
+  EXPECT_EQ(m.size(), 101);
+}
+
+// Remembers whether the object itself went through a copy and how many
+// moves led to it
+struct Tracked {
+  int id;
+  std::string payload;
+  bool copied = false;
+  int moves = 0;
+
+  Tracked() : id(0) {}
+  Tracked(int id_value, std::string text)
+      : id(id_value), payload(std::move(text)) {}
+  Tracked(const Tracked& other)
+      : id(other.id), payload(other.payload), copied(true) {}
+  Tracked(Tracked&& other) noexcept
+      : id(other.id),
+        payload(std::move(other.payload)),
+        copied(other.copied),
+        moves(other.moves + 1) {}
+  Tracked& operator=(const Tracked& other) = default;
+};
+
+TEST(TestsMap, TryEmplaceConstructsInPlace) {
+  s21::map<int, Tracked> m;
+
+  EXPECT_TRUE(m.try_emplace(1, 10, "ten").second);
+  EXPECT_EQ(m.at(1).payload, "ten");
+  EXPECT_FALSE(m.at(1).copied);
+  EXPECT_EQ(m.at(1).moves, 0);
+
+  // The arguments are not used for a present key
+  EXPECT_FALSE(m.try_emplace(1, 11, "eleven").second);
+  EXPECT_EQ(m.at(1).id, 10);
+
+  int key = 2;
+  EXPECT_TRUE(m.try_emplace(std::move(key)).second);
+  EXPECT_EQ(m.at(2).id, 0);
+}
+
+TEST(TestsMap, EmplaceAndRvalueInsertDoNotCopy) {
+  s21::map<int, Tracked> m;
+  std::string text(100, 'x');
+  const char* buffer = text.data();
+
+  auto result = m.emplace(2, Tracked(20, std::move(text)));
+  EXPECT_TRUE(result.second);
+  EXPECT_FALSE(m.at(2).copied);
+  EXPECT_EQ(m.at(2).payload.data(), buffer);
+
+  m.insert(std::pair<const int, Tracked>(3, Tracked(30, "thirty")));
+  EXPECT_FALSE(m.at(3).copied);
+  EXPECT_EQ(m.at(3).payload, "thirty");
+
+  m.emplace_hint(m.end(), 4, Tracked(40, "forty"));
+  EXPECT_FALSE(m.at(4).copied);
+
+  EXPECT_FALSE(m.emplace(2, Tracked(21, "dup")).second);
+  EXPECT_EQ(m.at(2).id, 20);
+  EXPECT_EQ(m.size(), 3);
+}
+
+TEST(TestsMap, IteratorsReferToNodes) {
+  s21::map<int, Tracked> m;
+  m.try_emplace(1, 10, "ten");
+  m.try_emplace(2, 20, "twenty");
+
+  for (auto it = m.begin(); it != m.end(); ++it) {
+    it->second.id += 1;
+    EXPECT_FALSE(it->second.copied);
+  }
+  EXPECT_EQ(m.at(1).id, 11);
+  EXPECT_EQ(m.at(2).id, 21);
+
+  auto it = m.find(2);
+  EXPECT_EQ(&*it, &*m.find(2));
+  EXPECT_EQ(&it->second, &m.at(2));
+  (*it).second.payload = "changed";
+  EXPECT_EQ(m.at(2).payload, "changed");
+}
+
+TEST(TestsMap, SubscriptDescendsOnce) {
+  int comparisons = 0;
+  auto less = [&comparisons](int a, int b) {
+    ++comparisons;
+    return a < b;
+  };
+  s21::map<int, int, decltype(less)> m(less);
+  for (int i = 0; i < 1024; ++i) {
+    m[2 * i] = i;
+  }
+
+  // At most two comparisons per level of a tree of height 11
+  comparisons = 0;
+  m[1001]++;
+  EXPECT_LE(comparisons, 22);
+  comparisons = 0;
+  m[1001]++;
+  EXPECT_LE(comparisons, 22);
+  EXPECT_EQ(m.at(1001), 2);
+  EXPECT_EQ(m.size(), 1025);
+}
+
+TEST(TestsMap, InsertOrAssignMovesValue) {
+  s21::map<std::string, Tracked> m;
+  std::string key = "key";
+  auto result = m.insert_or_assign(key, Tracked(1, "one"));
+  EXPECT_TRUE(result.second);
+  EXPECT_FALSE(result.first->second.copied);
+
+  result = m.insert_or_assign(std::move(key), Tracked(2, "two"));
+  EXPECT_FALSE(result.second);
+  EXPECT_FALSE(m.at("key").copied);
+  EXPECT_EQ(m.at("key").id, 2);
+  EXPECT_EQ(m.size(), 1);
+}
+
+TEST(TestsMap, FindBatch) {
+  s21::map<std::string, int> m = {{"a", 1}, {"c", 3}, {"e", 5}};
+  std::vector<std::string> keys = {"e", "b", "a", "f", "c", "a"};
+  std::vector<s21::map<std::string, int>::iterator> found(keys.size());
+  m.find_batch(keys.begin(), keys.end(), found.begin());
+  std::vector<int> values;
+  for (auto it : found) {
+    values.push_back(it == m.end() ? 0 : it->second);
+  }
+  EXPECT_EQ(values, std::vector<int>({5, 0, 1, 0, 3, 1}));
+  bool contained[6];
+  m.contains_batch(keys.begin(), keys.end(), contained);
+  EXPECT_TRUE(contained[0]);
+  EXPECT_FALSE(contained[1]);
+  EXPECT_FALSE(contained[3]);
+}
@@ -1,7 +1,49 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
 #include "../s21_containersplus.h"
 
+namespace {
+
+// Instances with different ids compare unequal, each id owns its memory
+template <typename T>
+struct TaggedAllocator {
+  using value_type = T;
+
+  int id;
+  long* live;
+
+  TaggedAllocator(int i, long* l) : id(i), live(l) {}
+  template <typename U>
+  TaggedAllocator(const TaggedAllocator<U>& other)
+      : id(other.id), live(other.live) {}
+
+  T* allocate(std::size_t n) {
+    *live += static_cast<long>(n);
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) {
+    *live -= static_cast<long>(n);
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const TaggedAllocator<U>& other) const {
+    return id == other.id;
+  }
+  template <typename U>
+  bool operator!=(const TaggedAllocator<U>& other) const {
+    return id != other.id;
+  }
+};
+
+}  // namespace
+
 namespace s21 {
 
 TEST(MultisetTest, ConstructorDefault) {
@@ -109,6 +151,21 @@ TEST(MultisetTest, UpperBound) {
   EXPECT_EQ(*it, 3);
 }
 
+TEST(MultisetTest, BoundsForAbsentKeys) {
+  multiset<int> ms = {1, 2, 2, 5, 5, 8};
+  EXPECT_EQ(*ms.lower_bound(3), 5);
+  EXPECT_EQ(*ms.upper_bound(3), 5);
+  EXPECT_EQ(*ms.lower_bound(0), 1);
+
+  auto range = ms.equal_range(4);
+  EXPECT_EQ(range.first, range.second);
+  EXPECT_EQ(*range.first, 5);
+
+  range = ms.equal_range(9);
+  EXPECT_EQ(range.first, ms.end());
+  EXPECT_EQ(range.second, ms.end());
+}
+
 TEST(MultisetTest, InsertAndIterate) {
   multiset<int> ms;
   ms.insert(10);
@@ -156,6 +213,36 @@ TEST(MultisetTest, Merge) {
   EXPECT_EQ(ms2.size(), 0);
 }
 
+TEST(MultisetTest, MergeWithUnequalAllocators) {
+  using tagged_multiset =
+      s21::multiset<int, std::less<int>, TaggedAllocator<int>>;
+  long live1 = 0;
+  long live2 = 0;
+  {
+    tagged_multiset ms1(std::less<int>(), TaggedAllocator<int>(1, &live1));
+    tagged_multiset ms2(std::less<int>(), TaggedAllocator<int>(2, &live2));
+    for (int value : {1, 2, 2, 3}) {
+      ms1.insert(value);
+    }
+    for (int value : {2, 3, 4, 4}) {
+      ms2.insert(value);
+    }
+
+    ms1.merge(ms2);
+
+    EXPECT_EQ(ms1.size(), 8);
+    EXPECT_EQ(ms1.count(2), 3);
+    EXPECT_EQ(ms1.count(4), 2);
+    EXPECT_TRUE(ms2.empty());
+    ms2.clear();
+    // ms2 does not hold memory of ms1's allocator or the other way round
+    EXPECT_EQ(live2, 0);
+    EXPECT_GT(live1, 0);
+  }
+  EXPECT_EQ(live1, 0);
+  EXPECT_EQ(live2, 0);
+}
+
 TEST(MultisetTest, MergeSelf) {
   s21::multiset<int> ms = {1, 2, 2, 3};
 
@@ -323,4 +410,78 @@ TEST(MultisetTest, SelfMoveAssignment) {
   EXPECT_TRUE(ms.contains(3));
 }
 
+
+TEST(MultisetTest, OrderStatistics) {
+  multiset<int> ms = {4, 1, 2, 2, 3, 3, 3};
+
+  std::vector<int> expected = {1, 2, 2, 3, 3, 3, 4};
+  for (size_t k = 0; k < expected.size(); ++k) {
+    EXPECT_EQ(*ms.select(k), expected[k]);
+  }
+  EXPECT_EQ(ms.select(7), ms.end());
+
+  EXPECT_EQ(ms.rank(1), 0);
+  EXPECT_EQ(ms.rank(3), 3);
+  EXPECT_EQ(ms.rank(5), 7);
+  EXPECT_EQ(ms.count_range(2, 4), 5);
+  EXPECT_EQ(ms.count_range(3, 3), 0);
+}
+
+TEST(MultisetTest, TransparentLookup) {
+  multiset<std::string, std::less<>> ms = {"a", "b", "b", "c", "b"};
+  std::string_view key = "b";
+
+  EXPECT_EQ(ms.count(key), 3);
+  EXPECT_EQ(ms.count("d"), 0);
+  EXPECT_EQ(*ms.find(key), "b");
+  EXPECT_EQ(ms.find("d"), ms.end());
+  EXPECT_TRUE(ms.contains(key));
+}
+
+TEST(MultisetTest, EraseByKeyRemovesAllCopies) {
+  multiset<int> ms = {1, 2, 2, 2, 3, 4, 4};
+  EXPECT_EQ(ms.erase(2), 3);
+  EXPECT_EQ(ms.erase(2), 0);
+  EXPECT_EQ(ms.size(), 4);
+  EXPECT_EQ(ms.count(4), 2);
+
+  ms.erase(ms.lower_bound(3), ms.end());
+  EXPECT_EQ(ms.size(), 1);
+  EXPECT_EQ(*ms.begin(), 1);
+}
+
+TEST(MultisetTest, HintedInsert) {
+  multiset<int> ms;
+  for (int i = 0; i < 100; ++i) {
+    ms.insert(ms.end(), i / 10);
+  }
+  auto it = ms.insert(ms.find(5), 5);
+  EXPECT_EQ(*it, 5);
+  it = ms.emplace_hint(ms.begin(), 9);
+  EXPECT_EQ(*it, 9);
+
+  EXPECT_EQ(ms.size(), 102);
+  EXPECT_EQ(ms.count(5), 11);
+  EXPECT_EQ(ms.count(9), 11);
+  EXPECT_EQ(ms.rank(6), 61);
+  int previous = -1;
+  for (int value : ms) {
+    EXPECT_LE(previous, value);
+    previous = value;
+  }
+}
+
+TEST(MultisetTest, EmplaceAndRvalueInsert) {
+  multiset<std::string> ms;
+  ms.emplace(3, 'z');
+  ms.emplace("zzz");
+  std::string key = "a";
+  ms.insert(std::move(key));
+  ms.emplace_hint(ms.begin(), "a");
+
+  EXPECT_EQ(ms.size(), 4);
+  EXPECT_EQ(ms.count("zzz"), 2);
+  EXPECT_EQ(ms.count("a"), 2);
+}
+
 }  // namespace s21
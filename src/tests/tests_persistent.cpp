@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+// Exposes the shared nodes of a persistent_map
+class CheckedPersistentMap : public s21::persistent_map<int, int> {
+  using Base = s21::persistent_map<int, int>;
+
+ public:
+  using Base::Base;
+  CheckedPersistentMap(const Base& m) : Base(m) {}
+
+  bool is_valid() const {
+    size_t count = 0;
+    return check(root_, nullptr, nullptr, count) >= 0 && count == size();
+  }
+
+  // Nodes reachable from this map that other does not reach
+  size_t private_nodes(const CheckedPersistentMap& other) const {
+    std::set<const void*> shared;
+    collect(other.root_, shared);
+    std::set<const void*> own;
+    collect(root_, own);
+    size_t count = 0;
+    for (const void* node : own) {
+      count += shared.count(node) == 0;
+    }
+    return count;
+  }
+
+ private:
+  static int check(Node* node, const int* lo, const int* hi, size_t& count) {
+    if (node == nullptr) {
+      return 0;
+    }
+    if (node->refs.load() == 0 || (lo && !(*lo < node->key())) ||
+        (hi && !(node->key() < *hi))) {
+      return -1;
+    }
+    ++count;
+    int left = check(node->left, lo, &node->key(), count);
+    int right = check(node->right, &node->key(), hi, count);
+    if (left < 0 || right < 0 || left - right > 1 || right - left > 1 ||
+        node->height != std::max(left, right) + 1) {
+      return -1;
+    }
+    return node->height;
+  }
+
+  static void collect(Node* node, std::set<const void*>& nodes) {
+    if (node) {
+      nodes.insert(node);
+      collect(node->left, nodes);
+      collect(node->right, nodes);
+    }
+  }
+};
+
+TEST(TestsPersistent, MapBasics) {
+  s21::persistent_map<int, std::string> m = {{3, "three"}, {1, "one"}};
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_TRUE(m.insert(2, "two").second);
+  EXPECT_FALSE(m.insert({2, "deux"}).second);
+  EXPECT_EQ(m.at(2), "two");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+  EXPECT_TRUE(m.try_emplace(4, 3, 'x').second);
+  EXPECT_EQ(m.at(4), "xxx");
+  EXPECT_EQ(m.emplace(5, "five").first->second, "five");
+  EXPECT_FALSE(m.insert_or_assign(1, "uno").second);
+  EXPECT_EQ(m.at(1), "uno");
+
+  std::vector<int> keys;
+  for (const auto& item : m) {
+    keys.push_back(item.first);
+  }
+  EXPECT_EQ(keys, std::vector<int>({1, 2, 3, 4, 5}));
+  EXPECT_EQ((--m.end())->first, 5);
+  EXPECT_EQ(m.find(6), m.end());
+  EXPECT_EQ(m.find(3)->second, "three");
+  EXPECT_EQ(m.lower_bound(0)->first, 1);
+  EXPECT_EQ(m.upper_bound(5), m.end());
+  EXPECT_EQ(m.count(3), 1);
+  EXPECT_EQ(m.erase(3), 1);
+  EXPECT_EQ(m.erase(3), 0);
+  EXPECT_FALSE(m.contains(3));
+  EXPECT_THROW(*m.end(), std::out_of_range);
+}
+
+TEST(TestsPersistent, SnapshotsStayUnchanged) {
+  CheckedPersistentMap m;
+  std::map<int, int> expected;
+  std::vector<std::pair<CheckedPersistentMap, std::map<int, int>>> snapshots;
+
+  unsigned state = 2024;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int key = static_cast<int>((state >> 8) % 1500);
+    unsigned op = (state >> 4) % 6;
+    if (op < 2) {
+      ASSERT_EQ(m.erase(key), expected.erase(key));
+    } else if (op < 5) {
+      ASSERT_EQ(m.insert(key, i).second, expected.insert({key, i}).second);
+    } else {
+      ASSERT_EQ(m.insert_or_assign(key, i).second, expected.count(key) == 0);
+      expected[key] = i;
+    }
+    if (i % 1000 == 0) {
+      ASSERT_TRUE(m.is_valid());
+      snapshots.emplace_back(m.snapshot(), expected);
+    }
+  }
+  ASSERT_TRUE(m.is_valid());
+
+  for (auto& snapshot : snapshots) {
+    ASSERT_TRUE(snapshot.first.is_valid());
+    ASSERT_EQ(snapshot.first.size(), snapshot.second.size());
+    auto it = snapshot.first.begin();
+    for (const auto& item : snapshot.second) {
+      ASSERT_EQ(it->first, item.first);
+      ASSERT_EQ(it->second, item.second);
+      ++it;
+    }
+    ASSERT_EQ(it, snapshot.first.end());
+  }
+}
+
+TEST(TestsPersistent, UpdatesCopyOnePath) {
+  CheckedPersistentMap m;
+  for (int i = 0; i < 4096; ++i) {
+    m.insert(i, i);
+  }
+  CheckedPersistentMap snapshot = m.snapshot();
+  EXPECT_EQ(m.private_nodes(snapshot), 0);
+
+  // A tree of 4096 nodes is at most 17 levels high
+  m.insert(5000, 0);
+  EXPECT_LE(m.private_nodes(snapshot), 18);
+  m.erase(2048);
+  m.insert_or_assign(7, -7);
+  EXPECT_LE(m.private_nodes(snapshot), 3 * 18);
+  EXPECT_TRUE(m.is_valid());
+  EXPECT_EQ(snapshot.at(7), 7);
+  EXPECT_EQ(m.at(7), -7);
+  EXPECT_TRUE(snapshot.contains(2048));
+
+  // Nodes owned by the map alone are changed in place
+  snapshot.clear();
+  size_t before = m.size();
+  m.insert_or_assign(8, -8);
+  EXPECT_EQ(m.size(), before);
+  EXPECT_EQ(m.private_nodes(snapshot), m.size());
+}
+
+TEST(TestsPersistent, ReadersOnOtherThreads) {
+  s21::persistent_map<int, int> m;
+  std::vector<std::thread> readers;
+  std::vector<int> failures(8, 0);
+  for (int round = 0; round < 8; ++round) {
+    for (int i = 0; i < 500; ++i) {
+      m.insert_or_assign(round * 500 + i, round);
+      m.erase(round * 500 + i - 700);
+    }
+    // Each reader owns its snapshot and drops it at the end
+    readers.emplace_back(
+        [snapshot = m.snapshot(), round, &failures]() mutable {
+          size_t count = 0;
+          for (const auto& item : snapshot) {
+            failures[round] += item.second != item.first / 500;
+            ++count;
+          }
+          failures[round] += count != snapshot.size();
+          snapshot.clear();
+        });
+  }
+  m.clear();
+  for (std::thread& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(failures, std::vector<int>(8, 0));
+}
@@ -1,11 +1,96 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <set>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include "../s21_containers.h"
 
+// Counts the slots requested from it, copies share the counter
+template <typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  size_t* allocated;
+
+  explicit CountingAllocator(size_t* counter) : allocated(counter) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>& other)
+      : allocated(other.allocated) {}
+
+  T* allocate(size_t n) {
+    *allocated += n;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, size_t n) {
+    *allocated -= n;
+    std::allocator<T>().deallocate(p, n);
+  }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>& other) const {
+    return allocated == other.allocated;
+  }
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>& other) const {
+    return allocated != other.allocated;
+  }
+};
+
+// Exposes the tree internals of a set to check the AVL invariants
+class CheckedSet : public s21::set<int> {
+ public:
+  using s21::set<int>::set;
+
+  bool is_valid() {
+    if (header_.parent_ == nullptr) {
+      return size() == 0 && begin() == end();
+    }
+    NodeBase* root = header_.parent_;
+    int height = 0;
+    size_t count = 0;
+    return root->parent_ == &header_ && check(root, height, count) &&
+           count == size() && header_.left_ == find_min_node(root) &&
+           header_.right_ == find_max_node(root);
+  }
+
+  size_t shared_chunks() const { return pool_.shared_count(); }
+
+ private:
+  bool check(NodeBase* node, int& height, size_t& count) {
+    if (node == nullptr) {
+      height = 0;
+      count = 0;
+      return true;
+    }
+    int left_height, right_height;
+    size_t left_count, right_count;
+    if (!check(node->left_, left_height, left_count) ||
+        !check(node->right_, right_height, right_count)) {
+      return false;
+    }
+    int key = static_cast<Node*>(node)->key();
+    if ((node->left_ && (node->left_->parent_ != node ||
+                         static_cast<Node*>(node->left_)->key() >= key)) ||
+        (node->right_ && (node->right_->parent_ != node ||
+                          static_cast<Node*>(node->right_)->key() <= key))) {
+      return false;
+    }
+    height = std::max(left_height, right_height) + 1;
+    count = left_count + right_count + 1;
+    return node->height == height && node->count == static_cast<int>(count) &&
+           std::abs(left_height - right_height) <= 1;
+  }
+};
+
 TEST(TestsSet, Empty) {
   s21::set<int> s;
   EXPECT_TRUE(s.empty());
@@ -20,6 +105,9 @@ TEST(TestsSet, InsertAndSize) {
 
   EXPECT_FALSE(s.empty());
   EXPECT_EQ(s.size(), 3);
+  // Counting is off unless S21_CONTAINERS_STATS is defined
+  EXPECT_EQ(s.stats().allocations, 0);
+  EXPECT_EQ(s.stats().comparisons, 0);
 }
 
 TEST(TestsSet, InsertDuplicate) {
@@ -228,4 +316,722 @@ TEST(TestsSet, InsertManyTest) {
   for (const auto& elem : s) {
     EXPECT_EQ(elem, expected[idx++]);
   }
-}
\ No newline at end of file
+}
+TEST(TestsSet, EraseAndReinsertReusesNodes) {
+  s21::set<std::string> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(std::to_string(i));
+  }
+  for (int i = 0; i < 1000; i += 2) {
+    s.erase(s.find(std::to_string(i)));
+  }
+  EXPECT_EQ(s.size(), 500);
+  for (int i = 0; i < 1000; i += 2) {
+    s.insert(std::to_string(i));
+  }
+  EXPECT_EQ(s.size(), 1000);
+
+  std::set<std::string> expected;
+  for (int i = 0; i < 1000; ++i) {
+    expected.insert(std::to_string(i));
+  }
+  auto it = s.begin();
+  for (const auto& item : expected) {
+    EXPECT_EQ(*it, item);
+    ++it;
+  }
+}
+
+TEST(TestsSet, ClearAndReuse) {
+  s21::set<int> s;
+  for (int round = 0; round < 3; ++round) {
+    for (int i = 0; i < 5000; ++i) {
+      s.insert(i);
+    }
+    EXPECT_EQ(s.size(), 5000);
+    s.clear();
+    EXPECT_TRUE(s.empty());
+  }
+  s.insert(42);
+  EXPECT_TRUE(s.contains(42));
+}
+
+TEST(TestsSet, InsertDuplicateReturnsExisting) {
+  s21::set<int> s = {5, 3, 8};
+  auto result = s.insert(3);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(*result.first, 3);
+  EXPECT_EQ(result.first, s.find(3));
+  ++result.first;
+  EXPECT_EQ(*result.first, 5);
+}
+
+TEST(TestsSet, RandomInsertEraseMatchesStd) {
+  s21::set<int> s;
+  std::set<int> expected;
+  unsigned state = 12345;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int value = static_cast<int>((state >> 8) % 2000);
+    if ((state >> 4) % 3 == 0) {
+      auto it = s.find(value);
+      if (it != s.end()) s.erase(it);
+      expected.erase(value);
+    } else {
+      EXPECT_EQ(s.insert(value).second, expected.insert(value).second);
+    }
+  }
+
+  EXPECT_EQ(s.size(), expected.size());
+  auto it = s.begin();
+  for (int value : expected) {
+    EXPECT_EQ(*it, value);
+    ++it;
+  }
+  EXPECT_EQ(it, s.end());
+}
+
+TEST(TestsSet, BoundsMatchStd) {
+  std::vector<int> values;
+  for (int i = 0; i < 500; ++i) {
+    values.push_back(i * 3);
+  }
+  s21::set<int> s(values.begin(), values.end());
+  std::set<int> expected(values.begin(), values.end());
+
+  for (int key = -2; key < 1505; ++key) {
+    auto lower = s.lower_bound(key);
+    auto expected_lower = expected.lower_bound(key);
+    if (expected_lower == expected.end()) {
+      EXPECT_EQ(lower, s.end());
+    } else {
+      EXPECT_EQ(*lower, *expected_lower);
+    }
+
+    auto range = s.equal_range(key);
+    auto expected_upper = expected.upper_bound(key);
+    EXPECT_EQ(range.first, lower);
+    if (expected_upper == expected.end()) {
+      EXPECT_EQ(range.second, s.end());
+    } else {
+      EXPECT_EQ(*range.second, *expected_upper);
+    }
+    size_t found = 0;
+    for (auto it = range.first; it != range.second; ++it) {
+      found++;
+    }
+    EXPECT_EQ(found, expected.count(key));
+  }
+
+  s21::set<int> empty;
+  EXPECT_EQ(empty.lower_bound(1), empty.end());
+  EXPECT_EQ(empty.upper_bound(1), empty.end());
+}
+
+TEST(TestsSet, RangeEraseMatchesStd) {
+  std::vector<int> values;
+  for (int i = 0; i < 3000; ++i) {
+    values.push_back(i);
+  }
+  CheckedSet s(values.begin(), values.end());
+  std::set<int> expected(values.begin(), values.end());
+
+  unsigned state = 777;
+  while (!expected.empty()) {
+    state = state * 1103515245u + 12345u;
+    int lo = static_cast<int>((state >> 8) % 3000);
+    int hi = lo + static_cast<int>((state >> 4) % 200);
+    auto last = s.erase(s.lower_bound(lo), s.lower_bound(hi));
+    expected.erase(expected.lower_bound(lo), expected.lower_bound(hi));
+
+    ASSERT_TRUE(s.is_valid());
+    ASSERT_EQ(s.size(), expected.size());
+    auto expected_last = expected.lower_bound(hi);
+    if (expected_last == expected.end()) {
+      EXPECT_EQ(last, s.end());
+    } else {
+      EXPECT_EQ(*last, *expected_last);
+    }
+    if (expected.size() < 50) {
+      s.erase(s.begin(), s.end());
+      expected.clear();
+    }
+  }
+  EXPECT_TRUE(s.empty());
+  EXPECT_EQ(s.begin(), s.end());
+}
+
+TEST(TestsSet, EraseByKey) {
+  CheckedSet s = {1, 2, 3, 4, 5};
+  EXPECT_EQ(s.erase(3), 1);
+  EXPECT_EQ(s.erase(3), 0);
+  EXPECT_EQ(s.erase(10), 0);
+  EXPECT_EQ(s.size(), 4);
+  EXPECT_FALSE(s.contains(3));
+  EXPECT_TRUE(s.is_valid());
+
+  auto last = s.erase(s.begin(), s.begin());
+  EXPECT_EQ(*last, 1);
+  EXPECT_EQ(s.size(), 4);
+}
+
+TEST(TestsSet, HintedInsertAppendAndPrepend) {
+  CheckedSet s;
+  for (int i = 0; i < 5000; ++i) {
+    s.insert(s.end(), i);
+  }
+  auto it = s.begin();
+  for (int i = -1; i > -5000; --i) {
+    it = s.insert(it, i);
+  }
+  EXPECT_TRUE(s.is_valid());
+  EXPECT_EQ(s.size(), 9999);
+  EXPECT_EQ(*s.begin(), -4999);
+
+  // A hint equal to the key finds the existing element
+  auto found = s.insert(s.find(10), 10);
+  EXPECT_EQ(*found, 10);
+  EXPECT_EQ(s.size(), 9999);
+}
+
+TEST(TestsSet, HintedInsertWithAnyHintMatchesStd) {
+  CheckedSet s;
+  std::set<int> expected;
+  unsigned state = 99;
+  auto hint = s.end();
+  for (int i = 0; i < 5000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int value = static_cast<int>((state >> 8) % 3000);
+    if ((state >> 4) % 4 == 0) {
+      hint = s.begin();
+    }
+    hint = s.insert(hint, value);
+    EXPECT_EQ(*hint, value);
+    expected.insert(value);
+  }
+  EXPECT_TRUE(s.is_valid());
+  EXPECT_EQ(s.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), s.begin()));
+
+  auto emplaced = s.emplace_hint(s.end(), 4000);
+  EXPECT_EQ(*emplaced, 4000);
+}
+
+TEST(TestsSet, ReverseIterationAfterErase) {
+  s21::set<int> s;
+  for (int i = 0; i < 100; ++i) {
+    s.insert(i);
+  }
+  s.erase(s.begin());
+  s.erase(--s.end());
+
+  EXPECT_EQ(*s.begin(), 1);
+  EXPECT_EQ(*(--s.end()), 98);
+
+  int expected = 98;
+  auto it = s.end();
+  while (it != s.begin()) {
+    --it;
+    EXPECT_EQ(*it, expected--);
+  }
+  EXPECT_EQ(expected, 0);
+  EXPECT_THROW(--it, std::out_of_range);
+}
+
+TEST(TestsSet, IteratorsAfterSwapAndMove) {
+  s21::set<int> s1 = {3, 1, 2};
+  s21::set<int> s2;
+  s1.swap(s2);
+
+  EXPECT_EQ(s1.begin(), s1.end());
+  EXPECT_EQ(*s2.begin(), 1);
+  EXPECT_EQ(*(--s2.end()), 3);
+
+  s21::set<int> s3(std::move(s2));
+  EXPECT_EQ(s2.begin(), s2.end());
+  int expected = 1;
+  for (auto it = s3.begin(); it != s3.end(); ++it) {
+    EXPECT_EQ(*it, expected++);
+  }
+  EXPECT_EQ(expected, 4);
+}
+
+TEST(TestsSet, OrderStatistics) {
+  s21::set<int> s;
+  for (int i = 0; i < 100; ++i) {
+    s.insert(i * 2);
+  }
+
+  for (int k = 0; k < 100; ++k) {
+    EXPECT_EQ(*s.select(k), k * 2);
+  }
+  EXPECT_EQ(s.select(100), s.end());
+
+  EXPECT_EQ(s.rank(0), 0);
+  EXPECT_EQ(s.rank(10), 5);
+  EXPECT_EQ(s.rank(11), 6);
+  EXPECT_EQ(s.rank(1000), 100);
+
+  EXPECT_EQ(s.count_range(10, 20), 5);
+  EXPECT_EQ(s.count_range(9, 21), 6);
+  EXPECT_EQ(s.count_range(20, 10), 0);
+
+  s.erase(s.find(10));
+  EXPECT_EQ(*s.select(5), 12);
+  EXPECT_EQ(s.rank(12), 5);
+
+  s21::set<int> copy(s);
+  EXPECT_EQ(*copy.select(50), *s.select(50));
+  EXPECT_EQ(copy.rank(100), s.rank(100));
+}
+
+TEST(TestsSet, BulkBuildFromSortedRange) {
+  std::vector<int> sorted;
+  for (int i = 0; i < 10000; ++i) {
+    sorted.push_back(i);
+    if (i % 7 == 0) sorted.push_back(i);
+  }
+
+  s21::set<int> s(sorted.begin(), sorted.end());
+  EXPECT_EQ(s.size(), 10000);
+  EXPECT_EQ(*s.begin(), 0);
+  EXPECT_EQ(*(--s.end()), 9999);
+  for (int k = 0; k < 10000; k += 97) {
+    EXPECT_EQ(*s.select(k), k);
+    EXPECT_EQ(s.rank(k), static_cast<size_t>(k));
+  }
+
+  s.insert(-1);
+  s.erase(s.find(5000));
+  EXPECT_EQ(s.size(), 10000);
+  EXPECT_EQ(*s.begin(), -1);
+  EXPECT_FALSE(s.contains(5000));
+}
+
+TEST(TestsSet, AssignSortedFallsBackOnUnsorted) {
+  std::vector<int> unsorted = {5, 1, 4, 1, 3};
+  s21::set<int> s = {100, 200};
+  s.assign_sorted(unsorted.begin(), unsorted.end());
+
+  std::vector<int> expected = {1, 3, 4, 5};
+  EXPECT_EQ(s.size(), expected.size());
+  int idx = 0;
+  for (auto it = s.begin(); it != s.end(); ++it) {
+    EXPECT_EQ(*it, expected[idx++]);
+  }
+}
+
+TEST(TestsSet, RangeFromInputIterator) {
+  std::istringstream in("1 2 3 4 5 3");
+  s21::set<int> s{std::istream_iterator<int>(in),
+                  std::istream_iterator<int>()};
+
+  std::vector<int> expected = {1, 2, 3, 4, 5};
+  EXPECT_EQ(s.size(), expected.size());
+  int idx = 0;
+  for (auto it = s.begin(); it != s.end(); ++it) {
+    EXPECT_EQ(*it, expected[idx++]);
+  }
+}
+
+TEST(TestsSet, MergeKeepsDuplicatesInOther) {
+  s21::set<int> s1 = {1, 3, 5, 7};
+  s21::set<int> s2 = {2, 3, 4, 7, 8};
+
+  s1.merge(s2);
+
+  std::vector<int> expected = {1, 2, 3, 4, 5, 7, 8};
+  EXPECT_EQ(s1.size(), expected.size());
+  int idx = 0;
+  for (auto it = s1.begin(); it != s1.end(); ++it) {
+    EXPECT_EQ(*it, expected[idx++]);
+  }
+  EXPECT_EQ(s2.size(), 2);
+  EXPECT_TRUE(s2.contains(3));
+  EXPECT_TRUE(s2.contains(7));
+
+  s2.insert(10);
+  s1.erase(s1.find(2));
+  EXPECT_EQ(*(--s2.end()), 10);
+  EXPECT_EQ(*s1.select(1), 3);
+}
+
+namespace {
+
+struct MoveOnly {
+  int value;
+
+  MoveOnly(int v) : value(v) {}
+  MoveOnly(const MoveOnly& other) = delete;
+  MoveOnly(MoveOnly&& other) = default;
+  MoveOnly& operator=(MoveOnly&& other) = default;
+  bool operator<(const MoveOnly& other) const { return value < other.value; }
+};
+
+}  // namespace
+
+TEST(TestsSet, MergeRelinksNodesOfMoveOnlyKeys) {
+  s21::set<MoveOnly> s2;
+  for (int value : {2, 3, 4, 7, 8}) {
+    s2.emplace(value);
+  }
+  const MoveOnly* kept = &*s2.find(3);
+  const MoveOnly* moved = &*s2.find(4);
+  {
+    s21::set<MoveOnly> s1;
+    for (int value : {1, 3, 5, 7}) {
+      s1.emplace(value);
+    }
+    s1.merge(s2);
+
+    EXPECT_EQ(s1.size(), 7);
+    EXPECT_EQ(&*s1.find(4), moved);
+    EXPECT_EQ(s2.size(), 2);
+    EXPECT_EQ(&*s2.find(3), kept);
+  }
+  // The chunks shared with the destroyed s1 are still owned by s2
+  s2.emplace(10);
+  s2.erase(s2.find(7));
+  EXPECT_EQ(s2.size(), 2);
+  EXPECT_EQ((*s2.begin()).value, 3);
+
+  s21::set<MoveOnly> s3;
+  s3.emplace(3);
+  s3.emplace(11);
+  s3.merge(s2);
+  s2.merge(s3);
+  EXPECT_EQ(s2.size(), 3);
+  EXPECT_EQ(s3.size(), 1);
+}
+
+TEST(TestsSet, RepeatedMergeFromSamePoolKeepsSharingBounded) {
+  CheckedSet a = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  CheckedSet b;
+  const int rounds = 30;
+  for (int round = 0; round < rounds; ++round) {
+    for (int i = 0; i < 10; ++i) {
+      b.insert(i);
+    }
+    for (int i = 0; i < 100; ++i) {
+      b.insert(1000 + round * 100 + i);
+    }
+    a.merge(b);
+    EXPECT_EQ(b.size(), 10);
+  }
+
+  // One chunk group of b per merge at most, not every earlier one again
+  EXPECT_LE(a.shared_chunks(), static_cast<size_t>(rounds));
+  EXPECT_LE(b.shared_chunks(), static_cast<size_t>(rounds));
+  EXPECT_EQ(a.size(), 10 + rounds * 100);
+  EXPECT_TRUE(a.is_valid());
+  EXPECT_TRUE(b.is_valid());
+}
+
+TEST(TestsSet, MergeLargeRelinksBalancedTree) {
+  CheckedSet s1;
+  CheckedSet s2;
+  std::set<int> expected1;
+  std::set<int> expected2;
+  unsigned state = 777;
+  for (int i = 0; i < 5000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int value = static_cast<int>((state >> 8) % 20000);
+    s1.insert(value);
+    expected1.insert(value);
+  }
+  for (int i = 0; i < 300; ++i) {
+    state = state * 1103515245u + 12345u;
+    int value = static_cast<int>((state >> 8) % 20000);
+    s2.insert(value);
+    expected2.insert(value);
+  }
+
+  s1.merge(s2);
+  expected1.merge(expected2);
+
+  EXPECT_TRUE(s1.is_valid());
+  EXPECT_TRUE(s2.is_valid());
+  EXPECT_EQ(s1.size(), expected1.size());
+  EXPECT_EQ(s2.size(), expected2.size());
+  EXPECT_TRUE(std::equal(expected1.begin(), expected1.end(), s1.begin()));
+  EXPECT_TRUE(std::equal(expected2.begin(), expected2.end(), s2.begin()));
+
+  for (int value : expected2) {
+    s1.erase(s1.find(value));
+  }
+  s2.insert(-5);
+  EXPECT_TRUE(s1.is_valid());
+  EXPECT_TRUE(s2.is_valid());
+}
+
+TEST(TestsSet, MergeIntoSmallerTree) {
+  CheckedSet s1 = {50, 10};
+  CheckedSet s2;
+  for (int i = 0; i < 1000; ++i) {
+    s2.insert(i);
+  }
+
+  s1.merge(s2);
+
+  EXPECT_TRUE(s1.is_valid());
+  EXPECT_EQ(s1.size(), 1000);
+  EXPECT_EQ(s2.size(), 2);
+  EXPECT_TRUE(s2.contains(10));
+  EXPECT_TRUE(s2.contains(50));
+  EXPECT_TRUE(s2.is_valid());
+}
+
+TEST(TestsSet, SetAlgebraMatchesStd) {
+  s21::ForkJoinPool workers(4);
+  unsigned state = 99;
+  std::set<int> a_values;
+  std::set<int> b_values;
+  for (int i = 0; i < 20000; ++i) {
+    state = state * 1103515245u + 12345u;
+    a_values.insert(static_cast<int>((state >> 8) % 50000));
+    state = state * 1103515245u + 12345u;
+    b_values.insert(static_cast<int>((state >> 8) % 50000));
+  }
+  CheckedSet b(b_values.begin(), b_values.end());
+
+  std::vector<int> expected;
+  CheckedSet united(a_values.begin(), a_values.end());
+  united.set_union(b, 64, workers);
+  std::set_union(a_values.begin(), a_values.end(), b_values.begin(),
+                 b_values.end(), std::back_inserter(expected));
+  EXPECT_TRUE(united.is_valid());
+  EXPECT_EQ(united.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), united.begin()));
+
+  expected.clear();
+  CheckedSet common(a_values.begin(), a_values.end());
+  common.set_intersection(b, 64, workers);
+  std::set_intersection(a_values.begin(), a_values.end(), b_values.begin(),
+                        b_values.end(), std::back_inserter(expected));
+  EXPECT_TRUE(common.is_valid());
+  EXPECT_EQ(common.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), common.begin()));
+
+  expected.clear();
+  CheckedSet rest(a_values.begin(), a_values.end());
+  rest.set_difference(b, 64, workers);
+  std::set_difference(a_values.begin(), a_values.end(), b_values.begin(),
+                      b_values.end(), std::back_inserter(expected));
+  EXPECT_TRUE(rest.is_valid());
+  EXPECT_EQ(rest.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), rest.begin()));
+
+  EXPECT_TRUE(b.is_valid());
+  EXPECT_EQ(b.size(), b_values.size());
+}
+
+TEST(TestsSet, SetAlgebraWithEmpty) {
+  s21::set<int> a = {1, 2, 3};
+  s21::set<int> empty;
+
+  a.set_union(empty);
+  EXPECT_EQ(a.size(), 3);
+  a.set_difference(empty);
+  EXPECT_EQ(a.size(), 3);
+  empty.set_union(a);
+  EXPECT_EQ(empty.size(), 3);
+  a.set_intersection(s21::set<int>());
+  EXPECT_TRUE(a.empty());
+  EXPECT_EQ(a.begin(), a.end());
+}
+
+namespace {
+
+// Copies throw once copies_left runs out, live counts the objects alive
+struct ThrowingCopy {
+  static std::atomic<int> copies_left;
+  static std::atomic<int> live;
+  int value;
+
+  ThrowingCopy(int v) : value(v) { ++live; }
+  ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+    if (copies_left.fetch_sub(1) <= 0) {
+      throw std::runtime_error("copy failed");
+    }
+    ++live;
+  }
+  ~ThrowingCopy() { --live; }
+  bool operator<(const ThrowingCopy& other) const {
+    return value < other.value;
+  }
+};
+
+std::atomic<int> ThrowingCopy::copies_left{1 << 30};
+std::atomic<int> ThrowingCopy::live{0};
+
+}  // namespace
+
+TEST(TestsSet, SetUnionKeepsValidTreeWhenCopyThrows) {
+  s21::ForkJoinPool workers(4);
+  s21::set<ThrowingCopy> a;
+  s21::set<ThrowingCopy> b;
+  for (int i = 0; i < 4000; ++i) {
+    if (i % 2 == 0) {
+      a.emplace(i);
+    }
+    b.emplace(i);
+  }
+
+  ThrowingCopy::copies_left = 500;
+  EXPECT_THROW(a.set_union(b, 16, workers), std::runtime_error);
+  ThrowingCopy::copies_left = 1 << 30;
+
+  size_t count = 0;
+  int prev = -1;
+  for (const ThrowingCopy& item : a) {
+    EXPECT_LT(prev, item.value);
+    prev = item.value;
+    ++count;
+  }
+  EXPECT_EQ(count, a.size());
+  EXPECT_GE(a.size(), 2000);
+  EXPECT_LT(a.size(), 4000);
+  for (int i = 0; i < 4000; i += 2) {
+    EXPECT_TRUE(a.contains(i));
+  }
+
+  a.set_union(b, 16, workers);
+  EXPECT_EQ(a.size(), 4000);
+}
+
+TEST(TestsSet, SortedRangeReleasesNodesWhenCopyThrows) {
+  std::vector<ThrowingCopy> sorted;
+  for (int i = 0; i < 100; ++i) {
+    sorted.emplace_back(i / 2);
+  }
+  int live = ThrowingCopy::live;
+
+  ThrowingCopy::copies_left = 39;
+  EXPECT_THROW(s21::set<ThrowingCopy>(sorted.begin(), sorted.end()),
+               std::runtime_error);
+  EXPECT_EQ(ThrowingCopy::live, live);
+
+  ThrowingCopy::copies_left = 1 << 30;
+  s21::set<ThrowingCopy> s(sorted.begin(), sorted.end());
+  EXPECT_EQ(s.size(), 50);
+}
+
+TEST(TestsSet, ForkJoinPoolPropagatesExceptions) {
+  s21::ForkJoinPool workers(4);
+  std::function<long(int, int)> sum = [&](int lo, int hi) -> long {
+    if (hi - lo <= 8) {
+      long total = 0;
+      for (int i = lo; i < hi; ++i) {
+        if (i == 777) {
+          throw std::runtime_error("task failed");
+        }
+        total += i;
+      }
+      return total;
+    }
+    int mid = lo + (hi - lo) / 2;
+    long left = 0;
+    long right = 0;
+    workers.invoke([&] { left = sum(lo, mid); },
+                   [&] { right = sum(mid, hi); });
+    return left + right;
+  };
+
+  EXPECT_THROW(sum(0, 1000), std::runtime_error);
+  EXPECT_EQ(sum(0, 700), 699L * 700 / 2);
+  EXPECT_EQ(workers.threads(), 4);
+}
+
+TEST(TestsSet, CustomCompare) {
+  s21::set<int, std::greater<int>> s = {3, 1, 4, 1, 5, 9, 2, 6};
+  std::vector<int> expected = {9, 6, 5, 4, 3, 2, 1};
+
+  EXPECT_EQ(s.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), s.begin()));
+  EXPECT_EQ(s.rank(5), 2);
+  EXPECT_EQ(*s.select(0), 9);
+  EXPECT_EQ(s.count_range(6, 2), 4);
+
+  s21::set<int, std::greater<int>> other = {10, 5, 0};
+  s.set_union(other);
+  EXPECT_EQ(*s.begin(), 10);
+  EXPECT_EQ(s.size(), 9);
+}
+
+TEST(TestsSet, CustomAllocator) {
+  size_t allocated = 0;
+  {
+    using counting_set = s21::set<int, std::less<int>, CountingAllocator<int>>;
+    counting_set s(std::less<int>{}, CountingAllocator<int>(&allocated));
+    for (int i = 0; i < 100; i++) {
+      s.insert(i);
+    }
+    EXPECT_GT(allocated, 100);
+
+    counting_set copy(s);
+    EXPECT_TRUE(copy.get_allocator() == s.get_allocator());
+
+    size_t other_allocated = 0;
+    counting_set other(std::less<int>{},
+                       CountingAllocator<int>(&other_allocated));
+    other.insert(5);
+    other.insert(500);
+    s.merge(other);
+    EXPECT_EQ(s.size(), 101);
+    EXPECT_EQ(other.size(), 1);
+    EXPECT_TRUE(other.contains(5));
+  }
+  EXPECT_EQ(allocated, 0);
+}
+
+TEST(TestsSet, TransparentLookup) {
+  s21::set<std::string, std::less<>> s = {"apple", "banana", "cherry"};
+  std::string_view key = "banana";
+
+  EXPECT_TRUE(s.contains(key));
+  EXPECT_EQ(*s.find(key), "banana");
+  EXPECT_EQ(s.count("cherry"), 1);
+  EXPECT_EQ(s.count("durian"), 0);
+  EXPECT_EQ(s.find("durian"), s.end());
+}
+
+TEST(TestsSet, EmplaceAndRvalueInsert) {
+  s21::set<std::string> s;
+  EXPECT_TRUE(s.emplace(5, 'a').second);
+  EXPECT_FALSE(s.emplace("aaaaa").second);
+
+  std::string key(50, 'b');
+  EXPECT_TRUE(s.insert(std::move(key)).second);
+  EXPECT_TRUE(s.contains(std::string(50, 'b')));
+
+  auto results = s.insert_many(std::string("c"), "d", "c");
+  EXPECT_EQ(results.size(), 3);
+  EXPECT_FALSE(results[2].second);
+  EXPECT_EQ(s.size(), 4);
+}
+
+TEST(TestsSet, FindBatch) {
+  s21::set<int> s;
+  for (int i = 0; i < 1000; i += 2) {
+    s.insert(i);
+  }
+  // More keys than one batch, with hits, misses and repeats
+  std::vector<int> keys;
+  for (int i = 0; i < 100; ++i) {
+    keys.push_back((i * 37) % 1003 - 1);
+  }
+  std::vector<s21::set<int>::iterator> found;
+  s.find_batch(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  std::vector<bool> contained(keys.size());
+  EXPECT_EQ(s.contains_batch(keys.begin(), keys.end(), contained.begin()),
+            contained.end());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(found[i], s.find(keys[i]));
+    EXPECT_EQ(contained[i], s.contains(keys[i]));
+  }
+
+  s21::set<int> empty;
+  empty.find_batch(keys.begin(), keys.begin() + 3, found.begin());
+  EXPECT_EQ(found[0], empty.end());
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "../s21_containersplus.h"
+
+TEST(TestsSharded, MapBasics) {
+  s21::sharded_map<int, std::string, 4> m = {{3, "three"}, {1, "one"}};
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_TRUE(m.insert(2, "two"));
+  EXPECT_FALSE(m.insert({2, "deux"}));
+  EXPECT_EQ(m.find(2), "two");
+  EXPECT_EQ(m.at(1), "one");
+  EXPECT_THROW(m.at(4), std::out_of_range);
+  EXPECT_TRUE(m.try_emplace(4, 3, 'x'));
+  EXPECT_EQ(m.find(4), "xxx");
+  EXPECT_FALSE(m.insert_or_assign(1, "uno"));
+  EXPECT_EQ(m.find(1), "uno");
+  EXPECT_EQ(m.count(3), 1);
+  EXPECT_EQ(m.erase(3), 1);
+  EXPECT_EQ(m.erase(3), 0);
+  EXPECT_FALSE(m.contains(3));
+  EXPECT_FALSE(m.find(3).has_value());
+  EXPECT_EQ(m.size(), 3);
+  m.clear();
+  EXPECT_TRUE(m.empty());
+  auto view = m.read();
+  EXPECT_TRUE(view.empty());
+  EXPECT_EQ(view.begin(), view.end());
+}
+
+TEST(TestsSharded, ViewIsOrdered) {
+  s21::sharded_map<int, int> m;
+  std::map<int, int> expected;
+  unsigned state = 5;
+  for (int i = 0; i < 3000; ++i) {
+    state = state * 1103515245u + 12345u;
+    int key = static_cast<int>((state >> 8) % 5000);
+    m.insert_or_assign(key, i);
+    expected[key] = i;
+  }
+  auto view = m.read();
+  EXPECT_EQ(view.size(), expected.size());
+  auto it = view.begin();
+  for (const auto& item : expected) {
+    ASSERT_NE(it, view.end());
+    ASSERT_EQ(it->first, item.first);
+    ASSERT_EQ((*it++).second, item.second);
+  }
+  EXPECT_EQ(it, view.end());
+
+  for (int key = -1; key <= 5001; key += 7) {
+    auto lower = view.lower_bound(key);
+    auto expected_lower = expected.lower_bound(key);
+    if (expected_lower == expected.end()) {
+      EXPECT_EQ(lower, view.end());
+    } else {
+      EXPECT_EQ(lower->first, expected_lower->first);
+    }
+    auto upper = view.upper_bound(key);
+    auto expected_upper = expected.upper_bound(key);
+    if (expected_upper == expected.end()) {
+      EXPECT_EQ(upper, view.end());
+    } else {
+      EXPECT_EQ(upper->first, expected_upper->first);
+    }
+  }
+}
+
+TEST(TestsSharded, Batches) {
+  s21::sharded_map<int, int, 8> m;
+  std::vector<std::pair<const int, int>> items;
+  for (int i = 0; i < 1000; ++i) {
+    items.emplace_back(i * 3, i);
+  }
+  EXPECT_EQ(m.multi_insert(items.begin(), items.end()), 1000);
+  EXPECT_EQ(m.multi_insert({{0, -1}, {1, 1}}), 1);
+  EXPECT_EQ(m.find(0), 0);
+
+  std::vector<int> keys;
+  for (int key = 2999; key >= 0; --key) {
+    keys.push_back(key);
+  }
+  auto found = m.multi_find(keys.begin(), keys.end());
+  ASSERT_EQ(found.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] % 3 == 0) {
+      EXPECT_EQ(found[i], keys[i] / 3);
+    } else if (keys[i] == 1) {
+      EXPECT_EQ(found[i], 1);
+    } else {
+      EXPECT_FALSE(found[i].has_value());
+    }
+  }
+  EXPECT_EQ(m.multi_find({3, 4}), std::vector<std::optional<int>>({1, {}}));
+}
+
+// Views taken while writers run see every key that is never erased, in
+// order
+TEST(TestsSharded, ViewsWhileWriting) {
+  s21::sharded_map<int, int, 4> m;
+  for (int key = 0; key < 1000; key += 10) {
+    m.insert(key, key);
+  }
+  std::atomic<bool> done{false};
+  std::atomic<int> failures{0};
+  std::thread reader([&] {
+    while (!done.load()) {
+      auto view = m.read();
+      int previous = -1;
+      int stable = 0;
+      for (const auto& item : view) {
+        failures += item.first <= previous;
+        stable += item.first % 10 == 0;
+        previous = item.first;
+      }
+      failures += stable != 100;
+    }
+  });
+  std::vector<std::thread> writers;
+  for (int t = 0; t < 3; ++t) {
+    writers.emplace_back([&m, t] {
+      std::vector<std::pair<const int, int>> batch;
+      for (int i = 0; i < 3000; ++i) {
+        int key = (i * 7 + t) % 1000;
+        if (key % 10 == 0) {
+          continue;
+        }
+        if (i % 3 == 0) {
+          m.erase(key);
+        } else if (i % 3 == 1) {
+          m.insert(key, key);
+        } else {
+          batch.emplace_back(key, key);
+        }
+        if (batch.size() == 16) {
+          m.multi_insert(batch.begin(), batch.end());
+          batch.clear();
+        }
+      }
+    });
+  }
+  for (std::thread& writer : writers) {
+    writer.join();
+  }
+  done = true;
+  reader.join();
+  EXPECT_EQ(failures.load(), 0);
+  auto view = m.read();
+  size_t count = 0;
+  for (auto it = view.begin(); it != view.end(); ++it) {
+    ++count;
+  }
+  EXPECT_EQ(count, view.size());
+}
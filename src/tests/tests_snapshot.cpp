@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+namespace {
+
+std::string snapshot_path(const std::string& name) {
+  return testing::TempDir() + "s21_snapshot_" + name;
+}
+
+template <typename Set>
+std::vector<typename Set::key_type> keys_of(Set& s) {
+  std::vector<typename Set::key_type> keys;
+  for (auto it = s.begin(); it != s.end(); ++it) {
+    keys.push_back(*it);
+  }
+  return keys;
+}
+
+}  // namespace
+
+TEST(TestsSnapshot, SetRoundTrip) {
+  s21::set<std::uint64_t> s;
+  for (std::uint64_t i = 0; i < 1000; ++i) {
+    s.insert(i * 7919 % 1009);
+  }
+  std::string path = snapshot_path("set");
+  s.save(path);
+
+  s21::set<std::uint64_t> loaded = {5, 6};
+  loaded.load(path);
+  EXPECT_EQ(loaded.size(), s.size());
+  EXPECT_EQ(keys_of(loaded), keys_of(s));
+  EXPECT_EQ(*loaded.select(500), *s.select(500));
+  EXPECT_EQ(loaded.rank(700), s.rank(700));
+  loaded.erase(0);
+  EXPECT_TRUE(loaded.insert(5000).second);
+  EXPECT_EQ(*loaded.begin(), *s.select(1));
+  EXPECT_EQ(keys_of(loaded).back(), 5000);
+
+  s21::set<std::uint64_t> empty;
+  empty.save(path);
+  loaded.load(path);
+  EXPECT_TRUE(loaded.empty());
+  EXPECT_EQ(loaded.begin(), loaded.end());
+  std::remove(path.c_str());
+}
+
+TEST(TestsSnapshot, MapAndMultisetStreams) {
+  s21::map<int, double> m = {{3, 0.5}, {1, 1.5}, {2, 2.5}};
+  std::stringstream stream;
+  m.save(stream);
+  stream << "tail";
+
+  s21::map<int, double> loaded;
+  loaded.load(stream);
+  EXPECT_EQ(loaded.size(), 3);
+  EXPECT_EQ(loaded.at(1), 1.5);
+  EXPECT_EQ(loaded.at(3), 0.5);
+  std::string tail;
+  stream >> tail;
+  EXPECT_EQ(tail, "tail");
+
+  s21::multiset<int> ms = {4, 1, 4, 2, 4};
+  std::stringstream multi;
+  ms.save(multi);
+  s21::multiset<int> loaded_ms;
+  loaded_ms.load(multi);
+  EXPECT_EQ(loaded_ms.size(), 5);
+  EXPECT_EQ(loaded_ms.count(4), 3);
+  EXPECT_EQ(keys_of(loaded_ms), keys_of(ms));
+}
+
+TEST(TestsSnapshot, RejectsBadFiles) {
+  s21::map<int, int> m;
+  for (int i = 0; i < 100; ++i) {
+    m.insert(i, -i);
+  }
+  std::stringstream good;
+  m.save(good);
+  const std::string bytes = good.str();
+  s21::map<int, int> loaded = {{1, 1}};
+
+  std::string flipped = bytes;
+  flipped[sizeof(s21::SnapshotHeader) + 40] ^= 1;
+  std::stringstream corrupt(flipped);
+  EXPECT_THROW(loaded.load(corrupt), std::runtime_error);
+  EXPECT_TRUE(loaded.empty());
+
+  std::stringstream truncated(bytes.substr(0, bytes.size() - 12));
+  EXPECT_THROW(loaded.load(truncated), std::runtime_error);
+
+  std::string path = snapshot_path("map");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << bytes << "x";
+  }
+  EXPECT_THROW(loaded.load(path), std::runtime_error);
+
+  std::stringstream same(bytes);
+  s21::map<int, std::int64_t> other_type = {{1, 1}};
+  EXPECT_THROW(other_type.load(same), std::runtime_error);
+  EXPECT_EQ(other_type.size(), 1);
+
+  std::stringstream garbage("not a snapshot at all, not even close");
+  EXPECT_THROW(loaded.load(garbage), std::runtime_error);
+  EXPECT_THROW(loaded.load(snapshot_path("missing")), std::runtime_error);
+  std::remove(path.c_str());
+}
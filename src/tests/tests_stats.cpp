@@ -0,0 +1,60 @@
+// Built with the counters on. Its trees are declared in s21::counted and
+// do not clash with the uncounted ones of the remaining tests.
+#define S21_CONTAINERS_STATS
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "../s21_containers.h"
+#include "../s21_containersplus.h"
+
+static_assert(std::is_same<s21::set<int>, s21::counted::set<int>>::value,
+              "counting trees live in their own namespace");
+
+TEST(TestsStats, SetCountsRotationsAndNodes) {
+  s21::set<int> s;
+  for (int i = 0; i < 1000; ++i) {
+    s.insert(i);
+  }
+  s21::TreeStats stats = s.stats();
+  EXPECT_EQ(stats.allocations, 1000);
+  EXPECT_EQ(stats.deallocations, 0);
+  EXPECT_GT(stats.left_rotations, 0);
+  EXPECT_EQ(stats.right_rotations, 0);
+  EXPECT_GE(stats.comparisons, 1000);
+  // 1000 ascending keys end up in a tree of height 10
+  EXPECT_EQ(stats.max_depth, 10);
+
+  s.reset_stats();
+  stats = s.stats();
+  EXPECT_EQ(stats.comparisons, 0);
+  EXPECT_EQ(stats.left_rotations, 0);
+  EXPECT_EQ(stats.allocations, 0);
+  EXPECT_EQ(stats.max_depth, 0);
+
+  EXPECT_TRUE(s.contains(500));
+  EXPECT_GT(s.stats().comparisons, 0);
+  EXPECT_GE(s.stats().max_depth, 1);
+  for (int i = 0; i < 10; ++i) {
+    s.erase(i);
+  }
+  EXPECT_EQ(s.stats().deallocations, 10);
+
+  s21::set<int> copy(s);
+  EXPECT_EQ(copy.stats().allocations, 990);
+  EXPECT_EQ(copy.stats().comparisons, 0);
+  s.clear();
+  EXPECT_EQ(s.stats().deallocations, 1000);
+}
+
+TEST(TestsStats, MapCountsDescendingInserts) {
+  s21::map<int, int> m;
+  for (int i = 100; i > 0; --i) {
+    m.insert(i, -i);
+  }
+  EXPECT_GT(m.stats().right_rotations, 0);
+  EXPECT_EQ(m.stats().left_rotations, 0);
+  EXPECT_EQ(m.stats().allocations, 100);
+  EXPECT_EQ(m.at(1), -1);
+}
@@ -223,3 +223,44 @@ TEST(TestsVector, InsertMany) {
   v.insert_many_back(prefix + "4", prefix + "5", prefix + "6");
   v.insert_many_at(0, prefix + "1", prefix + "2", prefix + "3");
 }
+
+TEST(TestsVector, MoveAndEmplaceBack) {
+  std::string prefix(PREFIX);
+  s21::vector<std::string> v;
+  std::string moved = prefix + "moved";
+  const char* buffer = moved.data();
+  v.push_back(std::move(moved));
+  EXPECT_EQ(v[0].data(), buffer);
+
+  std::string& emplaced = v.emplace_back(3, 'x');
+  EXPECT_EQ(emplaced, "xxx");
+  EXPECT_EQ(&emplaced, &v[1]);
+  for (int i = 0; i < 20; i++) {
+    v.emplace_back(prefix + std::to_string(i));
+  }
+  EXPECT_EQ(v.size(), 22);
+  EXPECT_EQ(v[0], prefix + "moved");
+  EXPECT_EQ(v[21], prefix + "19");
+}
+
+TEST(TestsVector, PushBackOwnElementWhileGrowing) {
+  std::string prefix(PREFIX);
+  s21::vector<std::string> v;
+  v.push_back(prefix + "first");
+  v.push_back(prefix + "second");
+  ASSERT_EQ(v.size(), v.capacity());
+
+  v.push_back(v[0]);
+  ASSERT_EQ(v.size(), v.capacity() - 1);
+  v.emplace_back(v.back());
+  ASSERT_EQ(v.size(), v.capacity());
+  v.push_back(std::move(v[1]));
+  EXPECT_EQ(v.size(), 5);
+  EXPECT_EQ(v[2], prefix + "first");
+  EXPECT_EQ(v[3], prefix + "first");
+  EXPECT_EQ(v[4], prefix + "second");
+
+  v.insert(v.begin(), v[4]);
+  EXPECT_EQ(v[0], prefix + "second");
+  EXPECT_EQ(v.size(), 6);
+}
@@ -50,6 +50,9 @@ class vector {
   iterator insert(iterator pos, const_reference value);
   void erase(iterator pos);
   void push_back(const_reference value);
+  void push_back(value_type&& value);
+  template <typename... Args>
+  reference emplace_back(Args&&... args);
   void pop_back() noexcept;
   void swap(vector& other) noexcept;
 
@@ -64,6 +67,8 @@ class vector {
   size_type capacity_;
 
   void ensure_capacity_1();
+  template <typename... Args>
+  void grow_and_emplace_back(Args&&... args);
 };
 
 }  // namespace s21
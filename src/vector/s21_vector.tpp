@@ -195,16 +195,18 @@ typename vector<T>::iterator vector<T>::insert(iterator pos,
                                                const_reference value) {
   size_type move_number = end() - pos;
   size_type idx = pos - begin();
-  ensure_capacity_1();
   if (idx == size_) {
     push_back(value);
   } else {
+    // value may be an element that is moved or reallocated below
+    value_type copy(value);
+    ensure_capacity_1();
     // first move is placement new, because end() is uninitialized
     new (end()) value_type(std::move(*(end() - 1)));
     for (size_type i = 1; i < move_number; i++) {
       *(end() - i) = std::move(*(end() - i - 1));
     }
-    data_[idx] = value;
+    data_[idx] = std::move(copy);
     size_++;
   }
   return begin() + idx;
@@ -221,9 +223,24 @@ void vector<T>::erase(iterator pos) {
 
 template <typename T>
 void vector<T>::push_back(const_reference value) {
-  ensure_capacity_1();
-  new (end()) value_type(value);
-  size_++;
+  emplace_back(value);
+}
+
+template <typename T>
+void vector<T>::push_back(value_type&& value) {
+  emplace_back(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+typename vector<T>::reference vector<T>::emplace_back(Args&&... args) {
+  if (size_ == capacity_) {
+    grow_and_emplace_back(std::forward<Args>(args)...);
+  } else {
+    new (end()) value_type(std::forward<Args>(args)...);
+    size_++;
+  }
+  return data_[size_ - 1];
 }
 
 template <typename T>
@@ -258,6 +275,35 @@ void vector<T>::insert_many_back(Args&&... args) {
   }
 }
 
+// The new element is built in the new buffer before the old ones are moved
+// out, so args may refer into the vector
+template <typename T>
+template <typename... Args>
+void vector<T>::grow_and_emplace_back(Args&&... args) {
+  size_type new_cap = capacity_ == 0 ? 1 : 2 * capacity_;
+  if (new_cap > max_size()) {
+    throw std::out_of_range("new_cap is >= max_size()");
+  }
+  std::allocator<value_type> a;
+  value_type* new_data = a.allocate(new_cap);
+  try {
+    new (new_data + size_) value_type(std::forward<Args>(args)...);
+  } catch (...) {
+    a.deallocate(new_data, new_cap);
+    throw;
+  }
+  for (size_type i = 0; i < size_; i++) {
+    new (new_data + i) value_type(std::move(data_[i]));
+    data_[i].~value_type();
+  }
+  if (capacity_ > 0) {
+    a.deallocate(data_, capacity_);
+  }
+  data_ = new_data;
+  capacity_ = new_cap;
+  size_++;
+}
+
 template <typename T>
 void vector<T>::ensure_capacity_1() {
   if (size_ == capacity_) {